@@ -17,6 +17,7 @@
 #define IMAGE_DIFF_RANK_H
 
 #include <cstring>
+#include <cstdint>
 
 //====================================================================
 
@@ -36,13 +37,22 @@ class SimpleImageDifference
 		// Maximum value for @param threshold is 441.
 		virtual bool isSimilar(const char* sampleImageName, unsigned int threshold, unsigned int sensitivity=100)
 		{
-			return getDifference(sampleImageName, threshold)<sensitivity;
+			return getDifference(sampleImageName, threshold, sensitivity)<sensitivity;
 		}
 
 		virtual size_t getDifference(const char* sampleImageName, unsigned int range);
 
+		// As above, but the count stops once it reaches @param enough: a
+		// result of @param enough means at least that many pixels differ,
+		// the outcome of "difference<enough" is the same.
+		virtual size_t getDifference(const char* sampleImageName, unsigned int range, size_t enough);
+
 		virtual void loadBaseImage(const char* baseImageName, bool sharping, bool denoise);
 
+		// 64 bits FNV-1a hash of the decoded pixels, 0 if it cannot be read.
+		// Unlike a hash of the file it does not depend on the encoder metadata.
+		static uint64_t contentHash(const char* imageName);
+
 	private:
 		class CVMAT;
 		CVMAT* m_impl;
@@ -11,6 +11,7 @@
 * cv::Mat sharpImage(const char*)                                    *
 * cv::Mat sharpImage(const cv::Mat&)                                 *
 * class SimpleImageDifference::CVMAT                                 *
+* uint64_t SimpleImageDifference::contentHash(const char*)           *
 *         	                                                         *
 * Version: 1.0                                                       *
 * Date:    09-02-2025                                                *
@@ -21,6 +22,7 @@
 #include <opencv2/imgproc.hpp>
 #include <opencv2/highgui.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 
@@ -111,7 +113,7 @@ class SimpleImageDifference::CVMAT
 		void loadBaseImage(const char* baseImageName, bool sharping, bool denoise);
 		void loadBaseImage(const cv::Mat& baseImage, bool sharping, bool denoise);
 
-		size_t getDifference(const char* sampleImageName, unsigned int range);
+		size_t getDifference(const char* sampleImageName, unsigned int range, size_t enough);
 		size_t getDifference(const cv::Mat& sampleImage, unsigned int range);
 
 	private:
@@ -120,7 +122,8 @@ class SimpleImageDifference::CVMAT
 		bool m_sharp;
 		bool m_denoise;
 		
-		size_t processImage(const cv::Mat& sampleImage, unsigned int range);
+		// the count stops at @param limit
+		size_t processImage(const cv::Mat& sampleImage, unsigned int range, size_t limit=SIZE_MAX);
 		
 		struct
 		{
@@ -148,7 +151,7 @@ class SimpleImageDifference::CVMAT
 
 //--------------------------------------------------------------------
 
-size_t SimpleImageDifference::CVMAT::processImage(const cv::Mat& sampleImg, unsigned int range)
+size_t SimpleImageDifference::CVMAT::processImage(const cv::Mat& sampleImg, unsigned int range, size_t limit)
 {
 	cv::Mat diffImage;
 	cv::absdiff(m_img, sampleImg, diffImage);
@@ -170,7 +173,7 @@ size_t SimpleImageDifference::CVMAT::processImage(const cv::Mat& sampleImg, unsi
 	size_t diff=0;
 	const cv::Vec3b zeroVect(0,0,0);
 
-	for(int j=0; j<diffImage.rows; ++j){
+	for(int j=0; j<diffImage.rows && diff<limit; ++j){
 		for(int i=0; i<diffImage.cols; ++i){
 			cv::Vec3b pix = diffImage.at<cv::Vec3b>(j,i);
 
@@ -222,12 +225,13 @@ size_t SimpleImageDifference::CVMAT::getDifference(const cv::Mat& sampleImageMat
 
 //--------------------------------------------------------------------
 
-size_t SimpleImageDifference::CVMAT::getDifference(const char* sampleImagePath, unsigned int range)
+size_t SimpleImageDifference::CVMAT::getDifference(const char* sampleImagePath, unsigned int range, size_t enough)
 {
 	cv::Mat sampleImg;
 	PrepareImage(sampleImagePath, sampleImg, m_sharp, m_denoise);
-	
-	return processImage(sampleImg, range);
+
+	// the rows left do not change the outcome once enough pixels differ
+	return std::min(processImage(sampleImg, range, enough), enough);
 }
 
 //====================================================================
@@ -248,7 +252,38 @@ void SimpleImageDifference::loadBaseImage(const char* baseImageName, bool sharpi
 
 size_t SimpleImageDifference::getDifference(const char* sampleImageName, unsigned int range)
 {
-	return m_impl->getDifference(sampleImageName, range);
+	return m_impl->getDifference(sampleImageName, range, SIZE_MAX);
+}
+
+size_t SimpleImageDifference::getDifference(const char* sampleImageName, unsigned int range, size_t enough)
+{
+	return m_impl->getDifference(sampleImageName, range, enough);
+}
+
+uint64_t SimpleImageDifference::contentHash(const char* imageName)
+{
+	cv::Mat img=cv::imread(imageName, cv::IMREAD_UNCHANGED);
+	if(img.empty()){
+		return 0;
+	}
+
+	uint64_t hash=14695981039346656037ULL;
+	auto fnv1a=[&hash](const uchar* data, size_t size){
+		for(size_t i=0; i<size; ++i){
+			hash^=data[i];
+			hash*=1099511628211ULL;
+		}
+	};
+
+	const int header[3]={img.cols, img.rows, img.type()};
+	fnv1a(reinterpret_cast<const uchar*>(header), sizeof(header));
+
+	const size_t rowSize=img.cols*img.elemSize();
+	for(int j=0; j<img.rows; ++j){
+		fnv1a(img.ptr<uchar>(j), rowSize);
+	}
+
+	return hash;
 }
 
 //====================================================================
@@ -0,0 +1,216 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class BenchHarness                                                 *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "bench_harness.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+//====================================================================
+
+void BenchHarness::add(const std::string& name, Body body)
+{
+	m_benchmarks.emplace_back(name, body);
+}
+
+//--------------------------------------------------------------------
+
+void BenchHarness::setFilter(const std::string& filter)
+{
+	m_filter=filter;
+}
+
+//--------------------------------------------------------------------
+
+void BenchHarness::setMinTime(double seconds)
+{
+	if(seconds>0){
+		m_minTime=seconds;
+	}
+}
+
+//--------------------------------------------------------------------
+
+void BenchHarness::setRepetitions(int repetitions)
+{
+	if(repetitions>0){
+		m_repetitions=repetitions;
+	}
+}
+
+//--------------------------------------------------------------------
+
+void BenchHarness::list() const
+{
+	for(auto& benchmark : m_benchmarks){
+		std::printf("%s\n", benchmark.first.c_str());
+	}
+}
+
+//--------------------------------------------------------------------
+
+double BenchHarness::measure(Body& body, size_t iterations, BenchState& state)
+{
+	state=BenchState(iterations);
+	body(state);
+	auto end=std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(end-state.m_begin).count();
+}
+
+//--------------------------------------------------------------------
+
+BenchHarness::Result BenchHarness::runOne(const std::string& name, Body& body) const
+{
+	BenchState state(1);
+
+	// grow the iteration count until a run takes a tenth of the minimum time
+	size_t iterations=1;
+	double elapsed=measure(body, iterations, state);
+	while(elapsed<m_minTime/10 && iterations<(size_t(1)<<40)){
+		iterations*=elapsed>0 ? std::min<size_t>(10, std::max<size_t>(2, size_t(m_minTime/10/elapsed))) : 10;
+		elapsed=measure(body, iterations, state);
+	}
+	if(elapsed<m_minTime){
+		iterations=std::max<size_t>(1, size_t(iterations*m_minTime/std::max(elapsed, 1e-9)));
+	}
+
+	std::vector<double> samples;
+	for(int i=0; i<m_repetitions; i++){
+		samples.push_back(measure(body, iterations, state)*1e9/iterations);
+	}
+
+	std::sort(samples.begin(), samples.end());
+	double median=samples[samples.size()/2];
+
+	std::vector<double> deviations;
+	for(double sample : samples){
+		deviations.push_back(std::fabs(sample-median));
+	}
+	std::sort(deviations.begin(), deviations.end());
+
+	Result result;
+	result.m_name=name;
+	result.m_nsPerIteration=median;
+	result.m_minNs=samples.front();
+	result.m_deviation=median>0 ? 100.0*deviations[deviations.size()/2]/median : 0;
+	result.m_itemsPerSecond=median>0 ? state.m_items*1e9/median : 0;
+	result.m_bytesPerSecond=median>0 ? state.m_bytes*1e9/median : 0;
+	result.m_iterations=iterations;
+
+	return result;
+}
+
+//--------------------------------------------------------------------
+
+const std::vector<BenchHarness::Result>& BenchHarness::run()
+{
+	m_results.clear();
+
+	std::printf("%-44s %14s %14s %8s %14s\n", "benchmark", "time/iter", "min", "+/-", "throughput");
+	for(auto& benchmark : m_benchmarks){
+		if(m_filter.length()>0 && benchmark.first.find(m_filter)==std::string::npos){
+			continue;
+		}
+
+		Result result=runOne(benchmark.first, benchmark.second);
+		m_results.push_back(result);
+
+		char throughput[32]="";
+		if(result.m_bytesPerSecond>0){
+			std::snprintf(throughput, sizeof(throughput), "%.1f MB/s", result.m_bytesPerSecond/1e6);
+		}
+		else if(result.m_itemsPerSecond>0){
+			std::snprintf(throughput, sizeof(throughput), "%.2f M/s", result.m_itemsPerSecond/1e6);
+		}
+
+		std::printf("%-44s %11.1f ns %11.1f ns %7.1f%% %14s\n", result.m_name.c_str(),
+					result.m_nsPerIteration, result.m_minNs, result.m_deviation, throughput);
+		std::fflush(stdout);
+	}
+
+	return m_results;
+}
+
+//--------------------------------------------------------------------
+
+bool BenchHarness::saveJson(const char* filePath) const
+{
+	FILE* file=std::fopen(filePath, "w");
+	if(file==nullptr){
+		return false;
+	}
+
+	// one benchmark per line, compare() depends on it
+	std::fputs("{\"benchmarks\":[", file);
+	for(size_t i=0; i<m_results.size(); i++){
+		const Result& result=m_results[i];
+		std::fprintf(file, "%s\n{\"name\":\"%s\",\"ns_per_iteration\":%.3f,\"min_ns\":%.3f,\"deviation_pct\":%.2f,\"items_per_second\":%.1f,\"bytes_per_second\":%.1f,\"iterations\":%zu}",
+					i>0 ? "," : "", result.m_name.c_str(), result.m_nsPerIteration, result.m_minNs,
+					result.m_deviation, result.m_itemsPerSecond, result.m_bytesPerSecond, result.m_iterations);
+	}
+	std::fputs("\n]}\n", file);
+
+	return std::fclose(file)==0;
+}
+
+//--------------------------------------------------------------------
+
+bool BenchHarness::compare(const char* filePath, double tolerance) const
+{
+	std::ifstream baselineFile(filePath);
+	if(!baselineFile.is_open()){
+		std::printf("cannot read %s\n", filePath);
+		return false;
+	}
+
+	std::map<std::string, double> baseline;
+	std::string line;
+	const char* nameTag="{\"name\":\"";
+	const char* timeTag="\"ns_per_iteration\":";
+	while(std::getline(baselineFile, line)){
+		size_t namePos=line.find(nameTag);
+		size_t timePos=line.find(timeTag);
+		if(namePos==std::string::npos || timePos==std::string::npos){
+			continue;
+		}
+		namePos+=std::strlen(nameTag);
+		size_t nameEnd=line.find('"', namePos);
+		baseline[line.substr(namePos, nameEnd-namePos)]=std::atof(line.c_str()+timePos+std::strlen(timeTag));
+	}
+
+	bool ok=true;
+	std::printf("\n%-44s %14s %14s %9s\n", "benchmark", "baseline", "current", "change");
+	for(const Result& result : m_results){
+		auto it=baseline.find(result.m_name);
+		if(it==baseline.end() || it->second<=0){
+			std::printf("%-44s %14s %11.1f ns\n", result.m_name.c_str(), "-", result.m_nsPerIteration);
+			continue;
+		}
+
+		double change=100.0*(result.m_nsPerIteration-it->second)/it->second;
+		bool regression=change>tolerance;
+		ok=ok && !regression;
+		std::printf("%-44s %11.1f ns %11.1f ns %+8.1f%%%s\n", result.m_name.c_str(), it->second,
+					result.m_nsPerIteration, change, regression ? "  REGRESSION" : "");
+	}
+
+	return ok;
+}
+
+//====================================================================
@@ -0,0 +1,149 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class BenchState                                                   *
+* class BenchHarness                                                 *
+* template<typename T> void doNotOptimize(const T&)                  *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _BENCH_HARNESS_H
+#define _BENCH_HARNESS_H
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+//====================================================================
+
+// keep @param value (and what it points to) alive for the optimiser
+template<typename T>
+inline void doNotOptimize(const T& value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+//====================================================================
+
+/*
+ * Handed to a benchmark body: it must run the measured code
+ * iterations() times. Work done before start() (fixtures) is not
+ * measured.
+ * */
+class BenchState final
+{
+	public:
+		BenchState(size_t iterations)
+		: m_begin(std::chrono::steady_clock::now())
+		, m_iterations(iterations)
+		, m_items(0)
+		, m_bytes(0)
+		{}
+
+		size_t iterations() const
+		{
+			return m_iterations;
+		}
+
+		void start()
+		{
+			m_begin=std::chrono::steady_clock::now();
+		}
+
+		// work done by one iteration, for the throughput columns
+		void setItems(size_t items)
+		{
+			m_items=items;
+		}
+
+		void setBytes(size_t bytes)
+		{
+			m_bytes=bytes;
+		}
+
+	private:
+		std::chrono::steady_clock::time_point m_begin;
+		size_t m_iterations;
+		size_t m_items;
+		size_t m_bytes;
+
+		friend class BenchHarness;
+};
+
+//====================================================================
+
+/*
+ * Every benchmark is calibrated to run for at least the minimum time,
+ * then measured a number of times. The median time per iteration is
+ * reported (the spread as median absolute deviation), so results of
+ * two builds on the same machine can be compared with --compare.
+ * */
+class BenchHarness final
+{
+	public:
+		typedef std::function<void(BenchState&)> Body;
+
+		struct Result
+		{
+			std::string m_name;
+			double m_nsPerIteration;
+			double m_minNs;
+			double m_deviation; // % of the median
+			double m_itemsPerSecond;
+			double m_bytesPerSecond;
+			size_t m_iterations;
+		};
+
+		BenchHarness()
+		: m_minTime(0.2)
+		, m_repetitions(5)
+		{}
+
+		void add(const std::string& name, Body body);
+
+		// only benchmarks whose name contains @param filter run
+		void setFilter(const std::string& filter);
+		void setMinTime(double seconds);
+		void setRepetitions(int repetitions);
+
+		void list() const;
+
+		const std::vector<Result>& run();
+
+		bool saveJson(const char* filePath) const;
+
+		// Print the change against the results saved in @param filePath,
+		// it returns false if a benchmark is slower by more than
+		// @param tolerance percent (or the file cannot be read).
+		bool compare(const char* filePath, double tolerance) const;
+
+	private:
+		std::vector<std::pair<std::string, Body>> m_benchmarks;
+		std::vector<Result> m_results;
+		std::string m_filter;
+		double m_minTime;
+		int m_repetitions;
+
+		static double measure(Body& body, size_t iterations, BenchState& state);
+		Result runOne(const std::string& name, Body& body) const;
+};
+
+//====================================================================
+
+// each file of the suite adds its own benchmarks
+void addTextBenchmarks(BenchHarness& harness);
+void addKeyboardBenchmarks(BenchHarness& harness);
+void addImageBenchmarks(BenchHarness& harness);
+
+//====================================================================
+
+#endif
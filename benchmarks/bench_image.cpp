@@ -0,0 +1,122 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "bench_harness.h"
+#include "ImageDiff_Lib/simple_image_difference.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+//====================================================================
+
+/*
+ * Write (once) a synthetic screenshot of @param width x @param height
+ * as binary PPM: a gradient with a grid of "widgets". The sample has
+ * one of the widgets changed, as a control command would see it.
+ * It returns the path of the image.
+ * */
+static std::string benchImage(int width, int height, bool sample)
+{
+	std::error_code ec;
+	std::filesystem::path dir=std::filesystem::temp_directory_path(ec)/"kmrp_benchmarks";
+	std::filesystem::create_directories(dir, ec);
+
+	char name[64];
+	std::snprintf(name, sizeof(name), "%s_%ix%i.ppm", sample ? "sample" : "base", width, height);
+	std::string path=(dir/name).string();
+	if(std::filesystem::exists(path, ec)){
+		return path;
+	}
+
+	std::vector<unsigned char> pixels(size_t(width)*height*3);
+	for(int y=0; y<height; y++){
+		for(int x=0; x<width; x++){
+			unsigned char* pixel=&pixels[(size_t(y)*width+x)*3];
+			pixel[0]=(x*255)/width;
+			pixel[1]=(y*255)/height;
+			pixel[2]=128;
+			// 64x32 widgets with a 4 pixels border
+			if((x%80)<64 && (y%48)<32){
+				bool border=(x%80)<4 || (x%80)>59 || (y%48)<4 || (y%48)>27;
+				pixel[0]=pixel[1]=pixel[2]=border ? 40 : 230;
+				if(sample && x<80 && y<48 && !border){
+					pixel[0]=200;
+					pixel[1]=30;
+					pixel[2]=30;
+				}
+			}
+		}
+	}
+
+	FILE* file=std::fopen(path.c_str(), "wb");
+	if(file){
+		std::fprintf(file, "P6\n%i %i\n255\n", width, height);
+		std::fwrite(pixels.data(), 1, pixels.size(), file);
+		std::fclose(file);
+	}
+
+	return path;
+}
+
+//====================================================================
+
+void addImageBenchmarks(BenchHarness& harness)
+{
+	const int resolutions[][2]={{320, 240}, {1280, 720}, {1920, 1080}, {3840, 2160}};
+
+	for(auto& resolution : resolutions){
+		const int width=resolution[0];
+		const int height=resolution[1];
+		std::string size=std::to_string(width)+"x"+std::to_string(height);
+
+		harness.add("SimpleImageDifference/loadBaseImage/"+size, [width, height](BenchState& state){
+			std::string base=benchImage(width, height, false);
+			SimpleImageDifference imageDifference;
+			state.setBytes(size_t(width)*height*3);
+			state.start();
+			for(size_t i=0; i<state.iterations(); i++){
+				imageDifference.loadBaseImage(base.c_str());
+			}
+		});
+
+		harness.add("SimpleImageDifference/getDifference/"+size, [width, height](BenchState& state){
+			std::string base=benchImage(width, height, false);
+			std::string sample=benchImage(width, height, true);
+			SimpleImageDifference imageDifference;
+			imageDifference.loadBaseImage(base.c_str());
+			state.setBytes(size_t(width)*height*3);
+			state.start();
+			for(size_t i=0; i<state.iterations(); i++){
+				size_t difference=imageDifference.getDifference(sample.c_str(), 240);
+				doNotOptimize(difference);
+			}
+		});
+
+		// as a control command polls, the count stops at the sensitivity
+		harness.add("SimpleImageDifference/getDifferenceLimited/"+size, [width, height](BenchState& state){
+			std::string base=benchImage(width, height, false);
+			std::string sample=benchImage(width, height, true);
+			SimpleImageDifference imageDifference;
+			imageDifference.loadBaseImage(base.c_str());
+			state.setBytes(size_t(width)*height*3);
+			state.start();
+			for(size_t i=0; i<state.iterations(); i++){
+				size_t difference=imageDifference.getDifference(sample.c_str(), 240, 100);
+				doNotOptimize(difference);
+			}
+		});
+	}
+}
+
+//====================================================================
@@ -0,0 +1,97 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class BenchKeyboard                                                *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "bench_harness.h"
+#include "keyboard_emulator.h"
+#include "key_map.h"
+
+#include <cstdio>
+#include <memory>
+
+//====================================================================
+
+/*
+ * DummyKeyboard has no character table, this one loads the uinput
+ * table so inputText goes through the same lookups as on a device.
+ * */
+class BenchKeyboard : public DummyKeyboard
+{
+	public:
+		BenchKeyboard()
+		{
+			m_shortcutParserKeyMapPtr=&shortcutParserKeyMap;
+			clearError();
+			loadPrintableCharacters();
+		}
+
+		virtual bool isActive() override
+		{
+			return true;
+		}
+
+		virtual void loadPrintableCharacters() override
+		{
+			KeyboardEmulatorI::loadPrintableCharacters("printable_characters.txt", uinputKeyMap);
+		}
+};
+
+//====================================================================
+
+void addKeyboardBenchmarks(BenchHarness& harness)
+{
+	auto keyboard=std::make_shared<BenchKeyboard>();
+	if(keyboard->getLastError()[0]!='\0'){
+		std::fprintf(stderr, "inputText/DummyKeyboard: %s\n", keyboard->getLastError());
+	}
+
+	harness.add("inputText/DummyKeyboard", [keyboard](BenchState& state){
+		const char* text="The quick brown fox jumps over the lazy dog, 0123456789!";
+		state.setItems(std::strlen(text));
+		for(size_t i=0; i<state.iterations(); i++){
+			keyboard->inputText(text);
+		}
+	});
+
+	harness.add("ComboStringParser/parse", [](BenchState& state){
+		state.setItems(1);
+		for(size_t i=0; i<state.iterations(); i++){
+			ComboStringParser combo("ctrl+shift+alt+t");
+			doNotOptimize(combo);
+		}
+	});
+
+	harness.add("ComboStringParser/toKeycode", [](BenchState& state){
+		ComboStringParser combo("ctrl+shift+alt+t");
+		int keyCodes[MAX_HID_CODES];
+		state.setItems(1);
+		state.start();
+		for(size_t i=0; i<state.iterations(); i++){
+			combo.toKeycode(&shortcutParserKeyMap, keyCodes);
+			doNotOptimize(keyCodes);
+		}
+	});
+
+	harness.add("KeyConversion/getKeyCode", [](BenchState& state){
+		state.setItems(int(SPKEYS::_LAST));
+		for(size_t i=0; i<state.iterations(); i++){
+			for(int key=0; key<int(SPKEYS::_LAST); key++){
+				uint code=KeyConversion::getKeyCode<UinputKeyboard>(SPKEYS(key));
+				doNotOptimize(code);
+			}
+		}
+	});
+}
+
+//====================================================================
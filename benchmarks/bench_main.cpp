@@ -0,0 +1,87 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "bench_harness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//====================================================================
+
+static void usage(const char* program)
+{
+	std::printf("usage: %s [--list] [--filter text] [--min-time seconds] [--repetitions n]\n"
+				"          [--json file] [--compare baseline.json] [--tolerance percent]\n", program);
+}
+
+//====================================================================
+
+int main(int argc, char** argv)
+{
+	BenchHarness harness;
+	const char* jsonFile=nullptr;
+	const char* baselineFile=nullptr;
+	double tolerance=10;
+	bool listOnly=false;
+
+	for(int i=1; i<argc; i++){
+		if(std::strcmp(argv[i], "--list")==0){
+			listOnly=true;
+		}
+		else if(std::strcmp(argv[i], "--filter")==0 && i+1<argc){
+			harness.setFilter(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--min-time")==0 && i+1<argc){
+			harness.setMinTime(std::atof(argv[++i]));
+		}
+		else if(std::strcmp(argv[i], "--repetitions")==0 && i+1<argc){
+			harness.setRepetitions(std::atoi(argv[++i]));
+		}
+		else if(std::strcmp(argv[i], "--json")==0 && i+1<argc){
+			jsonFile=argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--compare")==0 && i+1<argc){
+			baselineFile=argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--tolerance")==0 && i+1<argc){
+			tolerance=std::atof(argv[++i]);
+		}
+		else{
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	addTextBenchmarks(harness);
+	addKeyboardBenchmarks(harness);
+	addImageBenchmarks(harness);
+
+	if(listOnly){
+		harness.list();
+		return 0;
+	}
+
+	harness.run();
+
+	if(jsonFile && !harness.saveJson(jsonFile)){
+		std::printf("cannot write %s\n", jsonFile);
+		return 1;
+	}
+
+	if(baselineFile && !harness.compare(baselineFile, tolerance)){
+		return 2;
+	}
+
+	return 0;
+}
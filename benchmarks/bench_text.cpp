@@ -0,0 +1,155 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "bench_harness.h"
+#include "command_parser.h"
+#include "cstr_split.h"
+#include "field_split.h"
+#include "script_loader.h"
+#include "utilities.h"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+//====================================================================
+
+// script lines as the commands write them
+static std::vector<std::pair<std::string, std::string>> scriptLines()
+{
+	std::vector<std::pair<std::string, std::string>> lines;
+	std::vector<std::pair<std::string, std::unique_ptr<BaseCommand>>> commands;
+
+	commands.emplace_back("text", std::make_unique<TextCommand>("type the user name", 200, "a rather long line of text to type"));
+	commands.emplace_back("shortcut", std::make_unique<ShortcutCommand>("save", 200, "ctrl+shift+s"));
+	commands.emplace_back("mouse_move", std::make_unique<MoveMouseCommand>("move to the menu", 100, 640, 480, "root", 250));
+	commands.emplace_back("mouse_drag", std::make_unique<MouseDragCommand>("drag the file", 100, 10, 20, 800, 600, "Files", 400));
+	commands.emplace_back("mouse_scroll", std::make_unique<MouseScrollCommand>("scroll the list", 100, 300, 300, "root", -5, 0));
+
+	for(auto& command : commands){
+		std::ostringstream line;
+		command.second->print(line);
+		std::string str=line.str();
+		str.pop_back(); // the new line
+		lines.emplace_back(command.first, str);
+	}
+
+	return lines;
+}
+
+//====================================================================
+
+void addTextBenchmarks(BenchHarness& harness)
+{
+	harness.add("CstrSplit/rgb", [](BenchState& state){
+		const char* colour="120,200,33";
+		state.setBytes(std::strlen(colour));
+		for(size_t i=0; i<state.iterations(); i++){
+			CstrSplit<3> parts(colour, ",");
+			doNotOptimize(parts[2]);
+		}
+	});
+
+	harness.add("FieldSplit/rgb", [](BenchState& state){
+		const char* colour="120,200,33";
+		state.setBytes(std::strlen(colour));
+		for(size_t i=0; i<state.iterations(); i++){
+			FieldSplit<3> parts(colour, ",");
+			doNotOptimize(parts.number<int>(2));
+		}
+	});
+
+	for(auto& line : scriptLines()){
+		harness.add("CstrSplit/"+line.first, [line](BenchState& state){
+			state.setBytes(line.second.length());
+			for(size_t i=0; i<state.iterations(); i++){
+				CstrSplit<20> parts(line.second.c_str(), SEPARATOR);
+				doNotOptimize(parts[parts.dataSize()-1]);
+			}
+		});
+
+		harness.add("FieldSplit/"+line.first, [line](BenchState& state){
+			state.setBytes(line.second.length());
+			for(size_t i=0; i<state.iterations(); i++){
+				FieldSplit<20> parts(line.second, SEPARATOR);
+				doNotOptimize(parts[parts.dataSize()-1]);
+			}
+		});
+
+		harness.add("ParserBuilder/"+line.first, [line](BenchState& state){
+			state.setItems(1);
+			for(size_t i=0; i<state.iterations(); i++){
+				BaseCommand* command=ParserBuilder(line.second);
+				doNotOptimize(command);
+				delete command;
+			}
+		});
+	}
+
+	harness.add("CommandPool/mouse_move", [](BenchState& state){
+		state.setItems(1);
+		for(size_t i=0; i<state.iterations(); i++){
+			BaseCommand* command=MoveMouseCommand::Builder("move to the menu", 100, 640, 480, "Files", 250);
+			doNotOptimize(command);
+			delete command;
+		}
+	});
+
+	harness.add("ScriptLoader/100k_lines", [](BenchState& state){
+		std::error_code ec;
+		std::filesystem::path dir=std::filesystem::temp_directory_path(ec)/"kmrp_benchmarks";
+		std::filesystem::create_directories(dir, ec);
+		std::string path=(dir/"script_100k.txt").string();
+
+		const size_t totalLines=100000;
+		{
+			auto lines=scriptLines();
+			std::ofstream script(path, std::ofstream::out | std::ofstream::trunc);
+			for(size_t i=0; i<totalLines; i++){
+				script<<lines[i%lines.size()].second<<"\n";
+			}
+		}
+
+		state.setItems(totalLines);
+		state.start();
+		for(size_t i=0; i<state.iterations(); i++){
+			ScriptLoader loader;
+			loader.load(path.c_str());
+			doNotOptimize(loader.size());
+		}
+	});
+
+	harness.add("ToString2/mouse_move", [](BenchState& state){
+		std::string description="move to the menu";
+		std::string windowName="root";
+		std::string motion="2,300";
+		state.setItems(1);
+		for(size_t i=0; i<state.iterations(); i++){
+			std::string line=ToString2(static_cast<int>(CommandTypes::MouseMove), description, true, 640, 480, windowName, 250, motion, 100);
+			doNotOptimize(line);
+		}
+	});
+
+	harness.add("ToString2/text", [](BenchState& state){
+		std::string description="type the user name";
+		std::string text="a rather long line of text to type";
+		state.setItems(1);
+		for(size_t i=0; i<state.iterations(); i++){
+			std::string line=ToString2(static_cast<int>(CommandTypes::KeyboardText), description, true, text, 200);
+			doNotOptimize(line);
+		}
+	});
+}
+
+//====================================================================
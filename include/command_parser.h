@@ -9,7 +9,7 @@
 *         	                                                         *
 * template<CommandTypes CT> struct CmdType2Bdr                       *
 * template<CommandTypes CMDT> struct CmdBuilder                      *
-* BaseCommand* ParserBuilder(const std::string& line);               *
+* BaseCommand* ParserBuilder(std::string_view, std::string*, bool);  *
 *         	                                                         *
 * Version: 1.0                                                       *
 * Date:    09-02-2025                                                *
@@ -101,6 +101,18 @@ struct CmdType2Bdr<CommandTypes::MouseDrag>
 	typedef MouseDragCommand Cmd;
 };
 
+template<>
+struct CmdType2Bdr<CommandTypes::RawEvents>
+{
+	typedef RawEventsCommand Cmd;
+};
+
+template<>
+struct CmdType2Bdr<CommandTypes::MouseScroll>
+{
+	typedef MouseScrollCommand Cmd;
+};
+
 //====================================================================
 
 template<CommandTypes CMDT>
@@ -117,7 +129,10 @@ struct CmdBuilder
 };
 
 
-BaseCommand* ParserBuilder(const std::string& line);
+// It returns nullptr if @param line is not a command, @param error
+// gets the reason when a field is missing or malformed. With @param checkImage
+// false control commands do not look for their base image (see CtrlCommand).
+BaseCommand* ParserBuilder(std::string_view line, std::string* error=nullptr, bool checkImage=true);
 
 //====================================================================
 
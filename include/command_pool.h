@@ -0,0 +1,84 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class CommandPool                                                  *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _COMMAND_POOL_H
+#define _COMMAND_POOL_H
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+//====================================================================
+
+/*
+ * Commands are small, many and all of a dozen sizes, a script of
+ * 100k lines makes as many heap allocations with their own headers.
+ * The pool hands them out of slabs instead, one free list per size
+ * rounded up to ALIGNMENT. The slabs are never given back: a script
+ * loaded after another one reuses the blocks the first one freed.
+ * Commands are built on several threads (ScriptLoader).
+ * */
+class CommandPool final
+{
+	public:
+		enum
+		{
+			ALIGNMENT=16,
+			MAX_SIZE=1024,// larger objects go to the heap
+			SLAB_SIZE=64*1024,
+		};
+
+	public:
+		static CommandPool& getCommandPool()
+		{
+			static CommandPool pool;
+			return pool;
+		}
+
+		void* allocate(size_t size);
+
+		// @param size the same size given to allocate
+		void deallocate(void* ptr, size_t size);
+
+		// blocks handed out and not given back yet
+		size_t inUse() const;
+
+		// bytes held by the slabs
+		size_t reserved() const;
+
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* m_next;
+		};
+
+		mutable std::mutex m_mutex;
+		FreeBlock* m_freeLists[MAX_SIZE/ALIGNMENT];
+		std::vector<char*> m_slabs;
+		char* m_slabTop;
+		char* m_slabEnd;
+		size_t m_inUse;
+
+		CommandPool();
+
+		~CommandPool()=default;
+
+		CommandPool(const CommandPool&)=delete;
+		CommandPool& operator=(const CommandPool&)=delete;
+};
+
+//====================================================================
+
+#endif
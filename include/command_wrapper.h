@@ -69,6 +69,9 @@ class BasePanel : public wxPanel
 
 		virtual void enableStatus()
 		{}
+
+		// let the command list know the panel was edited
+		void notifyChange();
 };
 
 //====================================================================
@@ -53,6 +53,7 @@ namespace WX
 		DEMO,
 		DELETE_FILE,
 		PROGRESS_TIMER,
+		CAPTURE_TIMER,
 		_LAST,
 	};
 
@@ -111,12 +112,16 @@ namespace WX
 			MOVE_HERE,
 			DO_LEFT_CLICK,
 			DO_RIGHT_CLICK,
+			SCROLL_UP_HERE,
+			SCROLL_DOWN_HERE,
 			SCREENSHOT_CMD,
 			START_ROI,
 			START_DRAGGING,
 			DRAG_HERE,
 			CANCEL_NEW_ROI,
 			DISPLAY_KBOARD,
+			CAPTURE_INPUT,
+			CAPTURE_RAW_INPUT,
 			CLOSE_MENU,
 			SUBMENU_REPEAT_ALL,
 			SUBMENU_REPEAT_LAST,
@@ -148,6 +153,15 @@ enum class InterfaceLink
 	_LAST,
 };
 
+// on disk format of the screenshots
+enum class ImageFormat
+{
+	PNG,
+	PPM, // uncompressed, fastest to write and read back
+	BMP,
+	_LAST,
+};
+
 enum HID_TARGET
 {
 	NONE,
@@ -0,0 +1,121 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* struct RawInputEvent                                               *
+* class EvdevRecorder                                                *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _EVDEV_RECORDER_H
+#define _EVDEV_RECORDER_H
+
+#include "spsc_ring_buffer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+//====================================================================
+
+struct RawInputEvent
+{
+	int64_t m_time; // CLOCK_MONOTONIC, microseconds
+	uint16_t m_type;
+	uint16_t m_code;
+	int32_t m_value;
+};
+
+//====================================================================
+
+/*
+ * Read the real keyboards and pointers under /dev/input on a background
+ * thread. Events go into a lock free ring buffer which the GUI thread
+ * drains. When the ring is full the reader stops reading instead of
+ * discarding, the kernel queue of each device keeps the events meanwhile.
+ * Our own uinput devices are not recorded.
+ * Pressing PAUSE requests the end of the recording, that key is not
+ * recorded.
+ * */
+class EvdevRecorder
+{
+	public:
+		enum{
+			BUFFER_SIZE=1<<16,
+		};
+
+		EvdevRecorder();
+		~EvdevRecorder();
+
+		bool start();
+		void stop();
+
+		bool isRunning() const;
+
+		// the user pressed the stop key
+		bool stopRequested() const;
+
+		// number of devices being read
+		size_t deviceCount() const;
+
+		// SYN_DROPPED frames reported by the kernel, it should stay 0
+		uint64_t kernelDrops() const;
+
+		// append to @param events what has been read so far, it returns
+		// the number of events appended
+		size_t drain(std::vector<RawInputEvent>& events);
+
+	private:
+		SpscRingBuffer<RawInputEvent, BUFFER_SIZE> m_buffer;
+		std::vector<int> m_fds;
+		std::thread m_thread;
+		std::atomic<uint64_t> m_kernelDrops;
+		std::atomic<bool> m_running;
+		std::atomic<bool> m_stopRequested;
+		int m_wakePipe[2];
+
+		bool openDevices();
+		void closeDevices();
+		void run();
+		bool readDevice(int fd);
+};
+
+//--------------------------------------------------------------------
+
+inline bool EvdevRecorder::isRunning() const
+{
+	return m_running.load(std::memory_order_acquire);
+}
+
+//--------------------------------------------------------------------
+
+inline bool EvdevRecorder::stopRequested() const
+{
+	return m_stopRequested.load(std::memory_order_acquire);
+}
+
+//--------------------------------------------------------------------
+
+inline size_t EvdevRecorder::deviceCount() const
+{
+	return m_fds.size();
+}
+
+//--------------------------------------------------------------------
+
+inline uint64_t EvdevRecorder::kernelDrops() const
+{
+	return m_kernelDrops.load(std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------------
+
+#endif
@@ -43,6 +43,8 @@ enum EvtID
 	REMOVE_FILE_FROM_DROPDOWN,
 	CONNECTION_OK,
 	CONNECTION_FAILED,
+	SCRIPT_LOADED,
+	PANEL_CHANGED,
 };
 
 inline void postEvent(wxEvtHandler* h, wxEventType commandEventType, int id)
@@ -17,10 +17,13 @@
 #define EXT_SCROLLED_WINDOW_H
 
 #include "command_wrapper.h"
+#include "script_loader.h"
+#include "script_journal.h"
 
 #include <wx/wx.h>
 #include <wx/scrolwin.h>
 #include <list>
+#include <set>
 
 class BasePanel;
 class BaseCommand;
@@ -72,6 +75,9 @@ class ExtScrolledWindow : public wxScrolledWindow
 		bool getCommand(BaseCommand*& cmdPtr, const ExtScrolledWindow::PlayMode mode);
 		void advance2End(size_t idx);
 
+		// the commands a run goes through, once each and in order
+		std::vector<BaseCommand*> getActiveCommands() const;
+
 		size_t size() const;
 		unsigned int getCommandCount() const;
 
@@ -79,32 +85,65 @@ class ExtScrolledWindow : public wxScrolledWindow
 		bool swapUp();
 		bool swapDown();
 
+		// The script loaded or saved last is saved by appending the edits
+		// to its journal, any other file is written in full.
 		bool saveData(const char* fileName);
+
+		// The file is parsed before returning, the panels are added in
+		// chunks from the event loop and EvtID::SCRIPT_LOADED is posted
+		// after the last one.
 		bool loadDataFile(const char* fileName);
 
+		// where loadDataFile stopped, empty if it did not fail on a line
+		const std::string& getLoadError() const;
+
 		void lastCommandFailed();
 
+		// pass through the enclosing loop of the last command returned
+		// by getCommand, 0 outside loops
+		uint getLoopIteration() const;
+
 		void updateView(const BaseCommand* cmd);
 
 	private:
 		std::list<BasePanel*> m_cmdViewList;
 		typename std::list<BasePanel*>::iterator m_dataIt;
+		std::vector<ScriptEntry> m_pendingEntries;
+		size_t m_pendingIdx;
+		ScriptJournal m_journal;
+		// edited since the last save, saved as they are then
+		std::set<BasePanel*> m_modifiedPanels;
+		// journal of the script being loaded, attached once its panels are in
+		std::string m_loadedScript;
+		uint64_t m_loadedHash;
+		size_t m_loadedLogBytes;
+		size_t m_loadedLines;
 
 		BaseCommand* m_currentRunningCmd;
 		BasePanel* m_previousPanel;
+		std::string m_loadError;
 		const int m_width;
 		int m_height;
 		int m_loopStartAt;
 		int m_commandCount;
+		uint m_loopIteration;
 		bool m_init;
+		bool m_loading;
+		bool m_pendingIndentation;
+		bool m_deferScroll;
 
 		bool getCmd(BaseCommand*& cmdPtr);
 		bool getCommand(BaseCommand*& cmdPtr);
 		bool swap(bool downSwap);
 		void addCommandPanel(BasePanel* cmd);
 		void updateScroll(int height);
+		void addPendingPanels();
+		void dropPendingEntries();
+		void journalAdd(BasePanel* panelPtr);
+		void journalRemove(BasePanel* panelPtr, size_t index);
 
 		void DeleteCmd(wxCommandEvent& event);
+		void OnPanelChanged(wxCommandEvent& event);
 
 		DECLARE_EVENT_TABLE()
 };
@@ -118,6 +157,20 @@ inline unsigned int ExtScrolledWindow::getCommandCount() const
 
 //----------------------------------------------------------------------
 
+inline uint ExtScrolledWindow::getLoopIteration() const
+{
+	return m_loopIteration;
+}
+
+//----------------------------------------------------------------------
+
+inline const std::string& ExtScrolledWindow::getLoadError() const
+{
+	return m_loadError;
+}
+
+//----------------------------------------------------------------------
+
 inline bool ExtScrolledWindow::swapUp()
 {
 	return swap(false);
@@ -155,7 +208,14 @@ inline void ExtScrolledWindow::advance2End(size_t idx)
 
 inline void ExtScrolledWindow::addCommandPanel(BasePanel* panelPtr)
 {
-	updateScroll(panelPtr->getHeight());
+	if(m_deferScroll){
+		// the scroll bars are set once per chunk
+		m_height+=panelPtr->getHeight();
+	}
+	else{
+		updateScroll(panelPtr->getHeight());
+	}
+	journalAdd(panelPtr);
 	m_cmdViewList.push_back(panelPtr);
 }
 
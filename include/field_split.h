@@ -0,0 +1,182 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* template<int N> class FieldSplit                                   *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _FIELD_SPLIT_H
+#define _FIELD_SPLIT_H
+
+#include <charconv>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+//====================================================================
+
+/*
+ * Split a line into at most N fields without copying it: the fields
+ * are views into the source, which must outlive the object. Unlike
+ * CstrSplit nothing throws; reading a missing field or a field that
+ * is not a number yields an empty view or 0 and the first of those
+ * errors is kept, so the caller can check ok() once after reading
+ * every field it needs.
+ * */
+template<int N>
+class FieldSplit
+{
+	public:
+		enum Error
+		{
+			NONE,
+			MISSING_FIELD,
+			NOT_A_NUMBER,
+		};
+
+		FieldSplit(std::string_view data, std::string_view separator);
+
+		int dataSize() const
+		{
+			return m_size;
+		}
+
+		bool has(int i) const
+		{
+			return i>-1 && i<m_size;
+		}
+
+		std::string_view operator[](int i) const;
+
+		std::string str(int i) const
+		{
+			return std::string((*this)[i]);
+		}
+
+		// the whole field must be a number (std::from_chars)
+		template<typename T>
+		T number(int i) const;
+
+		bool toBool(int i) const
+		{
+			return (*this)[i]=="true";
+		}
+
+		bool ok() const
+		{
+			return m_error==NONE;
+		}
+
+		Error error() const
+		{
+			return m_error;
+		}
+
+		int errorField() const
+		{
+			return m_errorField;
+		}
+
+		// for instance "field 4: not a number"
+		std::string errorMessage() const;
+
+	private:
+		std::string_view m_fields[N];
+		int m_size;
+		mutable int m_errorField;
+		mutable Error m_error;
+
+		void setError(int i, Error error) const;
+};
+
+//--------------------------------------------------------------------
+
+template<int N>
+FieldSplit<N>::FieldSplit(std::string_view data, std::string_view separator)
+: m_size(0)
+, m_errorField(-1)
+, m_error(NONE)
+{
+	size_t begin=0;
+	while(m_size<N-1){
+		size_t end=data.find(separator, begin);
+		if(end==std::string_view::npos){
+			break;
+		}
+		m_fields[m_size++]=data.substr(begin, end-begin);
+		begin=end+separator.length();
+	}
+	// the last field keeps the rest of the line
+	m_fields[m_size++]=data.substr(begin);
+}
+
+//--------------------------------------------------------------------
+
+template<int N>
+void FieldSplit<N>::setError(int i, Error error) const
+{
+	if(m_error==NONE){
+		m_error=error;
+		m_errorField=i;
+	}
+}
+
+//--------------------------------------------------------------------
+
+template<int N>
+std::string_view FieldSplit<N>::operator[](int i) const
+{
+	if(!has(i)){
+		setError(i, MISSING_FIELD);
+		return std::string_view();
+	}
+	return m_fields[i];
+}
+
+//--------------------------------------------------------------------
+
+template<int N>
+template<typename T>
+T FieldSplit<N>::number(int i) const
+{
+	std::string_view field=(*this)[i];
+	T value=0;
+	if(!has(i)){
+		return value;
+	}
+
+	auto result=std::from_chars(field.data(), field.data()+field.length(), value);
+	if(result.ec!=std::errc() || result.ptr!=field.data()+field.length()){
+		setError(i, NOT_A_NUMBER);
+		return 0;
+	}
+
+	return value;
+}
+
+//--------------------------------------------------------------------
+
+template<int N>
+std::string FieldSplit<N>::errorMessage() const
+{
+	const char* messages[]={"", "missing", "not a number"};
+	if(m_error==NONE){
+		return "";
+	}
+
+	char message[48];
+	std::snprintf(message, sizeof(message), "field %i: %s", m_errorField, messages[m_error]);
+	return message;
+}
+
+//====================================================================
+
+#endif
@@ -17,6 +17,8 @@
 #define _HID_MANAGER_H
 
 #include "enumerations.h"
+#include "raw_events.h"
+#include "pointer_response.h"
 
 #include <functional>
 
@@ -32,9 +34,38 @@ class HIDManager
 		static bool currentEmulator(HID_TARGET target);
 		static bool checkConnection();
 
+		// only the uinput keyboard has a fast typing mode
+		static void SetTypingMode(bool fast, uint keysPerSecond);
+		static bool TypingSelfTest(uint keys, uint& received);
+
+		// see MouseEmulatorI::setOpenLoop
+		static void SetOpenLoopMouse(bool openLoop);
+		static void ResetPointerModel();
+
+		static void SetPointerResponse(const PointerResponse& response);
+
+		/*
+		 * Measure the response of the uinput mouse on the current display,
+		 * @param getMousePosition reads the actual pointer position. The
+		 * response is used right away.
+		 * */
+		static bool CalibratePointer(std::function<void(int&, int&)> getMousePosition, PointerResponse& response);
+
+		/*
+		 * Replay @param events on the uinput devices keeping the recorded
+		 * timing. Everything due is written in one go, keys and buttons
+		 * still down at the end are released. It returns false if the
+		 * current interface is not uinput or a write failed.
+		 * */
+		static bool PlayRawEvents(const std::vector<RawEvent>& events);
+
 	private:
 		static HID_TARGET s_currentTarget;
 		static bool s_isSerial;
+		static bool s_fastTyping;
+		static uint s_typingRate;
+		static bool s_openLoopMouse;
+		static PointerResponse s_pointerResponse;
 
 		static void SetDummyEmulator();
 		static void SetUinputEmulator();
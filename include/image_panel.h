@@ -67,12 +67,6 @@ inline void wxBackgroundBitmap::loadImage(wxBitmap* bitmap)
 	m_bitmap=bitmap;
 }
 
-//--------------------------------------------------------------------
-
-inline void wxBackgroundBitmap::loadImage(const char* imagePath, wxBitmapType bitmapType)
-{
-	m_bitmap->LoadFile(imagePath, bitmapType);
-}
 
 //--------------------------------------------------------------------
 
@@ -0,0 +1,73 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class ImageStore                                                   *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _IMAGE_STORE_H
+#define _IMAGE_STORE_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// name used for captures before they are moved into the store
+#define CAPTURE_IMAGE "capture.png"
+
+//====================================================================
+
+/*
+ * Control images are stored once under a name derived from their
+ * pixels, so identical captures share a single file (and a single
+ * entry in the decoded image cache). Live commands hold references
+ * on the images they use; images that neither a live command nor a
+ * saved script reference are removed by collectGarbage.
+ * The references can be taken from any thread, scripts are parsed
+ * on several threads (ScriptLoader).
+ * */
+class ImageStore final
+{
+	public:
+		static ImageStore& getImageStore()
+		{
+			static ImageStore store;
+			return store;
+		}
+
+		// Move @param imageName (already in the image directory) into the
+		// store. It returns the name of the stored image or an empty string
+		// if the image cannot be read.
+		std::string store(const char* imageName);
+
+		void acquire(const std::string& imageName);
+
+		void release(const std::string& imageName);
+
+		uint references(const std::string& imageName) const;
+
+		// Remove the images that are not referenced, @param scriptFiles are
+		// the saved scripts. It returns the number of images removed.
+		size_t collectGarbage(const std::vector<std::string>& scriptFiles);
+
+	private:
+		std::map<std::string, uint> m_references;
+		mutable std::mutex m_mutex;
+
+		ImageStore()=default;
+		ImageStore(const ImageStore&)=delete;
+		ImageStore& operator=(const ImageStore&)=delete;
+};
+
+//====================================================================
+
+#endif
@@ -0,0 +1,108 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class InputCoalescer                                               *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _INPUT_COALESCER_H
+#define _INPUT_COALESCER_H
+
+#include "evdev_recorder.h"
+#include "input_command.h"
+#include "trajectory.h"
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+//====================================================================
+
+/*
+ * Turn raw evdev events into the high level commands a user would have
+ * added by hand: typed text into TextCommand, chords and special keys
+ * into ShortcutCommand/KeyCommad, clicks, drags and pointer moves into
+ * the mouse commands (screen coordinates, "root" window), consecutive
+ * wheel ticks into one MouseScrollCommand. The wait of
+ * each command is the time the user took to start the next action.
+ * Pointer paths are reduced to a few waypoints which are replayed at
+ * the recorded speed.
+ * Relative pointer motion says nothing about where the pointer is, so
+ * the owner reports the pointer position each time it drains a batch.
+ * */
+class InputCoalescer
+{
+	public:
+		// @param lastWait is the wait given to the last command
+		InputCoalescer(uint lastWait);
+		~InputCoalescer();
+
+		// @param x, @param y pointer position right after @param events
+		// were read
+		void process(const std::vector<RawInputEvent>& events, int x, int y);
+
+		// ownership of the commands goes to the caller
+		std::vector<BaseCommand*> takeCommands();
+
+		void reset();
+
+	private:
+		typedef std::function<BaseCommand*(uint)> CommandBuilder;
+
+		struct PendingCommand
+		{
+			CommandBuilder m_builder;
+			int64_t m_end;
+		};
+
+		enum Modifiers{
+			SHIFT=1,
+			CTRL=2,
+			ALT=4,
+			ALTGR=8,
+			META=16,
+		};
+
+		std::map<int, char> m_characters; // keycode | modifiers<<16
+		std::map<int, std::string> m_keyNames;
+		std::vector<BaseCommand*> m_commands;
+		std::vector<PointerSample> m_segment; // pointer path since the last action
+		std::vector<int> m_heldModifiers;
+		std::string m_text;
+		PendingCommand m_pending;
+		PointerSample m_pointer;
+		PointerSample m_leftPress;
+		PointerSample m_scrollAt;
+		int64_t m_scrollEnd;
+		int m_scrollV;
+		int m_scrollH;
+		int64_t m_textStart;
+		int64_t m_textEnd;
+		uint m_lastWait;
+		bool m_leftDown;
+
+		void add(CommandBuilder builder, int64_t start, int64_t end);
+		void flushText();
+		void flushMove();
+		void flushScroll();
+		void onWheel(const RawInputEvent& event, const PointerSample& pointer);
+		void closeSegment(const PointerSample& pointer);
+		void onKey(const RawInputEvent& event);
+		void onButton(const RawInputEvent& event, const PointerSample& pointer);
+		int modifiers() const;
+
+		static int modifierBit(int keyCode);
+};
+
+//--------------------------------------------------------------------
+
+#endif
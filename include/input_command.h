@@ -10,6 +10,7 @@
 * class ExitCode                                                     *
 * struct MouseCmdExitPosition                                        *
 * class WindowOffset                                                 *
+* class MouseMotion                                                  *
 * class BaseCommand                                                  *
 * class InputCommand                                                 *
 * class TextCommand                                                  *
@@ -22,6 +23,8 @@
 * class MouseRightBtnCommand                                         *
 * class MouseSelectCommand                                           *
 * class MouseSelectCommand2                                          *
+* class MouseScrollCommand                                           *
+* class RawEventsCommand                                             *
 * class CtrlCommand                                                  *
 *         	                                                         *
 * Version: 1.0                                                       *
@@ -31,11 +34,16 @@
 #ifndef INPUT_COMMAND_H
 #define INPUT_COMMAND_H
 
+#include "command_pool.h"
+#include "window_registry.h"
 #include "keyboard_emulator.h"
 #include "mouse_emulator.h"
+#include "motion_profile.h"
+#include "raw_events.h"
 
 #include "utilities.h"
 #include "debug_utils.h"
+#include "trace.h"
 
 #include <iostream>
 #include <fstream>
@@ -68,6 +76,8 @@ enum class CommandTypes
 	Unicode,
 	Shortcut,
 	MouseDrag,
+	RawEvents,
+	MouseScroll,
 };
 
 enum class CommandInputTypes
@@ -127,10 +137,12 @@ class WindowOffset
 {
 	public:
 		WindowOffset()
+		:WindowOffset("")
 		{}
 
 		WindowOffset(const char* windowName)
-		:m_windowName(windowName)
+		:m_windowId(WindowRegistry::getWindowRegistry().id(windowName))
+		, m_windowName(WindowRegistry::getWindowRegistry().name(m_windowId))
 		{}
 
 		virtual ~WindowOffset()=default;
@@ -141,8 +153,14 @@ class WindowOffset
 		bool isTargetValid(int x, int y);
 		const char* getWindowName() const;
 
+		WindowId getWindowId() const
+		{
+			return m_windowId;
+		}
+
 	protected:
-		std::string m_windowName;
+		WindowId m_windowId;
+		const char* m_windowName;// kept by the WindowRegistry
 		int m_absoluteX;
 		int m_absoluteY;
 };
@@ -151,7 +169,7 @@ class WindowOffset
 
 inline bool WindowOffset::isAbsolute() const
 {
-	return m_windowName=="root" || m_windowName.length()==0;
+	return m_windowId==WindowRegistry::ROOT || m_windowName[0]=='\0';
 }
 
 //--------------------------------------------------------------------
@@ -161,7 +179,7 @@ inline bool WindowOffset::windowExists()
 	if(isAbsolute()){
 		return true;
 	}
-	return ::windowExists(m_windowName.c_str());
+	return ::windowExists(m_windowId);
 }
 
 //--------------------------------------------------------------------
@@ -171,14 +189,43 @@ inline std::pair<int, int> WindowOffset::getOffset(int x, int y)
 	if(isAbsolute()){
 		return {x, y};
 	}
-	return getWindowCoord(m_windowName.c_str(), x, y);
+	return getWindowCoord(m_windowId, x, y);
 }
 
 //--------------------------------------------------------------------
 
 inline const char* WindowOffset::getWindowName() const
 {
-	return m_windowName.c_str();
+	return m_windowName;
+}
+
+//====================================================================
+
+class MouseMotion
+{
+	public:
+		MouseMotion()=default;
+		virtual ~MouseMotion()=default;
+
+		void setMotion(const MotionSpec& motion);
+		const MotionSpec& getMotion() const;
+
+	protected:
+		MotionSpec m_motion;
+};
+
+//--------------------------------------------------------------------
+
+inline void MouseMotion::setMotion(const MotionSpec& motion)
+{
+	m_motion=motion;
+}
+
+//--------------------------------------------------------------------
+
+inline const MotionSpec& MouseMotion::getMotion() const
+{
+	return m_motion;
 }
 
 //====================================================================
@@ -194,8 +241,13 @@ class BaseCommand
 
 		virtual ~BaseCommand()=default;
 
-		virtual void execute();
-		virtual std::string toString();
+		// commands come from the CommandPool
+		static void* operator new(size_t size);
+		static void operator delete(void* ptr, size_t size);
+
+		// not virtual, the command is in m_cmd already
+		void execute();
+		std::string toString();
 
 		// wait after execution
 		virtual uint wait() const=0;
@@ -203,6 +255,10 @@ class BaseCommand
 		virtual bool ready()=0;
 		virtual int getExitCode() const=0;
 
+		// image difference measured by the last ready() call, counted up to
+		// the sensitivity of the command only; -1 if none
+		virtual long getDifference() const;
+
 		virtual bool isActive() const;
 		virtual void updateActive(bool run);
 		virtual void updateDescription(const char* description);
@@ -221,8 +277,23 @@ class BaseCommand
 
 //--------------------------------------------------------------------
 
+inline void* BaseCommand::operator new(size_t size)
+{
+	return CommandPool::getCommandPool().allocate(size);
+}
+
+//--------------------------------------------------------------------
+
+inline void BaseCommand::operator delete(void* ptr, size_t size)
+{
+	CommandPool::getCommandPool().deallocate(ptr, size);
+}
+
+//--------------------------------------------------------------------
+
 inline void BaseCommand::execute()
 {
+	TraceSpan span("execute", "command", m_description.c_str());
 	m_cmd();
 }
 
@@ -235,6 +306,13 @@ inline std::string BaseCommand::toString()
 
 //--------------------------------------------------------------------
 
+inline long BaseCommand::getDifference() const
+{
+	return -1;
+}
+
+//--------------------------------------------------------------------
+
 inline bool BaseCommand::isActive() const
 {
 	return m_run;
@@ -403,16 +481,18 @@ class ShortcutCommand : public InputCommand
 
 //====================================================================
 
-class MoveMouseCommand : public InputCommand, public WindowOffset
+class MoveMouseCommand : public InputCommand, public WindowOffset, public MouseMotion
 {
 	public:
-		MoveMouseCommand(const char* description, int wait, int x, int y, const char* windowName);
+		// @param duration time in milliseconds the pointer takes to get
+		// there, 0 to go straight away
+		MoveMouseCommand(const char* description, int wait, int x, int y, const char* windowName, uint duration=0);
 
 		virtual ~MoveMouseCommand()=default;
 
-		static InputCommand* Builder(const char* description, int wait, int x, int y, const char* windowName)
+		static InputCommand* Builder(const char* description, int wait, int x, int y, const char* windowName, uint duration=0)
 		{
-			return new MoveMouseCommand(description, wait, x, y, windowName);
+			return new MoveMouseCommand(description, wait, x, y, windowName, duration);
 		}
 
 		virtual int getExitCode() const override
@@ -423,12 +503,13 @@ class MoveMouseCommand : public InputCommand, public WindowOffset
 	private:
 		int m_x;
 		int m_y;
+		uint m_duration;
 		uint m_statusCode;
 };
 
 //====================================================================
 
-class MouseLeftBtnCommand : public InputCommand, public WindowOffset
+class MouseLeftBtnCommand : public InputCommand, public WindowOffset, public MouseMotion
 {
 	public:
 		MouseLeftBtnCommand(const char* description, int wait, int x, int y, const char* windowName);
@@ -453,7 +534,7 @@ class MouseLeftBtnCommand : public InputCommand, public WindowOffset
 
 //====================================================================
 
-class MouseRightBtnCommand : public InputCommand, public WindowOffset
+class MouseRightBtnCommand : public InputCommand, public WindowOffset, public MouseMotion
 {
 	public:
 		MouseRightBtnCommand(const char* description, int wait, int x, int y, const char* windowName);
@@ -478,7 +559,7 @@ class MouseRightBtnCommand : public InputCommand, public WindowOffset
 
 //====================================================================
 
-class MouseSelectCommand : public InputCommand, public WindowOffset
+class MouseSelectCommand : public InputCommand, public WindowOffset, public MouseMotion
 {
 	public:
 		MouseSelectCommand(const char* description, int wait, uint posX, uint posY, int width, int height, const char* windowName);
@@ -500,20 +581,20 @@ class MouseSelectCommand : public InputCommand, public WindowOffset
 
 //====================================================================
 
-class MouseDragCommand : public InputCommand, public WindowOffset
+class MouseDragCommand : public InputCommand, public WindowOffset, public MouseMotion
 {
 	public:
-		MouseDragCommand(const char* description, int wait, int startX, int startY, int endX, int endY, const char* windowName);
+		MouseDragCommand(const char* description, int wait, int startX, int startY, int endX, int endY, const char* windowName, uint duration=0);
 		MouseDragCommand(const char* description, int wait, int endX, int endY, const char* windowName);
 
 		virtual ~MouseDragCommand()=default;
 
-		static InputCommand* Builder(const char* description, int wait, int startX, int startY, int endX, int endY, const char* windowName)
+		static InputCommand* Builder(const char* description, int wait, int startX, int startY, int endX, int endY, const char* windowName, uint duration=0)
 		{
 			if(startX<0){				
 				return new MouseDragCommand(description, wait, endX, endY, windowName);
 			}
-			return new MouseDragCommand(description, wait, startX, startY, endX, endY, windowName);
+			return new MouseDragCommand(description, wait, startX, startY, endX, endY, windowName, duration);
 		}
 
 		static InputCommand* Builder(const char* description, int wait, int endX, int endY, const char* windowName)
@@ -526,7 +607,71 @@ class MouseDragCommand : public InputCommand, public WindowOffset
 		int m_startY;
 		int m_endX; //relative to the current window
 		int m_endY;
+		uint m_duration;
+		uint m_statusCode;
+};
+
+//====================================================================
+
+/*
+ * Turn the mouse wheels with the pointer at (x, y), positive ticks
+ * scroll up and right.
+ * */
+class MouseScrollCommand : public InputCommand, public WindowOffset, public MouseMotion
+{
+	public:
+		MouseScrollCommand(const char* description, int wait, int x, int y, const char* windowName, int vertical, int horizontal=0);
+
+		virtual ~MouseScrollCommand()=default;
+
+		static InputCommand* Builder(const char* description, int wait, int x, int y, const char* windowName, int vertical, int horizontal=0)
+		{
+			return new MouseScrollCommand(description, wait, x, y, windowName, vertical, horizontal);
+		}
+
+		virtual int getExitCode() const override
+		{
+			return m_statusCode;
+		}
+
+	private:
+		int m_x;
+		int m_y;
+		int m_vertical;
+		int m_horizontal;
+		uint m_statusCode;
+};
+
+//====================================================================
+
+/*
+ * Captured input replayed as it was recorded, only on uinput.
+ * */
+class RawEventsCommand : public InputCommand
+{
+	public:
+		RawEventsCommand(const char* description, int wait, const std::vector<RawEvent>& events);
+
+		// @param encoded as saved by encodeRawEvents
+		RawEventsCommand(const char* description, int wait, const std::string& encoded);
+
+		virtual ~RawEventsCommand()=default;
+
+		static InputCommand* Builder(const char* description, int wait, const std::vector<RawEvent>& events)
+		{
+			return new RawEventsCommand(description, wait, events);
+		}
+
+		virtual int getExitCode() const override
+		{
+			return m_statusCode;
+		}
+
+	private:
+		std::vector<RawEvent> m_events;
 		uint m_statusCode;
+
+		void init();
 };
 
 //====================================================================
@@ -541,7 +686,10 @@ class CtrlCommand : public BaseCommand, public WindowOffset
 		};
 
 	public:
-		CtrlCommand(const char* description, const std::string& baseImageName, const char* roiStr, const char* windowName, bool removeImg=true);
+		// @param checkImage false does not look for the base image, the
+		// caller tells whether it exists later with setBaseImageExists
+		// (ScriptLoader checks each image once)
+		CtrlCommand(const char* description, const std::string& baseImageName, const char* roiStr, const char* windowName, bool checkImage=true);
 
 		virtual ~CtrlCommand();
 
@@ -560,6 +708,11 @@ class CtrlCommand : public BaseCommand, public WindowOffset
 			return m_statusCode | 1 * static_cast<int>(m_strictRun && m_statusCode>0);
 		}
 
+		virtual long getDifference() const override
+		{
+			return m_difference;
+		}
+
 		virtual uint wait() const override
 		{
 			return WAIT;
@@ -593,7 +746,6 @@ class CtrlCommand : public BaseCommand, public WindowOffset
 
 		virtual void print(std::ostream& outputStream) override
 		{
-			m_cleanImg=false;
 			outputStream<<ToString2(
 				static_cast<int>(CommandTypes::Ctrl),
 				m_description,
@@ -620,6 +772,15 @@ class CtrlCommand : public BaseCommand, public WindowOffset
 			return m_baseImageName;
 		}
 
+		void setBaseImageExists(bool exists)
+		{
+			m_baseImageExists=exists;
+		}
+
+		// Decode the base image unless it is the one decoded last. It
+		// returns false if the image is missing.
+		bool loadBaseImage();
+
 		virtual void setCtrlCallback();
 
 		virtual void updateBaseImg(const char* baseImg, const char* roiStr);
@@ -657,7 +818,9 @@ class CtrlCommand : public BaseCommand, public WindowOffset
 	protected:
 		std::string m_baseImageName;
 		std::string m_roiStr;
+		std::string m_sampleImageName;
 		CKR m_cbk;
+		long m_difference;
 		uint m_tries;
 		uint m_triesCount;
 		uint m_threshold;
@@ -665,9 +828,7 @@ class CtrlCommand : public BaseCommand, public WindowOffset
 		uint m_sensitivity;
 		bool m_similarity;
 		bool m_strictRun;
-		bool m_cleanImg;
-
-		void removeImg();
+		bool m_baseImageExists;
 };
 
 //====================================================================
@@ -0,0 +1,64 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE. 
+* 
+* void writeJsonString(FILE*, const char*, size_t)                   *
+* void writeJsonString(FILE*, const char*)                           *
+* void writeJsonString(FILE*, const std::string&)                    *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _JSON_STRING_H
+#define _JSON_STRING_H
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+//====================================================================
+
+// quoted and escaped, shared by the tracer, the run report and the
+// orchestrator, none of which needs more of JSON than this
+inline void writeJsonString(FILE* file, const char* str, size_t length)
+{
+	std::fputc('"', file);
+	for(size_t i=0; i<length; i++){
+		unsigned char c=static_cast<unsigned char>(str[i]);
+		if(c=='"' || c=='\\'){
+			std::fputc('\\', file);
+			std::fputc(c, file);
+		}
+		else if(c<0x20){
+			std::fprintf(file, "\\u%04x", c);
+		}
+		else{
+			std::fputc(c, file);
+		}
+	}
+	std::fputc('"', file);
+}
+
+//--------------------------------------------------------------------
+
+inline void writeJsonString(FILE* file, const char* str)
+{
+	writeJsonString(file, str, std::strlen(str));
+}
+
+//--------------------------------------------------------------------
+
+inline void writeJsonString(FILE* file, const std::string& str)
+{
+	writeJsonString(file, str.data(), str.size());
+}
+
+//====================================================================
+
+#endif
@@ -7,6 +7,7 @@
 * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 * THE SOFTWARE. 
 * 
+* bool readPrintableCharacters(const char*, const std::map<std::string, int>&, ...)
 * class KeyboardEmulatorI                                            *
 * class DummyKeyboard                                                *
 *         	                                                         *
@@ -29,6 +30,15 @@
 
 //====================================================================
 
+/*
+ * Read a table of printable characters (see printable_characters.txt),
+ * @param cbk gets every character with its key codes, -1 terminated.
+ * */
+bool readPrintableCharacters(const char* fileName, const std::map<std::string, int>& keyMap,
+		std::function<void(char, const int*)> cbk);
+
+//====================================================================
+
 class KeyboardEmulatorI : public ErrorReporting
 {
 	typedef std::function<void(KeyboardEmulatorI*)> Combo;
@@ -69,6 +79,11 @@ class KeyboardEmulatorI : public ErrorReporting
 
 		virtual void addWhiteCharacters()=0;
 		virtual void prepareUnicodeInput()=0;
+
+		// between these two calls sendKey is allowed to queue the keys
+		// instead of sending them one by one
+		virtual void beginSequence();
+		virtual void endSequence();
 };
 
 //--------------------------------------------------------------------
@@ -81,6 +96,18 @@ inline bool KeyboardEmulatorI::reload()
 
 //--------------------------------------------------------------------
 
+inline void KeyboardEmulatorI::beginSequence()
+{
+}
+
+//--------------------------------------------------------------------
+
+inline void KeyboardEmulatorI::endSequence()
+{
+}
+
+//--------------------------------------------------------------------
+
 inline void KeyboardEmulatorI::shortcut(const char* sct)
 {
 	ComboStringParser shortcutObj(sct);
@@ -108,11 +135,13 @@ inline void KeyboardEmulatorI::enter()
 
 inline void KeyboardEmulatorI::inputText(const char* text)
 {
+	beginSequence();
 	for(size_t i=0; i<std::strlen(text); i++){
 		if(m_combos.find(text[i])!=m_combos.end()){
 			m_combos[text[i]](this);
 		}
 	}
+	endSequence();
 }
 
 //--------------------------------------------------------------------
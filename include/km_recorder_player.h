@@ -24,6 +24,8 @@
 #include "enumerations.h"
 #include "utilities.h"
 #include "settings_manager.h"
+#include "evdev_recorder.h"
+#include "run_report.h"
 #include "wx_utils.h"
 
 #include <wx/wx.h>
@@ -33,6 +35,8 @@
 
 class EditCtrlCmdPopup;
 class AddCmdPopup;
+class EvdevRecorder;
+class InputCoalescer;
 class ProgressBar;
 class WxWorker;
 
@@ -42,6 +46,13 @@ class RecorderPlayerKM : public wxFrame
 		RecorderPlayerKM(const wxString& title);
 		virtual ~RecorderPlayerKM();
 
+		// with PLAY_ENV set: 0 if the script ran through, 1 if a command
+		// stopped it, 2 if it could not start
+		static int getExitCode()
+		{
+			return s_exitCode;
+		}
+
 	private:
 		enum SelectionType
 		{
@@ -120,6 +131,7 @@ class RecorderPlayerKM : public wxFrame
 
 	private:
 		wxTimer m_timer;
+		wxTimer m_captureTimer;
 
 		std::string m_baseImage;
 		wxString m_roiStr;
@@ -194,7 +206,14 @@ class RecorderPlayerKM : public wxFrame
 		ProgressBar* m_progressBarPtr;
 		WxWorker* m_workerPtr; 
 
+		EvdevRecorder* m_evdevRecorder;
+		InputCoalescer* m_inputCoalescer;
+		std::vector<RawInputEvent> m_capturedEvents; // whole capture, raw
+		wxPoint m_captureStart;
+		bool m_rawCapture;
+
 		ExtScrolledWindow::PlayMode m_mode;
+		RunReport m_runReport;
 		Cmd m_getFocusCmd;
 
 		CommandInputMode m_commandInputMode;
@@ -209,12 +228,20 @@ class RecorderPlayerKM : public wxFrame
 
 		bool m_fullMenu;
 		bool m_indentation;
+		bool m_autoPlay;
+		bool m_runFailed;
+
+		static int s_exitCode;
 
 		void dialogConfirm(const wxString& line1, const wxString& line2);
 		void checkConnection();
 		void UpdateConnection(bool isConnected);
 		void initPopups();
 		bool Pause();
+		bool PreFlightCheck();
+		bool StartPlaying();
+		void AutoPlay(const wxString& scriptName);
+		void AutoPlayFinished(int exitCode);
 
 		void OnModeSelection(CommandInputMode mode);
 
@@ -225,7 +252,7 @@ class RecorderPlayerKM : public wxFrame
 		void clearCommands();
 
 		const char* session(bool regenerate=false);
-		std::string imageId();
+		std::string storeCapture(const std::string& captureImage, bool taken);
 
 		void windowLevelInput(const char* windowName);
 		void takeScreenshotByWindow(const char* windowName);
@@ -238,6 +265,10 @@ class RecorderPlayerKM : public wxFrame
 		size_t getFirstIndex();
 
 		void addCommand();
+
+		void startInputCapture(bool raw);
+		void stopInputCapture();
+		void OnCaptureTimer(wxTimerEvent& event);
 		template<typename T=InputCommand>
 		void addCommand(BaseCommand* cmd);
 
@@ -285,6 +316,12 @@ class RecorderPlayerKM : public wxFrame
 
 inline void RecorderPlayerKM::dialogConfirm(const wxString& line1, const wxString& line2)
 {
+	// nobody is there to press OK
+	if(m_autoPlay){
+		std::cerr<<line2.mb_str()<<": "<<line1.mb_str()<<"\n";
+		return;
+	}
+
 	wxMessageDialog dialog(this, line1, line2, wxOK);
 	dialog.ShowModal();
 }
@@ -345,6 +382,12 @@ template<typename T=InputCommand>
 void RecorderPlayerKM::addCommand(BaseCommand* cmd)
 {
 	if(cmd){
+		// new mouse commands move with the default motion, unless they
+		// were given one already
+		MouseMotion* motionPtr=dynamic_cast<MouseMotion*>(cmd);
+		if(motionPtr && motionPtr->getMotion().isLegacy()){
+			motionPtr->setMotion(m_settings.getMotion());
+		}
 		m_scrolledWindow->addCommand<T>(cmd, m_indentation);
 		addCommand();
 	}
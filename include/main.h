@@ -17,5 +17,6 @@ class MyApp : public wxApp
 {
 	public:
 		virtual bool OnInit();
+		virtual int OnRun();
 		virtual void OnClose(wxCloseEvent &event);
 };
@@ -0,0 +1,103 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* enum class MotionProfile                                           *
+* struct MotionStep                                                  *
+* class MotionSpec                                                   *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _MOTION_PROFILE_H
+#define _MOTION_PROFILE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//====================================================================
+
+enum class MotionProfile
+{
+	LEGACY=0, // small steps, checking the pointer after each one
+	INSTANT,
+	LINEAR, // parameter: number of steps
+	EASE_IN_OUT, // parameter: number of steps
+	VELOCITY, // parameter: pixels per second
+	_LAST,
+};
+
+//--------------------------------------------------------------------
+
+struct MotionStep
+{
+	int m_dx;
+	int m_dy;
+	uint32_t m_at; // microseconds from the start of the movement
+};
+
+//====================================================================
+
+/*
+ * How the pointer travels to a target. The whole movement is computed
+ * up front as relative steps with their due time.
+ * */
+class MotionSpec
+{
+	public:
+		enum{
+			STEP_PERIOD=4000, // microseconds between steps
+		};
+
+		MotionSpec(MotionProfile profile=MotionProfile::LEGACY, uint param=0);
+		~MotionSpec()=default;
+
+		MotionProfile profile() const;
+		uint param() const;
+		bool isLegacy() const;
+
+		std::vector<MotionStep> steps(int dx, int dy) const;
+
+		// "name,param" as saved in scripts
+		std::string toString() const;
+		static MotionSpec parse(std::string_view str);
+
+		static const char* name(MotionProfile profile);
+
+	private:
+		MotionProfile m_profile;
+		uint m_param;
+};
+
+//--------------------------------------------------------------------
+
+inline MotionProfile MotionSpec::profile() const
+{
+	return m_profile;
+}
+
+//--------------------------------------------------------------------
+
+inline uint MotionSpec::param() const
+{
+	return m_param;
+}
+
+//--------------------------------------------------------------------
+
+inline bool MotionSpec::isLegacy() const
+{
+	return m_profile==MotionProfile::LEGACY;
+}
+
+//--------------------------------------------------------------------
+
+#endif
@@ -18,6 +18,9 @@
 #define _MOUSE_EMULATOR_H
 
 #include "error_reporting.h"
+#include "motion_profile.h"
+#include "pointer_response.h"
+
 #include <functional>
 
 //====================================================================
@@ -52,19 +55,73 @@ class MouseEmulatorI : public ErrorReporting
 		 * */
 		virtual void go2Position(const int absX, const int absY, ClientMousePosition getMousePosition);
 
+		/*
+		 * Same as above following @param motion, the position is checked
+		 * once at the end
+		 * */
+		void go2Position(const int absX, const int absY, ClientMousePosition getMousePosition, const MotionSpec& motion);
+
+		/*
+		 * Move the mouse in a straight line to the absolute position
+		 * (absX, absY) taking @param duration milliseconds, as a user would
+		 * */
+		void glide(const int absX, const int absY, uint duration, ClientMousePosition getMousePosition);
+
 		/*
 		 * Select rectangle: (absX, absY, width, height)
 		 * Note that width and height can be negative values
 		 * */
-		void select(uint absX, uint absY, uint width, uint height, ClientMousePosition getMousePosition);
+		void select(uint absX, uint absY, uint width, uint height, ClientMousePosition getMousePosition, const MotionSpec& motion=MotionSpec());
 
 		/*
 		 * Drag the mouse from absolute position (startX, startY)
-		 * to absolute position (endX, endY)
+		 * to absolute position (endX, endY), if @param duration is not 0 the
+		 * pointer travels at the speed it was recorded
+		 * */
+		void drag(uint startX, uint startY, uint endX, uint endY, ClientMousePosition getMousePosition,
+						uint duration=0, const MotionSpec& motion=MotionSpec());
+
+		/*
+		 * In open loop mode the pointer position is not read after every
+		 * step, an internal model (last verified position plus the emitted
+		 * deltas) is used instead and the position is read once at the end
+		 * of each movement. The pointer gain is measured the first time.
+		 * */
+		void setOpenLoop(bool openLoop);
+
+		bool isOpenLoop() const
+		{
+			return m_openLoop;
+		}
+
+		// the pointer may have been moved by somebody else
+		void resetModel()
+		{
+			m_modelValid=false;
+		}
+
+		/*
+		 * Measure how far single events of increasing size move the
+		 * pointer and use it from then on, see setResponse. The pointer
+		 * is left where it was. It returns false if the pointer did not
+		 * respond.
+		 * */
+		bool calibrateResponse(ClientMousePosition getMousePosition, PointerResponse& response);
+
+		/*
+		 * With a response curve movements are sent as a few large events
+		 * sized to land on the target instead of many small steps
 		 * */
-		void drag(uint startX, uint startY, uint endX, uint endY, ClientMousePosition getMousePosition);
+		void setResponse(const PointerResponse& response)
+		{
+			m_response=response;
+		}
 		
-		//void scroll(const int x, const int y);
+		/*
+		 * Turn the wheels by the given number of ticks, positive values
+		 * scroll up and right. All the ticks go in a single report.
+		 * */
+		void scroll(const int vertical, const int horizontal);
 
 	private:
 		// for some reason as the values are bigger there is some lost of presicion
@@ -72,16 +129,47 @@ class MouseEmulatorI : public ErrorReporting
 		{
 			LOW=3,
 			THR=LOW+1,
+			GLIDE_PERIOD=8, // ms
+			GLIDE_CHECK=8, // steps between readings of the position
+			MOTION_PASSES=3, // corrections of a motion before the closed loop
+			OPEN_LOOP_SPEED=4000, // counts per second
+			CALIBRATION_COUNTS=100,
+			RESPONSE_REPEATS=3,
 		};
 
+		PointerResponse m_response;
+		double m_gain{1.0}; // pixels per count
+		int m_modelX{0};
+		int m_modelY{0};
+		bool m_openLoop{false};
+		bool m_modelValid{false};
+		bool m_calibrated{false};
+
 		/*
 		 * Move the mouse to the relative position (dx, dy)
 		 * */
 		virtual void setPosition(const int dx, const int dy)=0;
 		virtual void buttonDown(MOUSE_BUTTONS btn)=0;
 		virtual void buttonUp(MOUSE_BUTTONS btn)=0;
+		virtual void wheel(const int vertical, const int horizontal)=0;
+
+		/*
+		 * One step of a precomputed movement, it should not wait
+		 * */
+		virtual void moveStep(const int dx, const int dy);
 
 		void moveAbs(const int absX, const int absY, ClientMousePosition getMousePosition);
+		void moveAbs(const int absX, const int absY, ClientMousePosition getMousePosition, const MotionSpec& motion);
+		void playSteps(const std::vector<MotionStep>& steps);
+
+		void closedLoop(const int absX, const int absY, ClientMousePosition getMousePosition);
+
+		void openLoopMove(const int absX, const int absY, ClientMousePosition getMousePosition);
+		void calibrate(ClientMousePosition getMousePosition);
+		void syncModel(ClientMousePosition getMousePosition);
+		void verify(const int absX, const int absY, ClientMousePosition getMousePosition);
+		void emitPixels(int& dx, int& dy);
+		void jump(const int dx, const int dy);
 };
 
 //--------------------------------------------------------------------
@@ -94,6 +182,22 @@ inline bool MouseEmulatorI::reload()
 
 //--------------------------------------------------------------------
 
+inline void MouseEmulatorI::scroll(const int vertical, const int horizontal)
+{
+	if(vertical!=0 || horizontal!=0){
+		wheel(vertical, horizontal);
+	}
+}
+
+//--------------------------------------------------------------------
+
+inline void MouseEmulatorI::moveStep(const int dx, const int dy)
+{
+	setPosition(dx, dy);
+}
+
+//--------------------------------------------------------------------
+
 class DummyMouse : public MouseEmulatorI
 {
 	public:
@@ -105,6 +209,7 @@ class DummyMouse : public MouseEmulatorI
 		virtual void setPosition(const int dx, const int dy){}
 		virtual void buttonDown(MOUSE_BUTTONS btn){}
 		virtual void buttonUp(MOUSE_BUTTONS btn){}
+		virtual void wheel(const int vertical, const int horizontal){}
 };
 
 //====================================================================
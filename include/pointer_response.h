@@ -0,0 +1,74 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class PointerResponse                                              *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _POINTER_RESPONSE_H
+#define _POINTER_RESPONSE_H
+
+#include <string>
+#include <vector>
+
+//====================================================================
+
+/*
+ * Response curve of a relative pointer: how many pixels the pointer
+ * travels for a single event of a given number of counts, measured
+ * on the current display with its pointer acceleration. The inverse
+ * gives the event that lands on a given distance.
+ * */
+class PointerResponse
+{
+	public:
+		PointerResponse()=default;
+		~PointerResponse()=default;
+
+		bool empty() const
+		{
+			return m_samples.size()<2;
+		}
+
+		void clear()
+		{
+			m_samples.clear();
+		}
+
+		// samples must be added with increasing counts
+		void addSample(int counts, double pixels);
+
+		double pixels(int counts) const;
+
+		int counts(double pixels) const;
+
+		// longest distance covered by a single calibrated event
+		double maxPixels() const;
+
+		int maxCounts() const;
+
+		// "counts/pixels,..." as saved in the settings file
+		std::string toString() const;
+		static PointerResponse parse(const char* str);
+
+	private:
+		struct Sample
+		{
+			int m_counts;
+			double m_pixels;
+		};
+
+		std::vector<Sample> m_samples;
+};
+
+//====================================================================
+
+#endif
@@ -0,0 +1,76 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class PreFlight                                                    *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _PRE_FLIGHT_H
+#define _PRE_FLIGHT_H
+
+#include <string>
+#include <vector>
+
+class BaseCommand;
+
+//====================================================================
+
+/*
+ * Checks made before a run instead of minutes into it: the base
+ * images of the control commands exist, the windows the commands
+ * target are open and the input interface answers. The images and
+ * the windows are shared out between threads, the interface is
+ * checked on its own thread.
+ * It leaves the caches warm: the window ids are resolved and the
+ * first base image of the run is decoded.
+ * A missing image is an error; a missing window is only a warning,
+ * an earlier command may be the one opening it.
+ * */
+class PreFlight
+{
+	public:
+		enum Severity
+		{
+			WARNING,
+			ERROR,
+		};
+
+		struct Problem
+		{
+			Severity m_severity;
+			std::string m_message;
+		};
+
+	public:
+		PreFlight()=default;
+
+		// @param commands the active commands in play order
+		// @param workers 0 for one per core
+		// It returns false if there is an error.
+		bool run(const std::vector<BaseCommand*>& commands, uint workers=0);
+
+		const std::vector<Problem>& getProblems() const
+		{
+			return m_problems;
+		}
+
+		bool hasErrors() const;
+
+		// one problem per line, errors first
+		std::string report() const;
+
+	private:
+		std::vector<Problem> m_problems;
+};
+
+//====================================================================
+
+#endif
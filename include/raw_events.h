@@ -0,0 +1,56 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* struct RawEvent                                                    *
+* std::vector<RawEvent> toRawEvents(...)                             *
+* std::string encodeRawEvents(...)                                   *
+* bool decodeRawEvents(...)                                          *
+* bool isPointerEvent(...)                                           *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _RAW_EVENTS_H
+#define _RAW_EVENTS_H
+
+#include "evdev_recorder.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//====================================================================
+
+struct RawEvent
+{
+	uint32_t m_delay; // microseconds since the previous event
+	uint16_t m_type;
+	uint16_t m_code;
+	int32_t m_value;
+};
+
+static_assert(sizeof(RawEvent)==12, "RawEvent is stored as it is");
+
+//--------------------------------------------------------------------
+
+// keep the time between events, keyboard, pointer and SYN_REPORT only
+std::vector<RawEvent> toRawEvents(const std::vector<RawInputEvent>& captured);
+
+// the blob (little endian, as in memory) in base 64, safe in a script line
+std::string encodeRawEvents(const std::vector<RawEvent>& events);
+
+bool decodeRawEvents(const char* encoded, size_t length, std::vector<RawEvent>& events);
+
+// whether the event goes to the pointer device rather than the keyboard
+bool isPointerEvent(const RawEvent& event);
+
+//====================================================================
+
+#endif
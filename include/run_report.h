@@ -0,0 +1,100 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class RunReport                                                    *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _RUN_REPORT_H
+#define _RUN_REPORT_H
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+class BaseCommand;
+
+// the report of a script goes next to it as .<script>.report.json and
+// .<script>.report.csv, hidden so they are not listed as scripts
+#define REPORT_EXT ".report"
+
+//====================================================================
+
+/*
+ * Timing and outcome of every command run during a playback. A command
+ * run lasts from execute() to the ready() call that returns true, the
+ * latency percentiles are taken over all the runs of a command (one
+ * per loop iteration) and over the whole playback.
+ * */
+class RunReport final
+{
+	public:
+		struct Latency
+		{
+			double m_p50;
+			double m_p95;
+			double m_p99;
+			double m_max;
+			double m_mean;
+		};
+
+	public:
+		RunReport()=default;
+		~RunReport()=default;
+
+		void begin();
+
+		void commandStarted(const BaseCommand* cmd, uint iteration);
+
+		// after every ready() call on the command started last
+		void commandPolled(const BaseCommand* cmd, bool done);
+
+		bool empty() const
+		{
+			return m_runs.empty();
+		}
+
+		// Write @param basePath.json and @param basePath.csv, it returns
+		// false if either file cannot be written.
+		bool save(const std::string& basePath, const std::string& scriptName) const;
+
+		// nearest rank percentiles of @param values, which get sorted
+		static Latency latency(std::vector<double>& values);
+
+	private:
+		struct CommandRun
+		{
+			size_t m_command;
+			uint m_iteration;
+			uint m_polls;
+			int m_exitCode;
+			long m_difference; // capped at the sensitivity, see getDifference
+			double m_start; // ms since begin()
+			double m_end;
+			bool m_done;
+		};
+
+		std::chrono::steady_clock::time_point m_begin;
+		std::string m_startedAt;
+		std::map<const BaseCommand*, size_t> m_commandIds;
+		std::vector<std::string> m_descriptions;
+		std::vector<CommandRun> m_runs;
+
+		double elapsed() const;
+
+		bool saveJson(const std::string& filePath, const std::string& scriptName) const;
+		bool saveCsv(const std::string& filePath) const;
+};
+
+//====================================================================
+
+#endif
@@ -0,0 +1,114 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class ScriptJournal                                                *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _SCRIPT_JOURNAL_H
+#define _SCRIPT_JOURNAL_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//====================================================================
+
+/*
+ * Saving a script appends the edits made since the last save to a
+ * log next to it (.name.journal) instead of writing the whole script
+ * again, so a save costs the same whatever the length of the script.
+ * Every batch ends with a commit mark and is synced to disk; loading
+ * the script replays the committed batches and drops a torn tail.
+ * Once the log is long the script is written again in full (to a
+ * temporary file renamed over it) and the log starts over.
+ *
+ * The operations use the position of the line among the non empty
+ * lines of the script:
+ *   a <index> <line>    insert the line at index
+ *   r <index>           remove the line at index
+ *   s <index>           swap the lines at index and index+1
+ *   m <index> <line>    replace the line at index
+ *   c                   commit
+ * The log starts with the hash of the script it applies to, a log
+ * left behind by a full save that did not finish is ignored.
+ * */
+class ScriptJournal
+{
+	public:
+		enum
+		{
+			// size of the log before the script is written in full
+			COMPACT_AFTER=1<<20,
+		};
+
+	public:
+		ScriptJournal();
+
+		// Journal the edits of @param scriptPath, whose content hashes to
+		// @param baseHash; the first @param logBytes of its log are kept.
+		void attach(const std::string& scriptPath, uint64_t baseHash, size_t logBytes=0);
+
+		void detach();
+
+		bool isAttached() const
+		{
+			return m_attached;
+		}
+
+		bool isAttached(const std::string& scriptPath) const
+		{
+			return m_attached && m_scriptPath==scriptPath;
+		}
+
+		void add(size_t index, std::string_view line);
+		void remove(size_t index);
+		void swap(size_t index);
+		void modify(size_t index, std::string_view line);
+
+		bool needsCompaction() const
+		{
+			return m_logBytes+m_pending.length()>COMPACT_AFTER;
+		}
+
+		// append the pending operations and a commit mark to the log
+		bool commit();
+
+		static std::string logPath(const std::string& scriptPath);
+
+		static bool hasLog(const std::string& scriptPath);
+
+		static void removeLog(const std::string& scriptPath);
+
+		static uint64_t contentHash(std::string_view data);
+
+		// Apply the committed operations of the log of @param scriptPath to
+		// @param lines. It returns false when there is no log for a script
+		// with @param baseHash; @param logBytes is the committed length.
+		static bool replay(const std::string& scriptPath, uint64_t baseHash, std::vector<std::string>& lines, size_t& logBytes);
+
+		// write @param data to a temporary file and rename it to @param filePath
+		static bool replaceFile(const std::string& filePath, std::string_view data);
+
+	private:
+		std::string m_scriptPath;
+		std::string m_pending;
+		uint64_t m_baseHash;
+		size_t m_logBytes;
+		bool m_attached;
+
+		void append(char operation, size_t index, std::string_view line=std::string_view());
+};
+
+//====================================================================
+
+#endif
@@ -0,0 +1,113 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* struct ScriptEntry                                                 *
+* class ScriptLoader                                                 *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _SCRIPT_LOADER_H
+#define _SCRIPT_LOADER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class BaseCommand;
+
+//====================================================================
+
+// a line of a script: a command or the start or end of a loop
+struct ScriptEntry
+{
+	enum Type
+	{
+		COMMAND,
+		LOOP,
+		END_LOOP,
+	};
+
+	Type m_type;
+	int m_times;
+	BaseCommand* m_command;
+};
+
+//====================================================================
+
+/*
+ * Parse a script file on several threads. The file is memory mapped
+ * and cut into ranges of whole lines, every range is parsed on its
+ * own thread and the results are merged in file order. The base
+ * images of the control commands are looked for once per image after
+ * the parse instead of once per command.
+ * Edits saved to the journal of the script (see ScriptJournal) are
+ * replayed before parsing. The loader owns the commands until
+ * takeEntries.
+ * */
+class ScriptLoader
+{
+	public:
+		ScriptLoader()=default;
+
+		~ScriptLoader();
+
+		// @param workers 0 for one per core, small files use less
+		bool load(const char* filePath, uint workers=0);
+
+		// for instance "line 12, field 4: not a number"
+		const std::string& getError() const
+		{
+			return m_error;
+		}
+
+		size_t size() const
+		{
+			return m_entries.size();
+		}
+
+		// non empty lines, including those of loops
+		size_t lineCount() const
+		{
+			return m_lineCount;
+		}
+
+		// hash of the file as it is on disk, without the journal
+		uint64_t getBaseHash() const
+		{
+			return m_baseHash;
+		}
+
+		// committed length of the journal replayed, 0 if none
+		size_t getLogBytes() const
+		{
+			return m_logBytes;
+		}
+
+		// the caller takes over the commands
+		std::vector<ScriptEntry> takeEntries();
+
+	private:
+		std::vector<ScriptEntry> m_entries;
+		std::string m_error;
+		uint64_t m_baseHash{0};
+		size_t m_logBytes{0};
+		size_t m_lineCount{0};
+
+		void clear();
+		void checkImages();
+
+		ScriptLoader(const ScriptLoader&)=delete;
+		ScriptLoader& operator=(const ScriptLoader&)=delete;
+};
+
+//====================================================================
+
+#endif
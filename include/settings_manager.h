@@ -17,17 +17,16 @@
 #define _SETTINGS_MANAGER_H
 
 #include "utilities.h"
-#include "cstr_split.h"
+#include "field_split.h"
 
 #include "hid_manager.h"
 #include "enumerations.h"
+#include "motion_profile.h"
 
 #include <fstream>
 #include <wx/string.h>
 #include <wx/msgdlg.h>
 
-#define SETTINGS_FILE ".save_settings.txt"
-
 //====================================================================
 
 class SettingsManager final
@@ -202,6 +201,84 @@ class SettingsManager final
 			m_port=port;
 		}
 
+		ImageFormat getSampleFormat() const
+		{
+			return m_sampleFormat;
+		}
+
+		void setSampleFormat(int format)
+		{
+			if(format>=0 && format<int(ImageFormat::_LAST)){
+				m_sampleFormat=ImageFormat(format);
+			}
+		}
+
+		ImageFormat getBaseImageFormat() const
+		{
+			return m_baseImageFormat;
+		}
+
+		void setBaseImageFormat(int format)
+		{
+			if(format>=0 && format<int(ImageFormat::_LAST)){
+				m_baseImageFormat=ImageFormat(format);
+			}
+		}
+
+		bool getFastTyping() const
+		{
+			return m_fastTyping;
+		}
+
+		// keys per second in fast typing mode, 0 for no limit
+		uint getTypingRate() const
+		{
+			return m_typingRate;
+		}
+
+		void setTypingMode(bool fast, uint keysPerSecond)
+		{
+			m_fastTyping=fast;
+			m_typingRate=keysPerSecond;
+			HIDManager::SetTypingMode(m_fastTyping, m_typingRate);
+		}
+
+		bool getOpenLoopMouse() const
+		{
+			return m_openLoopMouse;
+		}
+
+		void setOpenLoopMouse(bool openLoop)
+		{
+			m_openLoopMouse=openLoop;
+			HIDManager::SetOpenLoopMouse(m_openLoopMouse);
+		}
+
+		PointerResponse getPointerResponse() const
+		{
+			return PointerResponse::parse(m_pointerResponse.c_str());
+		}
+
+		void setPointerResponse(const PointerResponse& response)
+		{
+			m_pointerResponse=response.toString();
+			HIDManager::SetPointerResponse(response);
+		}
+
+		// motion given to new mouse commands
+		MotionSpec getMotion() const
+		{
+			return MotionSpec(m_motionProfile, m_motionParam);
+		}
+
+		void setMotion(int profile, uint param)
+		{
+			if(profile>=0 && profile<int(MotionProfile::_LAST)){
+				m_motionProfile=MotionProfile(profile);
+				m_motionParam=param;
+			}
+		}
+
 	private:
 		wxString m_brushColour{"#0000FF"};
 		wxString m_serialPort{""};
@@ -213,6 +290,14 @@ class SettingsManager final
 		InterfaceLink m_interface{InterfaceLink::NONE};
 		uint m_baudRate{0};
 		uint m_port{0};
+		ImageFormat m_sampleFormat{ImageFormat::PPM};
+		ImageFormat m_baseImageFormat{ImageFormat::PNG};
+		bool m_fastTyping{false};
+		uint m_typingRate{500};
+		MotionProfile m_motionProfile{MotionProfile::LEGACY};
+		uint m_motionParam{0};
+		bool m_openLoopMouse{false};
+		std::string m_pointerResponse{""};
 
 		SettingsManager()=default;
 };
@@ -229,7 +314,15 @@ inline void SettingsManager::saveToFile(std::ostream& outputStream)
 					<<m_serialPort<<":"
 					<<m_baudRate<<":"
 					<<m_ip<<":"
-					<<m_port<<": : :\n";
+					<<m_port<<":"
+					<<uint(m_sampleFormat)<<":"
+					<<uint(m_baseImageFormat)<<":"
+					<<m_fastTyping<<":"
+					<<m_typingRate<<":"
+					<<uint(m_motionProfile)<<":"
+					<<m_motionParam<<":"
+					<<m_openLoopMouse<<":"
+					<<(m_pointerResponse.empty() ? " " : m_pointerResponse)<<": : :\n";
 }
 
 //--------------------------------------------------------------------
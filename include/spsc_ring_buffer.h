@@ -0,0 +1,113 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class SpscRingBuffer                                               *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _SPSC_RING_BUFFER_H
+#define _SPSC_RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+
+//====================================================================
+
+/*
+ * Lock free queue for exactly one producer thread and one consumer
+ * thread. @param N must be a power of two.
+ * */
+template<typename T, size_t N>
+class SpscRingBuffer
+{
+	static_assert(N>1 && (N & (N-1))==0, "N must be a power of two");
+
+	public:
+		SpscRingBuffer()
+		: m_head(0)
+		, m_tail(0)
+		{}
+
+		~SpscRingBuffer()=default;
+
+		// producer side, it returns false if the buffer is full
+		bool push(const T& item);
+
+		// producer side
+		size_t freeSlots() const;
+
+		// consumer side, it returns false if the buffer is empty
+		bool pop(T& item);
+
+		void clear();
+
+	private:
+		T m_items[N];
+		alignas(64) std::atomic<size_t> m_head; // next slot to write
+		alignas(64) std::atomic<size_t> m_tail; // next slot to read
+
+		SpscRingBuffer(const SpscRingBuffer&)=delete;
+		SpscRingBuffer& operator=(const SpscRingBuffer&)=delete;
+};
+
+//--------------------------------------------------------------------
+
+template<typename T, size_t N>
+bool SpscRingBuffer<T, N>::push(const T& item)
+{
+	size_t head=m_head.load(std::memory_order_relaxed);
+	if(head-m_tail.load(std::memory_order_acquire)==N){
+		return false;
+	}
+
+	m_items[head & (N-1)]=item;
+	m_head.store(head+1, std::memory_order_release);
+
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+template<typename T, size_t N>
+size_t SpscRingBuffer<T, N>::freeSlots() const
+{
+	return N-(m_head.load(std::memory_order_relaxed)-m_tail.load(std::memory_order_acquire));
+}
+
+//--------------------------------------------------------------------
+
+template<typename T, size_t N>
+bool SpscRingBuffer<T, N>::pop(T& item)
+{
+	size_t tail=m_tail.load(std::memory_order_relaxed);
+	if(tail==m_head.load(std::memory_order_acquire)){
+		return false;
+	}
+
+	item=m_items[tail & (N-1)];
+	m_tail.store(tail+1, std::memory_order_release);
+
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+// only when neither side is running
+template<typename T, size_t N>
+void SpscRingBuffer<T, N>::clear()
+{
+	m_head.store(0, std::memory_order_relaxed);
+	m_tail.store(0, std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------------
+
+#endif
@@ -18,7 +18,9 @@
 
 #include "TinyUSB_Link_Lib/connector_interface.h"
 #include "debug_utils.h"
+#include "trace.h"
 
+#include <chrono>
 #include <cstring>
 #include <thread>
 
@@ -26,15 +28,32 @@
 
 struct TinyusbConnector
 {
+	enum{
+		HID_POLL_INTERVAL=10, // ms, bInterval of the firmware
+	};
+
 	static ConnectorI* s_connector;
 
 	static void setConnector(bool connectionType, const char* alpha, uint numb);
 
+	/*
+	 * The firmware acknowledges a report from tud_hid_report_complete_cb,
+	 * once the host has read it, and right then queues the empty key
+	 * release report on the keyboard endpoint. That one is only read on
+	 * the next poll, one bInterval (10 ms, usb_descriptors.c) later; a
+	 * report arriving before finds the endpoint busy and is dropped. So
+	 * the next report goes at least one bInterval after the last ACK,
+	 * reports already further apart than that are not delayed.
+	 * */
 	static void sendAndWait(void* data, uint dataSize)
 	{
+		static std::chrono::steady_clock::time_point s_lastAck;
+
+		TraceSpan span("sendAndWait", "hid");
+		std::this_thread::sleep_until(s_lastAck+std::chrono::milliseconds(HID_POLL_INTERVAL));
 		s_connector->send(data, dataSize);
 		if(s_connector->receive(600)){
-			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			s_lastAck=std::chrono::steady_clock::now();
 		}
 	}
 
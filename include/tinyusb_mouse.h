@@ -54,6 +54,7 @@ class TinyusbMouse : protected TinyusbConnector, public MouseEmulatorI
 
 		virtual void buttonDown(MOUSE_BUTTONS btn) override;
 		virtual void buttonUp(MOUSE_BUTTONS btn) override;
+		virtual void wheel(const int vertical, const int horizontal) override;
 };
 
 //--------------------------------------------------------------------
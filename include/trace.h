@@ -0,0 +1,186 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class Tracer                                                       *
+* class TraceSpan                                                    *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _TRACE_H
+#define _TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// environment variable naming the file the trace is written to on exit,
+// tracing is enabled at start up when it is set
+#define TRACE_ENV "KMRP_TRACE"
+
+// hidden, every other file in the script directory is listed as a script
+#define TRACE_FILE ".trace.json"
+
+//====================================================================
+
+struct TraceEvent
+{
+	enum{
+		DETAIL_SIZE=48
+	};
+
+	const char* m_name;
+	const char* m_category;
+	int64_t m_start;
+	int64_t m_duration;
+	char m_detail[DETAIL_SIZE];
+};
+
+//====================================================================
+
+/*
+ * Complete spans ('X' events in the Chrome trace format) are kept in
+ * one buffer per thread, so recording only takes an uncontended lock.
+ * Timestamps come from steady_clock and are relative to the moment the
+ * tracer was created. When tracing is disabled a span costs a relaxed
+ * atomic load.
+ * */
+class Tracer final
+{
+	public:
+		enum{
+			// spans kept per thread, later spans are dropped and counted
+			MAX_EVENTS=1<<16
+		};
+
+		static Tracer& getTracer()
+		{
+			static Tracer tracer;
+			return tracer;
+		}
+
+		void setEnabled(bool enabled);
+
+		bool isEnabled() const
+		{
+			return m_enabled.load(std::memory_order_relaxed);
+		}
+
+		int64_t now() const
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-m_epoch).count();
+		}
+
+		void record(const TraceEvent& event);
+
+		void clear();
+
+		// number of spans recorded (and dropped) since the last clear
+		size_t size();
+		size_t dropped();
+
+		// Write the spans of every thread as a Chrome trace (JSON object
+		// format), it can be opened by chrome://tracing or Perfetto.
+		bool dump(const char* filePath);
+
+	private:
+		struct ThreadBuffer
+		{
+			std::mutex m_mutex;
+			std::vector<TraceEvent> m_events;
+			size_t m_dropped{0};
+			uint m_tid{0};
+		};
+
+		std::chrono::steady_clock::time_point m_epoch;
+		std::atomic<bool> m_enabled;
+		std::mutex m_mutex;
+		std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+
+		ThreadBuffer& threadBuffer();
+
+		Tracer()
+		: m_epoch(std::chrono::steady_clock::now())
+		, m_enabled(false)
+		{}
+
+		Tracer(const Tracer&)=delete;
+		Tracer& operator=(const Tracer&)=delete;
+};
+
+//====================================================================
+
+/*
+ * Record the lifetime of the object as a span. @param name and
+ * @param category must outlive the tracer (string literals), @param
+ * detail is copied and truncated.
+ * */
+class TraceSpan final
+{
+	public:
+		TraceSpan(const char* name, const char* category, const char* detail=nullptr);
+
+		~TraceSpan();
+
+	private:
+		TraceEvent m_event;
+
+		TraceSpan(const TraceSpan&)=delete;
+		TraceSpan& operator=(const TraceSpan&)=delete;
+};
+
+//--------------------------------------------------------------------
+
+inline TraceSpan::TraceSpan(const char* name, const char* category, const char* detail)
+{
+	Tracer& tracer=Tracer::getTracer();
+	if(!tracer.isEnabled()){
+		m_event.m_start=-1;
+		return;
+	}
+
+	m_event.m_name=name;
+	m_event.m_category=category;
+	m_event.m_detail[0]='\0';
+	if(detail!=nullptr){
+		int i=0;
+		for(; i<TraceEvent::DETAIL_SIZE-1 && detail[i]!='\0'; i++){
+			m_event.m_detail[i]=detail[i];
+		}
+		if(detail[i]!='\0'){
+			// truncated, do not leave half a UTF-8 character behind
+			while(i>0 && (static_cast<unsigned char>(detail[i]) & 0xC0)==0x80){
+				i--;
+			}
+		}
+		m_event.m_detail[i]='\0';
+	}
+	m_event.m_start=tracer.now();
+}
+
+//--------------------------------------------------------------------
+
+inline TraceSpan::~TraceSpan()
+{
+	if(m_event.m_start<0){
+		return;
+	}
+
+	Tracer& tracer=Tracer::getTracer();
+	m_event.m_duration=tracer.now()-m_event.m_start;
+	tracer.record(m_event);
+}
+
+//====================================================================
+
+#endif
@@ -0,0 +1,45 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* struct PointerSample                                               *
+* std::vector<PointerSample> simplifyTrajectory(...)                 *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _TRAJECTORY_H
+#define _TRAJECTORY_H
+
+#include <cstdint>
+#include <vector>
+
+//====================================================================
+
+struct PointerSample
+{
+	int64_t m_time; // microseconds, CLOCK_MONOTONIC
+	int m_x;
+	int m_y;
+};
+
+//====================================================================
+
+/*
+ * Ramer-Douglas-Peucker on (x, y, t). The error of a sample is its
+ * distance to where the pointer would be at that time moving at constant
+ * speed between the ends of the segment, so the waypoints kept reproduce
+ * both the shape and the pace of the path within @param tolerance pixels.
+ * The first and last samples are always kept.
+ * */
+std::vector<PointerSample> simplifyTrajectory(const std::vector<PointerSample>& path, double tolerance);
+
+//====================================================================
+
+#endif
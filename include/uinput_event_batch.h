@@ -0,0 +1,115 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class UinputEventBatch                                             *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _UINPUT_EVENT_BATCH_H
+#define _UINPUT_EVENT_BATCH_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "trace.h"
+
+#include <unistd.h>
+#include <linux/uinput.h>
+
+//====================================================================
+
+/*
+ * Accumulate input_events and hand them to uinput with a single
+ * write(). The kernel splits them back into SYN_REPORT frames, so
+ * a whole chord (press frame + release frame) can go in one call.
+ * */
+class UinputEventBatch
+{
+	public:
+		enum{
+			MAX_EVENTS=32
+		};
+
+		// @param fd is the uinput file descriptor of the owner, it may be
+		// reopened at any time
+		UinputEventBatch(const int& fd)
+		: m_fd(fd)
+		, m_size(0)
+		{}
+
+		~UinputEventBatch()=default;
+
+		void add(int type, int code, int val);
+
+		bool flush();
+
+		// number of write() calls done on any uinput device so far,
+		// use the difference between two readings for per command stats
+		static uint64_t writeCount()
+		{
+			return counter().load(std::memory_order_relaxed);
+		}
+
+	private:
+		input_event m_events[MAX_EVENTS];
+		const int& m_fd;
+		int m_size;
+
+		static std::atomic<uint64_t>& counter()
+		{
+			static std::atomic<uint64_t> s_writeCount{0};
+			return s_writeCount;
+		}
+};
+
+//--------------------------------------------------------------------
+
+inline void UinputEventBatch::add(int type, int code, int val)
+{
+	if(m_size==MAX_EVENTS){
+		flush();
+	}
+
+	input_event& event=m_events[m_size++];
+	event.type=type;
+	event.code=code;
+	event.value=val;
+	// timestamp values below are ignored
+	event.time.tv_sec=0;
+	event.time.tv_usec=0;
+}
+
+//--------------------------------------------------------------------
+
+inline bool UinputEventBatch::flush()
+{
+	TraceSpan span("uinput write", "hid");
+
+	const char* data=reinterpret_cast<const char*>(m_events);
+	ssize_t pending=m_size*sizeof(input_event);
+	m_size=0;
+
+	while(pending>0){
+		counter().fetch_add(1, std::memory_order_relaxed);
+		ssize_t written=write(m_fd, data, pending);
+		if(written<1){
+			return false;
+		}
+		data+=written;
+		pending-=written;
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+#endif
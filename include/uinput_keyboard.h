@@ -21,6 +21,10 @@
 
 #include "key_conversion.h"
 
+#include "uinput_event_batch.h"
+
+#include <chrono>
+
 #include <linux/uinput.h>
 
 //====================================================================
@@ -39,12 +43,38 @@ class UinputKeyboard : public KeyboardEmulatorI
 		virtual void loadPrintableCharacters() override;
 		virtual void commandKey(SPKEYS k) override;
 
+		/*
+		 * In fast mode there is no sleep after each key, text is handed to
+		 * uinput in batches and the evdev queue keeps the order. When
+		 * @param keysPerSecond is not 0 keys are paced to that rate, for
+		 * targets that cannot absorb a burst.
+		 * */
+		void setFastMode(bool enable, uint keysPerSecond=0);
+
+		/*
+		 * Type @param keys keys in the current mode while a local evdev
+		 * reader grabs our own device and counts what arrives. The keys
+		 * do not reach any window. It returns false if some key was lost
+		 * or the device could not be read.
+		 * */
+		bool selfTest(uint keys, uint& received);
+
+		// direct access to the device, for raw event replay
+		UinputEventBatch& eventBatch();
+
 	private:
 		uinput_setup m_usetup={0};
-		input_event m_inputEvent={0};
 		int m_fd;
-
-		bool emit(int type, int code, int val);
+		UinputEventBatch m_batch;
+		std::chrono::steady_clock::duration m_keyPeriod;
+		std::chrono::steady_clock::time_point m_nextKey;
+		bool m_fastMode;
+		bool m_inSequence;
+
+		void emit(int type, int code, int val);
+		bool flush();
+		void keyDone();
+		int openEvdevReader();
 		void init(const char* deviceName);
 
 		virtual void sendKey(int keyCode) override;
@@ -53,6 +83,9 @@ class UinputKeyboard : public KeyboardEmulatorI
 
 		virtual void addWhiteCharacters() override;
 		virtual void prepareUnicodeInput() override;
+
+		virtual void beginSequence() override;
+		virtual void endSequence() override;
 };
 
 //--------------------------------------------------------------------
@@ -71,4 +104,40 @@ inline void UinputKeyboard::commandKey(SPKEYS k)
 
 //--------------------------------------------------------------------
 
+inline UinputEventBatch& UinputKeyboard::eventBatch()
+{
+	return m_batch;
+}
+
+//--------------------------------------------------------------------
+
+inline void UinputKeyboard::emit(int type, int code, int val)
+{
+	m_batch.add(type, code, val);
+}
+
+//--------------------------------------------------------------------
+
+inline bool UinputKeyboard::flush()
+{
+	return m_batch.flush();
+}
+
+//--------------------------------------------------------------------
+
+inline void UinputKeyboard::beginSequence()
+{
+	m_inSequence=m_fastMode;
+}
+
+//--------------------------------------------------------------------
+
+inline void UinputKeyboard::endSequence()
+{
+	m_inSequence=false;
+	flush();
+}
+
+//--------------------------------------------------------------------
+
 #endif
@@ -18,6 +18,8 @@
 
 #include "mouse_emulator.h"
 
+#include "uinput_event_batch.h"
+
 #include <linux/uinput.h>
 
 //====================================================================
@@ -29,13 +31,17 @@ class UinputMouse : public MouseEmulatorI
 		virtual ~UinputMouse();
 
 		virtual bool reload();
+
+		// direct access to the device, for raw event replay
+		UinputEventBatch& eventBatch();
 		
 	private:
 		uinput_setup m_usetup={0};
-		input_event m_inputEvent={0};
 		int m_fd;
+		UinputEventBatch m_batch;
 
-		bool emit(int type, int code, int val);
+		void emit(int type, int code, int val);
+		bool flush();
 		void init(const char* deviceName);
 
 		int getMouseButton(const MOUSE_BUTTONS btn);
@@ -47,6 +53,9 @@ class UinputMouse : public MouseEmulatorI
 
 		virtual void buttonDown(MOUSE_BUTTONS btn) override;
 		virtual void buttonUp(MOUSE_BUTTONS btn) override;
+		virtual void wheel(const int vertical, const int horizontal) override;
+
+		virtual void moveStep(const int dx, const int dy) override;
 };
 
 //--------------------------------------------------------------------
@@ -61,4 +70,25 @@ inline int UinputMouse::getMouseButton(const MOUSE_BUTTONS btn)
 
 //--------------------------------------------------------------------
 
+inline UinputEventBatch& UinputMouse::eventBatch()
+{
+	return m_batch;
+}
+
+//--------------------------------------------------------------------
+
+inline void UinputMouse::emit(int type, int code, int val)
+{
+	m_batch.add(type, code, val);
+}
+
+//--------------------------------------------------------------------
+
+inline bool UinputMouse::flush()
+{
+	return m_batch.flush();
+}
+
+//--------------------------------------------------------------------
+
 #endif
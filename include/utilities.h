@@ -13,10 +13,14 @@
 * std::string resourcePath(const char*);                             *
 * std::string getFilePath(const char*);                              *
 * std::string getImgPath(const char*);                               *
+* std::string uinputDeviceName(const char*);                         *
 * bool existPath(const char*)                                        *
 * const char* getTimeStamp(const char*)                              *
 * bool imageExists(const char*)                                      *
+* const char* imageExtension(ImageFormat)                            *
+* std::string setImageFormat(const std::string&, ImageFormat)        *
 * template<int B, typename Func> bool exeCommand(const char*, Func)  *
+* std::string mkScreenshotStrCmd(WindowId, const char*, const char*);  *
 * std::string mkScreenshotStrCmd(const char*, const char*, const char*);
 * std::string mkScreenshotStrCmd(const char*, const char*, bool manual);
 * bool takeScreenshot(const char*, const char*, const char*);        *
@@ -36,14 +40,28 @@
 #define UTILITIES_H
 
 #include "debug_utils.h"
+#include "enumerations.h"
 
 #include <cstring>
+#include <cstdint>
 #include <string>
 #include <functional>
 #include <memory>
 
 #define SEPARATOR "#+|+#"
 
+// used instead of ~/.wxHID, a directory of scripts, images and settings
+#define DATA_DIR_ENV "KMRP_DATA_DIR"
+
+// added to the names of the uinput devices, see uinputDeviceName
+#define DEVICE_TAG_ENV "KMRP_DEVICE_TAG"
+
+// the script played once when the application starts, it exits after it
+#define PLAY_ENV "KMRP_PLAY"
+
+// in the data directory
+#define SETTINGS_FILE ".save_settings.txt"
+
 //====================================================================
 
 bool cstrCompare(const char* str1, const char* str2);
@@ -52,8 +70,13 @@ int findStr(const char* needle, const char* stack, int offset=0);
 
 //====================================================================
 
+typedef uint32_t WindowId;
+
+// both look the window up through the WindowRegistry
 bool windowExists(const char* windowName);
 
+bool windowExists(WindowId windowId);
+
 //====================================================================
 
 struct WindowRect
@@ -88,6 +111,8 @@ struct WindowRect
 
 WindowRect getWindowRect(const char* windowName, bool visible);
 
+WindowRect getWindowRect(WindowId windowId, bool visible);
+
 std::string getWindowROI(const char* windowName);
 
 
@@ -95,6 +120,8 @@ std::string getWindowROI(const char* windowName);
 
 std::pair<int, int> getWindowCoord(const char* windowName, int x, int y, const char* position="Absolute");
 
+std::pair<int, int> getWindowCoord(WindowId windowId, int x, int y);
+
 //====================================================================
 
 inline std::pair<int, int> getWindowCoord(const char* windowName, const char* position="Absolute")
@@ -108,6 +135,7 @@ std::string resourcePath(const char* fileName);
 
 //====================================================================
 
+// under DATA_DIR_ENV if it is set
 std::string getFilePath(const char* file="");
 
 //====================================================================
@@ -116,6 +144,12 @@ std::string getImgPath(const char* file="");
 
 //====================================================================
 
+// "AutomaticTester <device>", or "AutomaticTester <tag> <device>" with
+// DEVICE_TAG_ENV set, so instances on other displays have their own
+std::string uinputDeviceName(const char* device);
+
+//====================================================================
+
 inline std::string getImgPath(const std::string& file)
 {
 	return getImgPath(file.c_str());
@@ -143,6 +177,12 @@ inline bool removeImage(const std::string& imageName)
 	return removeImage(imageName.c_str());
 }
 
+const char* imageExtension(ImageFormat format);
+
+// replace the extension of @param imageName by the one of @param format
+std::string setImageFormat(const std::string& imageName, ImageFormat format);
+
+
 //====================================================================
 
 template<int B, typename Func>
@@ -176,6 +216,16 @@ std string formattedString(const char* format, Args... args);
 int snprintf( char* buffer, std::size_t buf_size, const char* format, ... );
 // */
 
+// import gets the X id the WindowRegistry keeps for the window, so its
+// name never reaches the shell; only ROOT goes by name. The command is
+// empty if the window does not exist.
+std::string mkScreenshotStrCmd(WindowId windowId, const char* outputImage, const char* roiStr);
+
+inline std::string mkScreenshotStrCmd(WindowId windowId, const std::string& outputImage, const std::string& roiStr)
+{
+	return mkScreenshotStrCmd(windowId, outputImage.c_str(), roiStr.c_str());
+}
+
 std::string mkScreenshotStrCmd(const char* windowName, const char* outputImage, const char* roiStr);
 
 std::string mkScreenshotStrCmd(const char* windowName, const char* outputImage, bool manual=false);
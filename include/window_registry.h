@@ -0,0 +1,117 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class WindowRegistry                                               *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _WINDOW_REGISTRY_H
+#define _WINDOW_REGISTRY_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+typedef uint32_t WindowId;
+
+//====================================================================
+
+/*
+ * Every window name used by a command gets a small id once, the
+ * commands keep the id. The first lookup of a window finds it by
+ * name (xwininfo -name) and keeps its X id; after that the window
+ * is queried by that id, which needs no quoting and also tells
+ * whether the window is gone or was renamed, in which case it is
+ * looked up by name again. The geometry found is kept for a short
+ * while so the checks a command makes in a row cost one query;
+ * expire() drops it, the player calls it before every step.
+ * */
+class WindowRegistry final
+{
+	public:
+		enum : WindowId
+		{
+			ROOT=0,// the whole screen, never looked up
+		};
+
+		enum
+		{
+			GEOMETRY_TTL=100,// milliseconds
+		};
+
+		// as xwininfo reports it, the frame included
+		struct Geometry
+		{
+			int m_x;
+			int m_y;
+			int m_width;
+			int m_height;
+		};
+
+	public:
+		static WindowRegistry& getWindowRegistry()
+		{
+			static WindowRegistry registry;
+			return registry;
+		}
+
+		// "root" is ROOT, the same name always gets the same id
+		WindowId id(std::string_view windowName);
+
+		// valid as long as the application runs
+		const char* name(WindowId id) const;
+
+		bool exists(WindowId id);
+
+		// 0 for ROOT and for a window that does not exist
+		unsigned long xid(WindowId id);
+
+		// It returns false if the window does not exist.
+		bool geometry(WindowId id, Geometry& geometry);
+
+		// the next query of every window goes to the X server
+		void expire();
+
+		// names registered
+		size_t size() const;
+
+	private:
+		typedef std::chrono::steady_clock Clock;
+
+		struct Entry
+		{
+			std::string m_name;
+			unsigned long m_xid;
+			Geometry m_geometry;
+			Clock::time_point m_checked;
+			bool m_found;
+		};
+
+		mutable std::mutex m_mutex;
+		// a deque keeps the names in place as it grows
+		std::deque<Entry> m_entries;
+		std::unordered_map<std::string_view, WindowId> m_ids;
+
+		WindowRegistry();
+
+		bool refresh(WindowId id, Geometry& geometry);
+
+		WindowRegistry(const WindowRegistry&)=delete;
+		WindowRegistry& operator=(const WindowRegistry&)=delete;
+};
+
+//====================================================================
+
+#endif
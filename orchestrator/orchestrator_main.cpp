@@ -0,0 +1,106 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "playback_orchestrator.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//====================================================================
+
+static void usage(const char* program)
+{
+	std::printf("usage: %s --app command --script name --server command [--instances n]\n"
+				"          [--first-display n] [--data-dir dir] [--work-dir dir]\n"
+				"          [--setup command] [--setup-wait seconds] [--timeout seconds]\n"
+				"          [--without-input] [--json file]\n"
+				"{display} and {instance} are replaced in the server and setup commands.\n"
+				"--timeout is 1800 seconds unless given, 0 for no limit.\n"
+				"The server has to read the uinput devices of its player only, see README.\n", program);
+}
+
+//====================================================================
+
+int main(int argc, char** argv)
+{
+	OrchestratorConfig config;
+	const char* jsonFile=nullptr;
+
+	for(int i=1; i<argc; i++){
+		if(std::strcmp(argv[i], "--app")==0 && i+1<argc){
+			config.m_app=argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--script")==0 && i+1<argc){
+			config.m_script=argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--instances")==0 && i+1<argc){
+			config.m_instances=std::atoi(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--first-display")==0 && i+1<argc){
+			config.m_firstDisplay=std::atoi(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--data-dir")==0 && i+1<argc){
+			config.m_dataDir=argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--work-dir")==0 && i+1<argc){
+			config.m_workDir=argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--server")==0 && i+1<argc){
+			config.m_serverCommand=argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--setup")==0 && i+1<argc){
+			config.m_setupCommand=argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--setup-wait")==0 && i+1<argc){
+			config.m_setupWait=std::atoi(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--timeout")==0 && i+1<argc){
+			config.m_timeout=std::atoi(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--without-input")==0){
+			config.m_withoutInput=true;
+		}
+		else if(std::strcmp(argv[i], "--json")==0 && i+1<argc){
+			jsonFile=argv[++i];
+		}
+		else{
+			usage(argv[0]);
+			return 2;
+		}
+	}
+
+	if(config.m_app.empty() || config.m_script.empty() || config.m_serverCommand.empty()){
+		usage(argv[0]);
+		return 2;
+	}
+
+	PlaybackOrchestrator orchestrator(config);
+	bool ok=orchestrator.run();
+
+	std::fputs(orchestrator.summary().c_str(), stdout);
+	if(!ok){
+		std::printf("%s\n", orchestrator.getError().c_str());
+	}
+
+	if(jsonFile && !orchestrator.saveReport(jsonFile)){
+		std::printf("cannot write %s\n", jsonFile);
+		return 2;
+	}
+
+	if(!ok){
+		return 2;
+	}
+
+	return orchestrator.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,552 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* struct OrchestratorConfig                                          *
+* class PlaybackOrchestrator                                         *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "playback_orchestrator.h"
+#include "utilities.h"
+#include "json_string.h"
+#include "run_report.h"
+#include "script_journal.h"
+
+#include <cctype>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+//====================================================================
+
+namespace {
+
+// samples are taken by the player, each instance makes its own
+constexpr const char* SAMPLE_PREFIX="sample_";
+
+constexpr auto SERVER_WAIT=std::chrono::seconds(10);
+constexpr auto KILL_WAIT=std::chrono::seconds(2);
+constexpr auto POLL=std::chrono::milliseconds(100);
+
+volatile sig_atomic_t s_interrupted=0;
+
+//--------------------------------------------------------------------
+
+void onInterrupt(int)
+{
+	s_interrupted=1;
+}
+
+//--------------------------------------------------------------------
+
+// the program of @param command is Xvfb
+bool isXvfb(const std::string& command)
+{
+	size_t begin=command.find_first_not_of(" \t");
+	if(begin==std::string::npos){
+		return false;
+	}
+	size_t end=command.find_first_of(" \t", begin);
+	std::string program=command.substr(begin, end==std::string::npos ? std::string::npos : end-begin);
+	return std::filesystem::path(program).filename()=="Xvfb";
+}
+
+//--------------------------------------------------------------------
+
+void replaceAll(std::string& str, const std::string& from, const std::string& to)
+{
+	for(size_t pos=str.find(from); pos!=std::string::npos; pos=str.find(from, pos+to.size())){
+		str.replace(pos, from.size(), to);
+	}
+}
+
+//--------------------------------------------------------------------
+
+// @param env NAME=value pairs added to the environment
+// The command runs through the shell in a process group of its own, so
+// stopping it stops whatever it started. Its output goes to @param logPath.
+pid_t spawn(const std::string& command, const std::vector<std::string>& env, const std::string& logPath)
+{
+	pid_t pid=fork();
+	if(pid!=0){
+		if(pid>0){
+			// set on both sides, the parent may signal the group first
+			setpgid(pid, pid);
+		}
+		return pid;
+	}
+
+	setpgid(0, 0);
+
+	int log=open(logPath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+	if(log>=0){
+		dup2(log, STDOUT_FILENO);
+		dup2(log, STDERR_FILENO);
+		close(log);
+	}
+
+	int devNull=open("/dev/null", O_RDONLY);
+	if(devNull>=0){
+		dup2(devNull, STDIN_FILENO);
+		close(devNull);
+	}
+
+	for(const std::string& var : env){
+		putenv(const_cast<char*>(var.c_str()));
+	}
+
+	execl("/bin/sh", "sh", "-c", command.c_str(), static_cast<char*>(nullptr));
+	_exit(127);
+}
+
+//--------------------------------------------------------------------
+
+// SIGTERM to the group of @param pid, SIGKILL if it is still there after KILL_WAIT
+// It returns the wait status.
+int stopGroup(pid_t pid)
+{
+	int status=0;
+	if(pid<=0){
+		return status;
+	}
+
+	if(waitpid(pid, &status, WNOHANG)==pid){
+		// the leader is gone, what it started may be not
+		kill(-pid, SIGKILL);
+		return status;
+	}
+
+	kill(-pid, SIGTERM);
+	auto deadline=std::chrono::steady_clock::now()+KILL_WAIT;
+	while(std::chrono::steady_clock::now()<deadline){
+		if(waitpid(pid, &status, WNOHANG)==pid){
+			kill(-pid, SIGKILL);
+			return status;
+		}
+		std::this_thread::sleep_for(POLL);
+	}
+
+	kill(-pid, SIGKILL);
+	waitpid(pid, &status, 0);
+	return status;
+}
+
+//--------------------------------------------------------------------
+
+bool readFile(const std::string& filePath, std::string& content)
+{
+	std::ifstream file(filePath);
+	if(!file){
+		return false;
+	}
+
+	std::stringstream buffer;
+	buffer<<file.rdbuf();
+	content=buffer.str();
+	while(!content.empty() && std::isspace(static_cast<unsigned char>(content.back()))){
+		content.pop_back();
+	}
+	return !content.empty();
+}
+
+}
+
+//====================================================================
+
+PlaybackOrchestrator::PlaybackOrchestrator(const OrchestratorConfig& config)
+: m_config(config)
+{
+	if(m_config.m_dataDir.empty()){
+		const char* dataDir=getenv(DATA_DIR_ENV);
+		if(dataDir && std::strlen(dataDir)>0){
+			m_config.m_dataDir=dataDir;
+		}
+		else{
+			const char* home=getenv("HOME");
+			m_config.m_dataDir=std::string(home ? home : ".")+"/.wxHID";
+		}
+	}
+
+	if(m_config.m_workDir.empty()){
+		m_config.m_workDir="kmrp-orchestrator";
+	}
+}
+
+//--------------------------------------------------------------------
+
+PlaybackOrchestrator::~PlaybackOrchestrator()
+{
+	stop();
+}
+
+//--------------------------------------------------------------------
+
+std::string PlaybackOrchestrator::expand(const std::string& command, const Instance& instance) const
+{
+	std::string expanded=command;
+	replaceAll(expanded, "{display}", std::to_string(instance.m_display));
+	replaceAll(expanded, "{instance}", std::to_string(instance.m_number));
+	return expanded;
+}
+
+//--------------------------------------------------------------------
+
+bool PlaybackOrchestrator::prepare(Instance& instance)
+{
+	namespace fs=std::filesystem;
+	std::error_code ec;
+
+	fs::path source(m_config.m_dataDir);
+	fs::path target=fs::path(m_config.m_workDir)/("instance-"+std::to_string(instance.m_number));
+
+	// left by an earlier run, the report in it would be taken for this one
+	fs::remove_all(target, ec);
+	if(!fs::create_directories(target/"img", ec)){
+		m_error="cannot create "+target.string()+": "+ec.message();
+		return false;
+	}
+	instance.m_dataDir=fs::absolute(target, ec).string();
+
+	if(!fs::copy_file(source/m_config.m_script, target/m_config.m_script, ec)){
+		m_error="cannot copy "+(source/m_config.m_script).string()+": "+ec.message();
+		return false;
+	}
+
+	// the edits saved since the script was last written whole
+	std::string journal=ScriptJournal::logPath((source/m_config.m_script).string());
+	if(fs::exists(journal, ec)){
+		fs::copy_file(journal, ScriptJournal::logPath((target/m_config.m_script).string()), ec);
+	}
+
+	if(fs::exists(source/SETTINGS_FILE, ec)){
+		fs::copy_file(source/SETTINGS_FILE, target/SETTINGS_FILE, ec);
+	}
+
+	// the images are only read, links save copying them per instance
+	for(const fs::directory_entry& entry : fs::directory_iterator(source/"img", ec)){
+		std::string name=entry.path().filename().string();
+		if(!entry.is_regular_file(ec) || name.compare(0, std::strlen(SAMPLE_PREFIX), SAMPLE_PREFIX)==0){
+			continue;
+		}
+
+		fs::create_hard_link(entry.path(), target/"img"/name, ec);
+		if(ec){
+			// another file system
+			if(!fs::copy_file(entry.path(), target/"img"/name, ec)){
+				m_error="cannot copy "+entry.path().string()+": "+ec.message();
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+bool PlaybackOrchestrator::startServer(Instance& instance)
+{
+	std::string display=std::to_string(instance.m_display);
+	std::string socket="/tmp/.X11-unix/X"+display;
+
+	std::error_code ec;
+	if(std::filesystem::exists(socket, ec) || std::filesystem::exists("/tmp/.X"+display+"-lock", ec)){
+		m_error="display :"+display+" is in use";
+		return false;
+	}
+
+	instance.m_server=spawn(expand(m_config.m_serverCommand, instance), {}, instance.m_dataDir+"/server.log");
+	if(instance.m_server<0){
+		m_error="cannot start the server of display :"+display;
+		return false;
+	}
+
+	auto deadline=std::chrono::steady_clock::now()+SERVER_WAIT;
+	while(!std::filesystem::exists(socket, ec)){
+		int status;
+		if(waitpid(instance.m_server, &status, WNOHANG)==instance.m_server){
+			instance.m_server=0;
+			m_error="the server of display :"+display+" exited, see "+instance.m_dataDir+"/server.log";
+			return false;
+		}
+
+		if(std::chrono::steady_clock::now()>deadline || s_interrupted){
+			m_error="display :"+display+" did not come up";
+			return false;
+		}
+		std::this_thread::sleep_for(POLL);
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+bool PlaybackOrchestrator::startPlayer(Instance& instance)
+{
+	std::string display="DISPLAY=:"+std::to_string(instance.m_display);
+
+	std::vector<std::string> env{
+		display,
+		std::string(DATA_DIR_ENV)+"="+instance.m_dataDir,
+		std::string(DEVICE_TAG_ENV)+"="+std::to_string(instance.m_display),
+		std::string(PLAY_ENV)+"="+m_config.m_script,
+	};
+
+	instance.m_player=spawn("exec "+m_config.m_app, env, instance.m_dataDir+"/player.log");
+	if(instance.m_player<0){
+		m_error="cannot start the player on display :"+std::to_string(instance.m_display);
+		return false;
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+bool PlaybackOrchestrator::run()
+{
+	m_instances.clear();
+	m_error.clear();
+
+	if(m_config.m_app.empty() || m_config.m_script.empty() || m_config.m_instances==0){
+		m_error="an application, a script and at least one instance are needed";
+		return false;
+	}
+
+	if(m_config.m_serverCommand.empty()){
+		m_error="a display server command is needed";
+		return false;
+	}
+
+	// Xvfb has its own virtual devices, the input of the players would
+	// go nowhere
+	if(!m_config.m_withoutInput && isXvfb(m_config.m_serverCommand)){
+		m_error="Xvfb does not read the uinput devices of the players, use a server that does"
+				" (Xorg with the dummy driver) or --without-input if the script has no input commands";
+		return false;
+	}
+
+	s_interrupted=0;
+	signal(SIGINT, onInterrupt);
+	signal(SIGTERM, onInterrupt);
+
+	for(uint i=0; i<m_config.m_instances; i++){
+		m_instances.push_back({i+1, m_config.m_firstDisplay+i, "", 0, 0, 0, 0, false, 0});
+	}
+
+	bool ok=true;
+	for(Instance& instance : m_instances){
+		if(!prepare(instance) || !startServer(instance)){
+			ok=false;
+			break;
+		}
+	}
+
+	if(ok && !m_config.m_setupCommand.empty()){
+		for(Instance& instance : m_instances){
+			std::string display="DISPLAY=:"+std::to_string(instance.m_display);
+			instance.m_setup=spawn(expand(m_config.m_setupCommand, instance), {display}, instance.m_dataDir+"/setup.log");
+			if(instance.m_setup<0){
+				m_error="cannot run the setup command on display :"+std::to_string(instance.m_display);
+				ok=false;
+				break;
+			}
+		}
+
+		// the windows of the application under test are looked for as
+		// the script starts
+		if(ok){
+			std::this_thread::sleep_for(std::chrono::seconds(m_config.m_setupWait));
+		}
+	}
+
+	for(Instance& instance : m_instances){
+		if(!ok || !startPlayer(instance)){
+			ok=false;
+			break;
+		}
+	}
+
+	if(ok){
+		waitPlayers();
+	}
+
+	stop();
+
+	signal(SIGINT, SIG_DFL);
+	signal(SIGTERM, SIG_DFL);
+
+	if(ok && s_interrupted){
+		m_error="interrupted";
+		return false;
+	}
+
+	return ok;
+}
+
+//--------------------------------------------------------------------
+
+void PlaybackOrchestrator::waitPlayers()
+{
+	using Clock=std::chrono::steady_clock;
+
+	Clock::time_point start=Clock::now();
+	size_t running=m_instances.size();
+
+	while(running>0 && !s_interrupted){
+		std::this_thread::sleep_for(POLL);
+		double seconds=std::chrono::duration<double>(Clock::now()-start).count();
+
+		for(Instance& instance : m_instances){
+			if(instance.m_player<=0){
+				continue;
+			}
+
+			int status;
+			if(waitpid(instance.m_player, &status, WNOHANG)==instance.m_player){
+				instance.m_exitCode=WIFEXITED(status) ? WEXITSTATUS(status) : -WTERMSIG(status);
+			}
+			else if(m_config.m_timeout>0 && seconds>m_config.m_timeout){
+				instance.m_timedOut=true;
+				stopGroup(instance.m_player);
+			}
+			else{
+				continue;
+			}
+
+			instance.m_player=0;
+			instance.m_seconds=seconds;
+			running--;
+		}
+	}
+}
+
+//--------------------------------------------------------------------
+
+void PlaybackOrchestrator::stop()
+{
+	for(Instance& instance : m_instances){
+		if(instance.m_player>0){
+			stopGroup(instance.m_player);
+			instance.m_player=0;
+			instance.m_timedOut=true;
+		}
+		stopGroup(instance.m_setup);
+		instance.m_setup=0;
+		stopGroup(instance.m_server);
+		instance.m_server=0;
+	}
+}
+
+//--------------------------------------------------------------------
+
+const char* PlaybackOrchestrator::status(const Instance& instance) const
+{
+	if(instance.m_timedOut){
+		return "timeout";
+	}
+
+	if(instance.m_seconds==0){
+		return "not started";
+	}
+
+	if(instance.m_exitCode<0){
+		return "crashed";
+	}
+
+	return instance.m_exitCode==0 ? "passed" : "failed";
+}
+
+//--------------------------------------------------------------------
+
+bool PlaybackOrchestrator::allPassed() const
+{
+	if(m_instances.empty()){
+		return false;
+	}
+
+	for(const Instance& instance : m_instances){
+		if(std::strcmp(status(instance), "passed")!=0){
+			return false;
+		}
+	}
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+bool PlaybackOrchestrator::saveReport(const std::string& filePath) const
+{
+	FILE* file=std::fopen(filePath.c_str(), "w");
+	if(file==nullptr){
+		return false;
+	}
+
+	uint passed=0;
+	std::fputs("{\n\"script\":", file);
+	writeJsonString(file, m_config.m_script);
+	std::fputs(",\n\"instances\":[", file);
+
+	for(size_t i=0; i<m_instances.size(); i++){
+		const Instance& instance=m_instances[i];
+		const char* state=status(instance);
+		if(std::strcmp(state, "passed")==0){
+			passed++;
+		}
+
+		std::fprintf(file, "%s\n{\"instance\":%u,\"display\":%u,\"exit_code\":%i,\"status\":\"%s\",\"seconds\":%.3f,\"data_dir\":",
+					i>0 ? "," : "", instance.m_number, instance.m_display, instance.m_exitCode, state, instance.m_seconds);
+		writeJsonString(file, instance.m_dataDir);
+
+		// the run report of the player as it wrote it
+		std::string report;
+		std::fputs(",\"report\":", file);
+		if(!instance.m_dataDir.empty() && readFile(instance.m_dataDir+"/."+m_config.m_script+REPORT_EXT+".json", report)){
+			std::fputs(report.c_str(), file);
+		}
+		else{
+			std::fputs("null", file);
+		}
+		std::fputc('}', file);
+	}
+
+	std::fprintf(file, "\n],\n\"passed\":%u,\n\"failed\":%zu\n}\n", passed, m_instances.size()-passed);
+
+	return std::fclose(file)==0;
+}
+
+//--------------------------------------------------------------------
+
+std::string PlaybackOrchestrator::summary() const
+{
+	std::string summary;
+	char line[256];
+	for(const Instance& instance : m_instances){
+		std::snprintf(line, sizeof(line), "instance %u  :%u  %-12s exit %i  %.1fs  %s\n",
+					instance.m_number, instance.m_display, status(instance), instance.m_exitCode,
+					instance.m_seconds, instance.m_dataDir.c_str());
+		summary.append(line);
+	}
+	return summary;
+}
+
+//====================================================================
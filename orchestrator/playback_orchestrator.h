@@ -0,0 +1,129 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* struct OrchestratorConfig                                          *
+* class PlaybackOrchestrator                                         *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _PLAYBACK_ORCHESTRATOR_H
+#define _PLAYBACK_ORCHESTRATOR_H
+
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+//====================================================================
+
+/*
+ * In the commands {display} is replaced by the display number and
+ * {instance} by the number of the instance, from 1.
+ * */
+struct OrchestratorConfig
+{
+	// the player, run with KMRP_PLAY
+	std::string m_app;
+	// name of the script in m_dataDir
+	std::string m_script;
+	// scripts, images and settings as the player keeps them
+	std::string m_dataDir;
+	// a directory per instance is made here
+	std::string m_workDir;
+	// starts the display server of an instance, it has to take the
+	// input of the uinput devices of its player and no others
+	std::string m_serverCommand;
+	// run on the display before the player, for instance the
+	// application under test; empty for none
+	std::string m_setupCommand;
+	// seconds the setup command is given before the player starts
+	uint m_setupWait{2};
+	uint m_instances{1};
+	uint m_firstDisplay{100};
+	// seconds given to a player, 0 for no limit; half an hour unless
+	// told, so a player stuck on a window that never comes is stopped
+	uint m_timeout{1800};
+	// the script has no input commands, so a server that does not
+	// read input devices (Xvfb) will do
+	bool m_withoutInput{false};
+};
+
+//====================================================================
+
+/*
+ * Play the same script on several displays at once, one player
+ * process per display. Every instance has its own display server,
+ * its own data directory (the script, the settings and hard links to
+ * the images, so the samples the player takes do not clash) and its
+ * own uinput devices, tagged with the display number through
+ * KMRP_DEVICE_TAG ("AutomaticTester 101 keyboard").
+ * The exit codes of the players and their run reports are gathered
+ * into one report.
+ * */
+class PlaybackOrchestrator
+{
+	public:
+		PlaybackOrchestrator(const OrchestratorConfig& config);
+
+		// stops whatever is still running
+		~PlaybackOrchestrator();
+
+		// It returns false if the instances cannot be set up, the outcome
+		// of the players is in the report.
+		bool run();
+
+		bool allPassed() const;
+
+		// the instances and the run report of each of them, as JSON
+		bool saveReport(const std::string& filePath) const;
+
+		// one line per instance
+		std::string summary() const;
+
+		const std::string& getError() const
+		{
+			return m_error;
+		}
+
+	private:
+		struct Instance
+		{
+			uint m_number;
+			uint m_display;
+			std::string m_dataDir;
+			pid_t m_server;
+			pid_t m_setup;
+			pid_t m_player;
+			int m_exitCode;
+			bool m_timedOut;
+			double m_seconds;
+		};
+
+		OrchestratorConfig m_config;
+		std::vector<Instance> m_instances;
+		std::string m_error;
+
+		std::string expand(const std::string& command, const Instance& instance) const;
+		bool prepare(Instance& instance);
+		bool startServer(Instance& instance);
+		bool startPlayer(Instance& instance);
+		void waitPlayers();
+		void stop();
+
+		const char* status(const Instance& instance) const;
+
+		PlaybackOrchestrator(const PlaybackOrchestrator&)=delete;
+		PlaybackOrchestrator& operator=(const PlaybackOrchestrator&)=delete;
+};
+
+//====================================================================
+
+#endif
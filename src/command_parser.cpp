@@ -9,7 +9,7 @@
 * 
 * template<CommandTypes CT> struct CmdType2Bdr                       *
 * template<CommandTypes CMDT> struct CmdBuilder                      *
-* BaseCommand* ParserBuilder(const std::string& line);               *
+* BaseCommand* ParserBuilder(std::string_view, std::string*, bool);  *
 *         	                                                         *
 * Version: 1.0                                                       *
 * Date:    09-02-2025                                                *
@@ -17,7 +17,7 @@
 **********************************************************************/
 #include "command_parser.h"
 #include "utilities.h"
-#include "cstr_split.h"
+#include "field_split.h"
 
 //====================================================================
 
@@ -41,85 +41,115 @@ namespace CTRL_INDEX
 
 //====================================================================
 
-BaseCommand* ParserBuilder(const std::string& line)
+BaseCommand* ParserBuilder(std::string_view line, std::string* error, bool checkImage)
 {
-	CstrSplit<20> parts(line.c_str(), SEPARATOR);
+	FieldSplit<20> parts(line, SEPARATOR);
 	const int last=parts.dataSize()-1;
 
-	auto toBool=[](const char* b){
-		return memcmp("true", b, 4)==0;
-	};
-
 	BaseCommand* commandPtr=nullptr;	
-	CommandTypes commandID=static_cast<CommandTypes>(std::atoi(parts[0]));
+	CommandTypes commandID=static_cast<CommandTypes>(parts.number<int>(0));
 
-	const char* description=parts[1];
-	bool run=toBool(parts[2]);
+	std::string description=parts.str(1);
+	bool run=parts.toBool(2);
 
 	if(CommandTypes::Ctrl==commandID || CommandTypes::Screenshot==commandID){
-		bool similarity=toBool(parts[CTRL_INDEX::SIMILARITY]);
+		bool similarity=parts.toBool(CTRL_INDEX::SIMILARITY);
 
 		CtrlCommand* tmpPtr=nullptr;
 		if(CommandTypes::Ctrl==commandID){
-			tmpPtr=new CtrlCommand(description, parts[CTRL_INDEX::BASE_IMAGE], parts[CTRL_INDEX::ROI_STR], parts[CTRL_INDEX::WINDOW_NAME], false);
+			tmpPtr=new CtrlCommand(description.c_str(), parts.str(CTRL_INDEX::BASE_IMAGE), parts.str(CTRL_INDEX::ROI_STR).c_str(), parts.str(CTRL_INDEX::WINDOW_NAME).c_str(), checkImage);
 		}
 
 		tmpPtr->setSimilarity(similarity);
 		tmpPtr->updateActive(run);
-		tmpPtr->setThreshold(std::atoi(parts[CTRL_INDEX::THRESHOLD]));
-		tmpPtr->setSensitivity(std::atoi(parts[CTRL_INDEX::SENSITIVITY]));
-		tmpPtr->setRestriction(toBool(parts[CTRL_INDEX::STRICT_RUN]));
-		tmpPtr->updateTime(std::atoi(parts[CTRL_INDEX::TIMEOUT]));
+		tmpPtr->setThreshold(parts.number<int>(CTRL_INDEX::THRESHOLD));
+		tmpPtr->setSensitivity(parts.number<int>(CTRL_INDEX::SENSITIVITY));
+		tmpPtr->setRestriction(parts.toBool(CTRL_INDEX::STRICT_RUN));
+		tmpPtr->updateTime(parts.number<int>(CTRL_INDEX::TIMEOUT));
 		commandPtr=tmpPtr;
 	}
 	else{
 		/*Input command
 		 command ID ,  m_description, m_run, (params...), CMD_ID, m_wait
 		*/
-		const int wait=std::atoi(parts[last]);
+		const int wait=parts.number<int>(last);
+		// field of the motion profile of mouse commands, older scripts do not have it
+		int motionIndex=0;
 		switch(commandID)
 		{
 			case CommandTypes::Keyboard:
-				commandPtr=CmdBuilder<CommandTypes::Keyboard>::Builder(run, description, wait, std::atoi(parts[3]));
+				commandPtr=CmdBuilder<CommandTypes::Keyboard>::Builder(run, description.c_str(), wait, parts.number<int>(3));
 				break;
 			case CommandTypes::KeyboardLine:
-				commandPtr=CmdBuilder<CommandTypes::KeyboardLine>::Builder(run, description, wait, std::string(parts[3], parts.chunkSize(3)));
+				commandPtr=CmdBuilder<CommandTypes::KeyboardLine>::Builder(run, description.c_str(), wait, parts.str(3));
 				break;
 			case CommandTypes::KeyboardText:
-				commandPtr=CmdBuilder<CommandTypes::KeyboardText>::Builder(run, description, wait, std::string(parts[3], parts.chunkSize(3)));
+				commandPtr=CmdBuilder<CommandTypes::KeyboardText>::Builder(run, description.c_str(), wait, parts.str(3));
 				break;
 			case CommandTypes::MouseMove:
-				commandPtr=CmdBuilder<CommandTypes::MouseMove>::Builder(run, description, wait, std::atoi(parts[3]), std::atoi(parts[4]), parts[5]);
+				{
+					// travel time, scripts saved before it was recorded do not have it
+					uint duration=(last>6) ? parts.number<int>(6) : 0;
+					commandPtr=CmdBuilder<CommandTypes::MouseMove>::Builder(run, description.c_str(), wait, parts.number<int>(3), parts.number<int>(4), parts.str(5).c_str(), duration);
+					motionIndex=7;
+				}
 				break;
 			case CommandTypes::MouseLeftBtn:
-				commandPtr=CmdBuilder<CommandTypes::MouseLeftBtn>::Builder(run, description, wait, std::atoi(parts[3]), std::atoi(parts[4]), parts[5]);
+				commandPtr=CmdBuilder<CommandTypes::MouseLeftBtn>::Builder(run, description.c_str(), wait, parts.number<int>(3), parts.number<int>(4), parts.str(5).c_str());
+				motionIndex=6;
 				break;
 			case CommandTypes::MouseRightBtn:
-				commandPtr=CmdBuilder<CommandTypes::MouseRightBtn>::Builder(run, description, wait, std::atoi(parts[3]), std::atoi(parts[4]), parts[5]);
+				commandPtr=CmdBuilder<CommandTypes::MouseRightBtn>::Builder(run, description.c_str(), wait, parts.number<int>(3), parts.number<int>(4), parts.str(5).c_str());
+				motionIndex=6;
 				break;
 			case CommandTypes::MouseSelection:
-				commandPtr=CmdBuilder<CommandTypes::MouseSelection>::Builder(run, description, wait, std::atoi(parts[3]), std::atoi(parts[4]), std::atoi(parts[5]), std::atoi(parts[6]), parts[7]);
+				commandPtr=CmdBuilder<CommandTypes::MouseSelection>::Builder(run, description.c_str(), wait, parts.number<int>(3), parts.number<int>(4), parts.number<int>(5), parts.number<int>(6), parts.str(7).c_str());
+				motionIndex=8;
 				break;
 			case CommandTypes::MouseDrag:
 				{
-					if(std::atoi(parts[3])<0){
-						commandPtr=CmdBuilder<CommandTypes::MouseDrag>::Builder(run, description, wait, std::atoi(parts[5]), std::atoi(parts[6]), parts[7]);
+					motionIndex=9;
+					if(parts.number<int>(3)<0){
+						commandPtr=CmdBuilder<CommandTypes::MouseDrag>::Builder(run, description.c_str(), wait, parts.number<int>(5), parts.number<int>(6), parts.str(7).c_str());
 					}
 					else{
-						commandPtr=CmdBuilder<CommandTypes::MouseDrag>::Builder(run, description, wait, std::atoi(parts[3]), std::atoi(parts[4]), std::atoi(parts[5]), std::atoi(parts[6]), parts[7]);
+						uint duration=(last>8) ? parts.number<int>(8) : 0;
+						commandPtr=CmdBuilder<CommandTypes::MouseDrag>::Builder(run, description.c_str(), wait, parts.number<int>(3), parts.number<int>(4), parts.number<int>(5), parts.number<int>(6), parts.str(7).c_str(), duration);
 					}
 				}
 				break;
 			case CommandTypes::Shortcut:
-				commandPtr=CmdBuilder<CommandTypes::Shortcut>::Builder(run, description, wait, parts[3]);
+				commandPtr=CmdBuilder<CommandTypes::Shortcut>::Builder(run, description.c_str(), wait, parts.str(3));
 				break;
 			case CommandTypes::Unicode:
-				commandPtr=CmdBuilder<CommandTypes::Unicode>::Builder(run, description, wait, parts[3]);
+				commandPtr=CmdBuilder<CommandTypes::Unicode>::Builder(run, description.c_str(), wait, parts.str(3));
+				break;
+			case CommandTypes::RawEvents:
+				commandPtr=CmdBuilder<CommandTypes::RawEvents>::Builder(run, description.c_str(), wait, parts.str(3));
+				break;
+			case CommandTypes::MouseScroll:
+				commandPtr=CmdBuilder<CommandTypes::MouseScroll>::Builder(run, description.c_str(), wait, parts.number<int>(3), parts.number<int>(4), parts.str(5).c_str(), parts.number<int>(6), parts.number<int>(7));
+				motionIndex=8;
 				break;
 			default:
 				dbg("Command builder not found");
 				break;
 		};
+
+		if(motionIndex>0 && last>motionIndex){
+			MouseMotion* motionPtr=dynamic_cast<MouseMotion*>(commandPtr);
+			if(motionPtr){
+				motionPtr->setMotion(MotionSpec::parse(parts[motionIndex]));
+			}
+		}
+	}
+
+	if(!parts.ok()){
+		if(error){
+			*error=parts.errorMessage();
+		}
+		delete commandPtr;
+		commandPtr=nullptr;
 	}
 
 	return commandPtr;
@@ -0,0 +1,101 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class CommandPool                                                  *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "command_pool.h"
+
+#include <new>
+
+//====================================================================
+
+CommandPool::CommandPool()
+: m_freeLists{}
+, m_slabTop(nullptr)
+, m_slabEnd(nullptr)
+, m_inUse(0)
+{
+}
+
+//--------------------------------------------------------------------
+
+void* CommandPool::allocate(size_t size)
+{
+	if(size==0 || size>MAX_SIZE){
+		return ::operator new(size);
+	}
+
+	size_t sizeClass=(size-1)/ALIGNMENT;
+	size=(sizeClass+1)*ALIGNMENT;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_inUse++;
+
+	FreeBlock* block=m_freeLists[sizeClass];
+	if(block){
+		m_freeLists[sizeClass]=block->m_next;
+		return block;
+	}
+
+	if(m_slabTop==nullptr || size_t(m_slabEnd-m_slabTop)<size){
+		// the tail of the last slab is too small for this size, it is lost
+		m_slabTop=static_cast<char*>(::operator new(SLAB_SIZE));
+		m_slabEnd=m_slabTop+SLAB_SIZE;
+		m_slabs.push_back(m_slabTop);
+	}
+
+	void* ptr=m_slabTop;
+	m_slabTop+=size;
+	return ptr;
+}
+
+//--------------------------------------------------------------------
+
+void CommandPool::deallocate(void* ptr, size_t size)
+{
+	if(ptr==nullptr){
+		return;
+	}
+
+	if(size==0 || size>MAX_SIZE){
+		::operator delete(ptr);
+		return;
+	}
+
+	size_t sizeClass=(size-1)/ALIGNMENT;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_inUse--;
+
+	FreeBlock* block=static_cast<FreeBlock*>(ptr);
+	block->m_next=m_freeLists[sizeClass];
+	m_freeLists[sizeClass]=block;
+}
+
+//--------------------------------------------------------------------
+
+size_t CommandPool::inUse() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_inUse;
+}
+
+//--------------------------------------------------------------------
+
+size_t CommandPool::reserved() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_slabs.size()*SLAB_SIZE;
+}
+
+//====================================================================
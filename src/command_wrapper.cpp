@@ -29,6 +29,16 @@ extern wxIntegerValidator<unsigned int> s_integerValidator;
 
 //====================================================================
 
+void BasePanel::notifyChange()
+{
+	// processed right away, the panel might be gone by the time a posted event arrives
+	wxCommandEvent event(wxEVT_CUSTOM_EVENT, EvtID::PANEL_CHANGED);
+	event.SetEventObject(this);
+	ProcessWindowEvent(event);
+}
+
+//====================================================================
+
 LoopPanel::LoopPanel(wxWindow* parent, uint posY, uint width, int times)
 :BaseWrapperPanel<BasePanel>(parent, posY, width)
 {
@@ -43,6 +53,7 @@ LoopPanel::LoopPanel(wxWindow* parent, uint posY, uint width, int times)
 
 	m_loopInput->setCallback([this](const char* val){
 		m_times=wxAtoi(val);
+		notifyChange();
 	});
 
 	wxBoxSizer* row=new wxBoxSizer(wxHORIZONTAL);
@@ -118,6 +129,7 @@ void CommandPanel::init(bool indentation)
 
 	m_description->setCallback([this](const char* val){		
 		m_baseCommandPtr->updateDescription(val);
+		notifyChange();
 	});
 
 	setTimeoutCtrl();
@@ -152,6 +164,7 @@ void CommandPanel::init(bool indentation)
 void CommandPanel::enableCommand(bool enable)
 {
 	m_baseCommandPtr->updateActive(enable);
+	notifyChange();
 	m_enableCmdCheck->SetValue(enable);
 	if(enable){
 		m_description->Enable();
@@ -225,6 +238,7 @@ void InputCommandWrapper::setTimeoutCtrl()
 
 	m_timeoutInput->setCallback([this](const char* val){
 		m_baseCommandPtr->updateTime(std::atof(val)*1000);
+		notifyChange();
 	});
 
 	m_timeoutInput->Bind(wxEVT_TEXT, [this](wxCommandEvent& event) {
@@ -302,6 +316,7 @@ void ControlCommandWrapper::setTimeoutCtrl()
 
 	m_timeoutInput->setCallback([this](const char* val){
 		m_baseCommandPtr->updateTime(std::atoi(val));
+		notifyChange();
 	});
 
 	m_timeoutInput->Bind(wxEVT_TEXT, [this](wxCommandEvent& event) {
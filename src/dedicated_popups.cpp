@@ -147,14 +147,9 @@ void AddCmdPopup::layout()
 
 void AddCmdPopup::removeImg()
 {
-	if(m_imgName.length()>0){
-		std::error_code ec;
-		std::filesystem::path imgPath{getImgPath(m_imgName)};
-		if(std::filesystem::exists(imgPath, ec)){
-			std::filesystem::remove(imgPath);
-			m_imgName="";
-		}
-	}
+	// the image may be shared with other commands, so it is left to
+	// ImageStore::collectGarbage
+	m_imgName="";
 }
 
 //--------------------------------------------------------------------
@@ -0,0 +1,264 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* struct RawInputEvent                                               *
+* class EvdevRecorder                                                *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "evdev_recorder.h"
+#include "debug_utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+
+// prefix of the uinput devices created by this application
+#define OWN_DEVICE_PREFIX "AutomaticTester"
+
+#define READ_CHUNK 64
+
+//====================================================================
+
+EvdevRecorder::EvdevRecorder()
+: m_kernelDrops(0)
+, m_running(false)
+, m_stopRequested(false)
+, m_wakePipe{-1, -1}
+{}
+
+//--------------------------------------------------------------------
+
+EvdevRecorder::~EvdevRecorder()
+{
+	stop();
+}
+
+//--------------------------------------------------------------------
+
+bool EvdevRecorder::openDevices()
+{
+	std::error_code ec;
+	std::filesystem::directory_iterator dirIterator("/dev/input", ec);
+	if(ec.value()!=0){
+		return false;
+	}
+
+	char name[256];
+	unsigned long evTypes=0;
+	int clockId=CLOCK_MONOTONIC;
+	for(auto& dirEntry : dirIterator){
+		if(dirEntry.path().filename().string().rfind("event", 0)!=0){
+			continue;
+		}
+
+		int fd=open(dirEntry.path().c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+		if(fd<0){
+			continue;
+		}
+
+		std::memset(name, 0, sizeof(name));
+		ioctl(fd, EVIOCGNAME(sizeof(name)-1), name);
+		evTypes=0;
+		ioctl(fd, EVIOCGBIT(0, sizeof(evTypes)), &evTypes);
+
+		bool isInput=(evTypes & (1UL<<EV_KEY)) || (evTypes & (1UL<<EV_REL));
+		if(!isInput || std::strncmp(name, OWN_DEVICE_PREFIX, std::strlen(OWN_DEVICE_PREFIX))==0){
+			close(fd);
+			continue;
+		}
+
+		// timestamps of all devices on the same clock as std::chrono::steady_clock
+		ioctl(fd, EVIOCSCLOCKID, &clockId);
+		
+		dbg("recording from: ", name);
+		m_fds.push_back(fd);
+	}
+
+	return m_fds.size()>0;
+}
+
+//--------------------------------------------------------------------
+
+void EvdevRecorder::closeDevices()
+{
+	for(int fd : m_fds){
+		close(fd);
+	}
+	m_fds.clear();
+}
+
+//--------------------------------------------------------------------
+
+bool EvdevRecorder::start()
+{
+	if(isRunning()){
+		return true;
+	}
+
+	m_buffer.clear();
+	m_kernelDrops.store(0, std::memory_order_relaxed);
+	m_stopRequested.store(false, std::memory_order_relaxed);
+
+	if(!openDevices()){
+		dbg("no input device can be read, check permissions on /dev/input");
+		return false;
+	}
+
+	if(pipe2(m_wakePipe, O_CLOEXEC | O_NONBLOCK)<0){
+		closeDevices();
+		return false;
+	}
+
+	m_running.store(true, std::memory_order_release);
+	m_thread=std::thread(&EvdevRecorder::run, this);
+
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+void EvdevRecorder::stop()
+{
+	if(m_thread.joinable()){
+		m_running.store(false, std::memory_order_release);
+		char c=0;
+		if(write(m_wakePipe[1], &c, 1)<0){
+			dbg("wake pipe: ", std::strerror(errno));
+		}
+		m_thread.join();
+	}
+
+	for(int& fd : m_wakePipe){
+		if(fd>=0){
+			close(fd);
+			fd=-1;
+		}
+	}
+
+	closeDevices();
+}
+
+//--------------------------------------------------------------------
+
+void EvdevRecorder::run()
+{
+	std::vector<pollfd> pollFds;
+	pollFds.push_back({m_wakePipe[0], POLLIN, 0});
+	for(int fd : m_fds){
+		pollFds.push_back({fd, POLLIN, 0});
+	}
+
+	while(m_running.load(std::memory_order_acquire)){
+		if(m_buffer.freeSlots()<READ_CHUNK){
+			// the consumer is behind, the events wait in the kernel queues
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		}
+
+		if(poll(pollFds.data(), pollFds.size(), -1)<0){
+			if(errno==EINTR){
+				continue;
+			}
+			break;
+		}
+
+		if(pollFds[0].revents!=0){
+			break;
+		}
+
+		for(size_t i=1; i<pollFds.size(); i++){
+			if(pollFds[i].revents & POLLIN){
+				// a device not read now is still readable on the next poll
+				if(m_buffer.freeSlots()<READ_CHUNK){
+					break;
+				}
+				readDevice(pollFds[i].fd);
+			}
+			else if(pollFds[i].revents & (POLLERR | POLLHUP)){
+				// device unplugged
+				pollFds[i].fd=-1;
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------------
+
+bool EvdevRecorder::readDevice(int fd)
+{
+	// only as many as fit, the rest waits in the kernel queue
+	input_event events[READ_CHUNK];
+	size_t room=std::min<size_t>(READ_CHUNK, m_buffer.freeSlots());
+	if(room==0){
+		return false;
+	}
+	ssize_t len=read(fd, events, room*sizeof(input_event));
+	if(len<static_cast<ssize_t>(sizeof(input_event))){
+		return false;
+	}
+
+	size_t total=len/sizeof(input_event);
+	RawInputEvent rawEvent;
+	for(size_t i=0; i<total; i++){
+		const input_event& event=events[i];
+		if(event.type==EV_SYN && event.code==SYN_DROPPED){
+			m_kernelDrops.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if(event.type==EV_KEY && event.code==KEY_PAUSE){
+			if(event.value==1){
+				m_stopRequested.store(true, std::memory_order_release);
+			}
+			continue;
+		}
+
+		if(event.type==EV_MSC || event.type==EV_LED){
+			continue;
+		}
+
+		rawEvent.m_time=int64_t(event.input_event_sec)*1000000+event.input_event_usec;
+		rawEvent.m_type=event.type;
+		rawEvent.m_code=event.code;
+		rawEvent.m_value=event.value;
+
+		// room was checked before the read, the consumer only makes more
+		if(!m_buffer.push(rawEvent)){
+			debugWarning("recorder buffer full, event lost");
+		}
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+size_t EvdevRecorder::drain(std::vector<RawInputEvent>& events)
+{
+	size_t count=0;
+	RawInputEvent rawEvent;
+	while(m_buffer.pop(rawEvent)){
+		events.push_back(rawEvent);
+		count++;
+	}
+
+	return count;
+}
+
+//====================================================================
@@ -18,24 +18,35 @@
 #include "event_definitions.h"
 #include "command_wrapper.h"
 #include "input_command.h"
-#include "command_parser.h"
 #include "enumerations.h"
-#include "cstr_split.h"
+#include "script_loader.h"
 
 #include <wx/sizer.h>
 #include <wx/panel.h>
 #include <wx/valnum.h>
 
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+
 //====================================================================
 
 ExtScrolledWindow::ExtScrolledWindow(wxWindow* parent, int Id, wxPoint Point, wxSize wSize)
 :wxScrolledWindow(parent, Id, Point, wSize)
+, m_pendingIdx(0)
+, m_loadedHash(0)
+, m_loadedLogBytes(0)
+, m_loadedLines(0)
 , m_previousPanel(nullptr)
 , m_width(wSize.GetWidth())
 , m_height(0)
 , m_loopStartAt(0)
 , m_commandCount(0)
+, m_loopIteration(0)
 , m_init(false)
+, m_loading(false)
+, m_pendingIndentation(false)
+, m_deferScroll(false)
 {
 	SetBackgroundColour(wxColour("#FFFFFF"));
 }
@@ -44,6 +55,7 @@ ExtScrolledWindow::ExtScrolledWindow(wxWindow* parent, int Id, wxPoint Point, wx
 
 ExtScrolledWindow::~ExtScrolledWindow()
 {
+	dropPendingEntries();
 	for(BasePanel* panelPtr : m_cmdViewList){
 		wxDELETE(panelPtr);
 	}
@@ -53,6 +65,7 @@ ExtScrolledWindow::~ExtScrolledWindow()
 
 BEGIN_EVENT_TABLE(ExtScrolledWindow, wxScrolledWindow)
 	EVT_MENU(WX::DELETE_CMD, ExtScrolledWindow::DeleteCmd)
+	EVT_COMMAND(EvtID::PANEL_CHANGED, wxEVT_CUSTOM_EVENT, ExtScrolledWindow::OnPanelChanged)
 END_EVENT_TABLE()
 
 //--------------------------------------------------------------------
@@ -77,6 +90,7 @@ void ExtScrolledWindow::DeleteCmd(wxCommandEvent& event)
 		int scrollPosition=0;
 		int hPosition=0;
 		bool found=false;
+		size_t index=0;
 		std::list<BasePanel*>::iterator it=m_cmdViewList.begin();
 		while(it!=m_cmdViewList.end()){
 			basePanelPtr=*it;
@@ -85,6 +99,7 @@ void ExtScrolledWindow::DeleteCmd(wxCommandEvent& event)
 				height=-1*basePanelPtr->getHeight();
 				
 				it=m_cmdViewList.erase(it);
+				journalRemove(basePanelPtr, index);
 				delete(basePanelPtr);
 
 				found=true;
@@ -104,6 +119,7 @@ void ExtScrolledWindow::DeleteCmd(wxCommandEvent& event)
 			hPosition+=basePanelPtr->getHeight();
 			
 			++it;
+			index++;
 		}
 
 		updateScroll(height);
@@ -119,6 +135,13 @@ void ExtScrolledWindow::DeleteCmd(wxCommandEvent& event)
 
 //--------------------------------------------------------------------
 
+void ExtScrolledWindow::OnPanelChanged(wxCommandEvent& event)
+{
+	m_modifiedPanels.insert(static_cast<BasePanel*>(event.GetEventObject()));
+}
+
+//--------------------------------------------------------------------
+
 void ExtScrolledWindow::updateScroll(int height)
 {
 	m_height+=height;
@@ -185,6 +208,7 @@ void ExtScrolledWindow::removeLast()
 		std::list<BasePanel*>::iterator it=--m_cmdViewList.end();
 		basePanelPtr=*it;
 		m_cmdViewList.pop_back();
+		journalRemove(basePanelPtr, m_cmdViewList.size());
 
 		int height=-1*basePanelPtr->getHeight();
 
@@ -198,6 +222,9 @@ void ExtScrolledWindow::removeLast()
 
 void ExtScrolledWindow::clear()
 {
+	dropPendingEntries();
+	m_journal.detach();
+	m_modifiedPanels.clear();
 	m_height=0;
 	for(BasePanel* panelPtr : m_cmdViewList){
 		wxDELETE(panelPtr);
@@ -223,6 +250,7 @@ bool ExtScrolledWindow::getCmd(BaseCommand*& cmdPtr)
 		m_dataIt=m_cmdViewList.begin();
 		it=m_dataIt;
 		times=0;
+		m_loopIteration=0;
 		m_previousPanel=nullptr;
 	}
 	
@@ -242,10 +270,15 @@ bool ExtScrolledWindow::getCmd(BaseCommand*& cmdPtr)
 		else if(currentDataPtr->isPanel(PanelType::OPEN_LOOP)){
 			times=currentDataPtr->getTimes();
 			it=m_dataIt;
+			m_loopIteration=0;
 		}
 		else if(currentDataPtr->isPanel(PanelType::CLOSE_LOOP)){
 			if(--times>0){
 				m_dataIt=it;
+				m_loopIteration++;
+			}
+			else{
+				m_loopIteration=0;
 			}
 		}
 		++m_dataIt;
@@ -273,6 +306,7 @@ void ExtScrolledWindow::lastCommandFailed()
 void ExtScrolledWindow::reset()
 {
 	m_init=false;
+	m_loopIteration=0;
 	m_previousPanel=nullptr;
 	for(auto panelPtr : m_cmdViewList){
 		panelPtr->SetBackgroundColour(wxColour("#FFFFFF"));
@@ -328,6 +362,19 @@ bool ExtScrolledWindow::getCommand(BaseCommand*& cmdPtr, const ExtScrolledWindow
 	return false;
 }
 
+//--------------------------------------------------------------------
+
+std::vector<BaseCommand*> ExtScrolledWindow::getActiveCommands() const
+{
+	std::vector<BaseCommand*> commands;
+	for(BasePanel* panelPtr : m_cmdViewList){
+		if(panelPtr->isPanel(PanelType::COMMAND) && panelPtr->getCommand()->isActive()){
+			commands.push_back(panelPtr->getCommand());
+		}
+	}
+	return commands;
+}
+
 //----------------------------------------------------------------------
 
 bool ExtScrolledWindow::swap(bool downSwap)
@@ -335,6 +382,7 @@ bool ExtScrolledWindow::swap(bool downSwap)
 	bool doSwap=false;	
 	int height=0;
 
+	size_t index=0;
 	std::list<BasePanel*>::iterator prev=m_cmdViewList.begin();	
 	std::list<BasePanel*>::iterator next=m_cmdViewList.begin();
 
@@ -349,11 +397,18 @@ bool ExtScrolledWindow::swap(bool downSwap)
 		}
 		height+=(*prev)->getHeight();
 		prev=next;
+		index++;
 	}
 
 	if(doSwap){
 		Scroll(0, 0);
 
+		m_journal.swap(index);
+		// the journal of a script still loading would not match
+		if(m_loading){
+			m_loadedScript.clear();
+		}
+
 		BasePanel* basePanelPtr=*prev;
 		*prev=*next;
 		*next=basePanelPtr;
@@ -396,6 +451,7 @@ void ExtScrolledWindow::updateView(const BaseCommand* cmd)
 {
 	for(BasePanel* panelPtr : m_cmdViewList){
 		if(panelPtr->getCommand()==cmd){
+			m_modifiedPanels.insert(panelPtr);
 			dynamic_cast<ControlCommandWrapper*>(panelPtr)->updateTimeout(
 				dynamic_cast<CtrlCommand*>(panelPtr->getCommand())->getTimeout());
 			return;
@@ -405,74 +461,191 @@ void ExtScrolledWindow::updateView(const BaseCommand* cmd)
 
 //--------------------------------------------------------------------
 
+// the line of the script for @param panelPtr, without the new line
+static std::string panelLine(BasePanel* panelPtr)
+{
+	if(panelPtr->isPanel(PanelType::COMMAND)){
+		// DO NOT DELETE this comment: implement null object here 
+		std::ostringstream line;
+		panelPtr->getCommand()->print(line);
+		std::string str=line.str();
+		if(str.length()>0 && str.back()=='\n'){
+			str.pop_back();
+		}
+		return str;
+	}
+	else if(panelPtr->isPanel(PanelType::OPEN_LOOP)){
+		return "loop:"+std::to_string(panelPtr->getTimes());
+	}
+	else if(panelPtr->isPanel(PanelType::CLOSE_LOOP)){
+		return "end_loop";
+	}
+	return "";
+}
+
+//--------------------------------------------------------------------
+
+void ExtScrolledWindow::journalAdd(BasePanel* panelPtr)
+{
+	if(m_journal.isAttached()){
+		m_journal.add(m_cmdViewList.size(), panelLine(panelPtr));
+	}
+}
+
+//--------------------------------------------------------------------
+
+void ExtScrolledWindow::journalRemove(BasePanel* panelPtr, size_t index)
+{
+	m_modifiedPanels.erase(panelPtr);
+	m_journal.remove(index);
+	if(m_loading){
+		m_loadedScript.clear();
+	}
+}
+
+//--------------------------------------------------------------------
+
 bool ExtScrolledWindow::saveData(const char* fileName)
 {
-	std::fstream fileData(fileName, std::ios::out | std::ios::trunc);
-	if(fileData.is_open()){
-		for(auto dataHolder : m_cmdViewList){
-			if(dataHolder->isPanel(PanelType::COMMAND)){
-				// DO NOT DELETE this comment: implement null object here 
-				dataHolder->getCommand()->print(fileData);
-			}
-			else if(dataHolder->isPanel(PanelType::OPEN_LOOP)){
-				fileData<<"loop:"<<dataHolder->getTimes()<<"\n";
-			}
-			else if(dataHolder->isPanel(PanelType::CLOSE_LOOP)){
-				fileData<<"end_loop\n";
+	std::error_code ec;
+	if(m_journal.isAttached(fileName) && !m_journal.needsCompaction()
+		&& std::filesystem::exists(fileName, ec)){
+		if(m_modifiedPanels.size()>0){
+			size_t index=0;
+			for(BasePanel* panelPtr : m_cmdViewList){
+				if(m_modifiedPanels.count(panelPtr)>0){
+					m_journal.modify(index, panelLine(panelPtr));
+				}
+				index++;
 			}
 		}
+
+		if(m_journal.commit()){
+			m_modifiedPanels.clear();
+			return true;
+		}
+		// write it all instead
+	}
+
+	std::string data;
+	for(BasePanel* panelPtr : m_cmdViewList){
+		data.append(panelLine(panelPtr));
+		data.push_back('\n');
+	}
+
+	// a crash half way leaves the previous version in place
+	if(!ScriptJournal::replaceFile(fileName, data)){
+		return false;
 	}
-	bool a=fileData.is_open();
-	fileData.close();
-	return a;
+
+	ScriptJournal::removeLog(fileName);
+	m_journal.attach(fileName, ScriptJournal::contentHash(data));
+	m_modifiedPanels.clear();
+
+	return true;
 }
 
 //--------------------------------------------------------------------
 
 bool ExtScrolledWindow::loadDataFile(const char* fileName)
 {
-	bool result=true;
-	std::ifstream commandFiles;
-	commandFiles.open(getFilePath(fileName), std::ifstream::in);
-	if(commandFiles.is_open()){
-		bool indentation=false;
-		std::string commandLine;
-		while(std::getline(commandFiles, commandLine)){
-			try{
-				if(commandLine.length()==0){
-					continue;
-				}
-				size_t pos=commandLine.find("loop:");
-				if(pos==0){
-					CstrSplit<2> parts(commandLine.c_str(), ":");
-					addLoop(std::atoi(parts[1]));
-					indentation=true;
-					continue;
-				}
-				pos=commandLine.find("end_loop");
-				if(pos==0){
-					closeLoop();
-					indentation=false;
-					continue;
-				}
-				auto cmdPtr=ParserBuilder(commandLine.c_str());
-				if(cmdPtr){
-					if(cmdPtr->getCmdType()==CommandInputTypes::CTRL){
-						addCommand<CtrlCommand>(cmdPtr, indentation);
-					}
-					else if(cmdPtr->getCmdType()==CommandInputTypes::INPUT){
-						addCommand<InputCommand>(cmdPtr, indentation);
-					}
-				}
+	dropPendingEntries();
+	m_journal.detach();
+
+	std::string filePath=getFilePath(fileName);
+	ScriptLoader loader;
+	if(!loader.load(filePath.c_str())){
+		m_loadError=loader.getError();
+		return false;
+	}
+
+	m_loadError.clear();
+	m_loadedScript=filePath;
+	m_loadedHash=loader.getBaseHash();
+	m_loadedLogBytes=loader.getLogBytes();
+	m_loadedLines=loader.lineCount();
+	m_pendingEntries=loader.takeEntries();
+	m_pendingIdx=0;
+	m_pendingIndentation=false;
+	m_loading=true;
+
+	// the first chunk right away, short scripts show up at once
+	addPendingPanels();
+
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+void ExtScrolledWindow::addPendingPanels()
+{
+	// panels are slow to create, a chunk at a time keeps the window responsive
+	const size_t PANELS_PER_CHUNK=256;
+
+	if(!m_loading){
+		return;
+	}
+
+	Freeze();
+	m_deferScroll=true;
+	size_t last=std::min(m_pendingIdx+PANELS_PER_CHUNK, m_pendingEntries.size());
+	for(; m_pendingIdx<last; m_pendingIdx++){
+		ScriptEntry& entry=m_pendingEntries[m_pendingIdx];
+		if(entry.m_type==ScriptEntry::LOOP){
+			addLoop(entry.m_times);
+			m_pendingIndentation=true;
+		}
+		else if(entry.m_type==ScriptEntry::END_LOOP){
+			closeLoop();
+			m_pendingIndentation=false;
+		}
+		else{
+			if(entry.m_command->getCmdType()==CommandInputTypes::CTRL){
+				addCommand<CtrlCommand>(entry.m_command, m_pendingIndentation);
+			}
+			else if(entry.m_command->getCmdType()==CommandInputTypes::INPUT){
+				addCommand<InputCommand>(entry.m_command, m_pendingIndentation);
 			}
-			catch(...){//const std::exception& e){
-				result=false;
-				break;
+			else{
+				delete entry.m_command;
 			}
+			// the panel owns it now
+			entry.m_command=nullptr;
 		}
-		commandFiles.close();
 	}
-	return result;	
+	m_deferScroll=false;
+	updateScroll(0);
+	Thaw();
+
+	if(m_pendingIdx<m_pendingEntries.size()){
+		CallAfter(&ExtScrolledWindow::addPendingPanels);
+		return;
+	}
+
+	m_loading=false;
+	m_pendingEntries.clear();
+	m_pendingIdx=0;
+
+	// the journal counts lines, it only applies if every line got its panel
+	if(m_loadedScript.length()>0 && m_cmdViewList.size()==m_loadedLines){
+		m_journal.attach(m_loadedScript, m_loadedHash, m_loadedLogBytes);
+	}
+	m_loadedScript.clear();
+
+	postEvent(this, wxEVT_CUSTOM_EVENT, EvtID::SCRIPT_LOADED);
+}
+
+//--------------------------------------------------------------------
+
+void ExtScrolledWindow::dropPendingEntries()
+{
+	for(size_t i=m_pendingIdx; i<m_pendingEntries.size(); i++){
+		delete m_pendingEntries[i].m_command;
+	}
+	m_pendingEntries.clear();
+	m_pendingIdx=0;
+	m_loading=false;
+	m_loadedScript.clear();
 }
 
 //====================================================================
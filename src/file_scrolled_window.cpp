@@ -19,6 +19,7 @@
 #include "debug_utils.h"
 
 #include "wx_textctrl.h"
+#include "script_journal.h"
 #include <filesystem>
 
 //====================================================================
@@ -77,7 +78,12 @@ void FilePanel::init(bool disable)
 				m_fileNameInput->ChangeValue(m_fileName);
 				return;
 			}
-			std::filesystem::rename(getFilePath(m_fileName.mb_str()), newFilePath);
+			std::string filePath=getFilePath(m_fileName.mb_str());
+			std::filesystem::rename(filePath, newFilePath);
+			// the journal goes with its script
+			if(ScriptJournal::hasLog(filePath)){
+				std::filesystem::rename(ScriptJournal::logPath(filePath), ScriptJournal::logPath(newFilePath), ec);
+			}
 			m_fileName=val;
 		}
 	});
@@ -159,6 +165,7 @@ void FileScrolledWindow::DeleteFile(wxCommandEvent& event)
 				std::filesystem::path filePath{getFilePath(filePanelPtr->getFileName().mb_str())};
 				if(std::filesystem::exists(filePath, ec)){
 					std::filesystem::remove(filePath);
+					ScriptJournal::removeLog(filePath.string());
 					wxCommandEvent event(wxEVT_CUSTOM_EVENT, EvtID::REMOVE_FILE_FROM_DROPDOWN);
 					event.SetString(filePanelPtr->getFileName());
 					wxPostEvent(this, event);
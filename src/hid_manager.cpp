@@ -22,6 +22,13 @@
 #include "tinyusb_keyboard.h"
 #include "tinyusb_mouse.h"
 
+#include <chrono>
+#include <set>
+#include <thread>
+
+// events due within this time are written together, microseconds
+#define RAW_EVENT_SLACK 500
+
 //====================================================================
 
 ConnectorI* TinyusbConnector::s_connector=NullConnector::getConnector();
@@ -32,6 +39,10 @@ MouseEmulatorI* s_MouseEmulator=nullptr;
 
 HID_TARGET HIDManager::s_currentTarget=HID_TARGET::NONE;
 bool HIDManager::s_isSerial=false;
+bool HIDManager::s_fastTyping=false;
+uint HIDManager::s_typingRate=0;
+bool HIDManager::s_openLoopMouse=false;
+PointerResponse HIDManager::s_pointerResponse;
 
 //====================================================================
 
@@ -43,6 +54,23 @@ void HIDManager::SetDummyEmulator()
 
 	static DummyMouse mouse;
 	s_MouseEmulator=&mouse;
+	s_MouseEmulator->setOpenLoop(s_openLoopMouse);
+}
+
+//--------------------------------------------------------------------
+
+static UinputKeyboard& GetUinputKeyboard()
+{
+	static UinputKeyboard keyboard;
+	return keyboard;
+}
+
+//--------------------------------------------------------------------
+
+static UinputMouse& GetUinputMouse()
+{
+	static UinputMouse mouse;
+	return mouse;
 }
 
 //--------------------------------------------------------------------
@@ -50,17 +78,19 @@ void HIDManager::SetDummyEmulator()
 void HIDManager::SetUinputEmulator()
 {
 	s_currentTarget=HID_TARGET::UINPUT;
-	static UinputKeyboard keyboard;
+	UinputKeyboard& keyboard=GetUinputKeyboard();
 	static bool init=false;
 	if(!init){
 		init=true;
 		keyboard.loadPrintableCharacters();
 	}
+	keyboard.setFastMode(s_fastTyping, s_typingRate);
 
 	s_KeyboardEmulator=&keyboard;
-
-	static UinputMouse mouse;
-	s_MouseEmulator=&mouse;
+	s_MouseEmulator=&GetUinputMouse();
+	s_MouseEmulator->setOpenLoop(s_openLoopMouse);
+	// measured on the uinput device only
+	s_MouseEmulator->setResponse(s_pointerResponse);
 	s_isSerial=false;
 }
 
@@ -83,6 +113,7 @@ void HIDManager::SetTinyusbEmulator(const char* alpha, uint numeric, bool isSeri
 
 	static TinyusbMouse mouse;
 	s_MouseEmulator=&mouse;
+	s_MouseEmulator->setOpenLoop(s_openLoopMouse);
 }
 
 //--------------------------------------------------------------------
@@ -101,4 +132,149 @@ bool HIDManager::checkConnection()
 	return false;
 }
 
+//--------------------------------------------------------------------
+
+void HIDManager::SetTypingMode(bool fast, uint keysPerSecond)
+{
+	s_fastTyping=fast;
+	s_typingRate=keysPerSecond;
+	if(s_currentTarget==HID_TARGET::UINPUT){
+		GetUinputKeyboard().setFastMode(s_fastTyping, s_typingRate);
+	}
+}
+
+//--------------------------------------------------------------------
+
+void HIDManager::SetOpenLoopMouse(bool openLoop)
+{
+	s_openLoopMouse=openLoop;
+	if(s_MouseEmulator){
+		s_MouseEmulator->setOpenLoop(s_openLoopMouse);
+	}
+}
+
+//--------------------------------------------------------------------
+
+void HIDManager::ResetPointerModel()
+{
+	if(s_MouseEmulator){
+		s_MouseEmulator->resetModel();
+	}
+}
+
+//--------------------------------------------------------------------
+
+void HIDManager::SetPointerResponse(const PointerResponse& response)
+{
+	s_pointerResponse=response;
+	if(s_currentTarget==HID_TARGET::UINPUT){
+		GetUinputMouse().setResponse(s_pointerResponse);
+	}
+}
+
+//--------------------------------------------------------------------
+
+bool HIDManager::CalibratePointer(std::function<void(int&, int&)> getMousePosition, PointerResponse& response)
+{
+	if(s_currentTarget!=HID_TARGET::UINPUT){
+		return false;
+	}
+	bool ok=GetUinputMouse().calibrateResponse(getMousePosition, response);
+	s_pointerResponse=response;
+	return ok;
+}
+
+//--------------------------------------------------------------------
+
+bool HIDManager::TypingSelfTest(uint keys, uint& received)
+{
+	received=0;
+	if(s_currentTarget!=HID_TARGET::UINPUT){
+		return false;
+	}
+	return GetUinputKeyboard().selfTest(keys, received);
+}
+
+//====================================================================
+
+bool HIDManager::PlayRawEvents(const std::vector<RawEvent>& events)
+{
+	if(s_currentTarget!=HID_TARGET::UINPUT){
+		return false;
+	}
+
+	UinputEventBatch& keyboard=GetUinputKeyboard().eventBatch();
+	UinputEventBatch& mouse=GetUinputMouse().eventBatch();
+
+	// whatever the emulators left queued goes first
+	bool ok=keyboard.flush() && mouse.flush();
+
+	std::set<uint16_t> keysDown;
+	std::set<uint16_t> buttonsDown;
+	bool keyboardFrame=false;
+	bool mouseFrame=false;
+
+	auto deadline=std::chrono::steady_clock::now();
+	for(const RawEvent& event : events){
+		deadline+=std::chrono::microseconds(event.m_delay);
+		if(deadline-std::chrono::steady_clock::now()>std::chrono::microseconds(RAW_EVENT_SLACK)){
+			ok=keyboard.flush() && ok;
+			ok=mouse.flush() && ok;
+			std::this_thread::sleep_until(deadline);
+		}
+
+		if(event.m_type==EV_SYN){
+			// close the frame of the device(s) that got events
+			if(keyboardFrame){
+				keyboard.add(EV_SYN, SYN_REPORT, 0);
+				keyboardFrame=false;
+			}
+			if(mouseFrame){
+				mouse.add(EV_SYN, SYN_REPORT, 0);
+				mouseFrame=false;
+			}
+			continue;
+		}
+
+		bool toMouse=isPointerEvent(event);
+		std::set<uint16_t>& down=toMouse ? buttonsDown : keysDown;
+		if(event.m_type==EV_KEY){
+			if(event.m_value==0){
+				down.erase(event.m_code);
+			}
+			else{
+				down.insert(event.m_code);
+			}
+		}
+
+		if(toMouse){
+			mouse.add(event.m_type, event.m_code, event.m_value);
+			mouseFrame=true;
+		}
+		else{
+			keyboard.add(event.m_type, event.m_code, event.m_value);
+			keyboardFrame=true;
+		}
+	}
+
+	for(uint16_t code : keysDown){
+		keyboard.add(EV_KEY, code, 0);
+	}
+	if(keyboardFrame || keysDown.size()>0){
+		keyboard.add(EV_SYN, SYN_REPORT, 0);
+	}
+
+	for(uint16_t code : buttonsDown){
+		mouse.add(EV_KEY, code, 0);
+	}
+	if(mouseFrame || buttonsDown.size()>0){
+		mouse.add(EV_SYN, SYN_REPORT, 0);
+	}
+
+	ok=keyboard.flush() && ok;
+	ok=mouse.flush() && ok;
+
+	return ok;
+}
+
 //====================================================================
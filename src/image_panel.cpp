@@ -20,8 +20,31 @@
 **********************************************************************/
 #include "image_panel.h"
 
+#include <wx/imagpnm.h>
+
 //====================================================================
 
+void wxBackgroundBitmap::loadImage(const char* imagePath, wxBitmapType bitmapType)
+{
+	// screenshots may be stored uncompressed, see ImageFormat
+	const char* extension=std::strrchr(imagePath, '.');
+	if(extension){
+		if(std::strcmp(extension, ".ppm")==0){
+			if(!wxImage::FindHandler(wxBITMAP_TYPE_PNM)){
+				wxImage::AddHandler(new wxPNMHandler);
+			}
+			bitmapType=wxBITMAP_TYPE_PNM;
+		}
+		else if(std::strcmp(extension, ".bmp")==0){
+			bitmapType=wxBITMAP_TYPE_BMP;
+		}
+	}
+
+	m_bitmap->LoadFile(imagePath, bitmapType);
+}
+
+//--------------------------------------------------------------------
+
 void wxBackgroundBitmap::loadImage(const char* imagePath, wxBitmapType bitmapType, uint rWidth, uint rHeight)
 {
 	loadImage(imagePath, bitmapType);
@@ -0,0 +1,178 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class ImageStore                                                   *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "image_store.h"
+#include "utilities.h"
+#include "field_split.h"
+#include "script_journal.h"
+#include "debug_utils.h"
+#include "trace.h"
+#include "ImageDiff_Lib/simple_image_difference.h"
+
+#include <filesystem>
+#include <fstream>
+
+//====================================================================
+
+std::string ImageStore::store(const char* imageName)
+{
+	uint64_t hash;
+	{
+		TraceSpan span("contentHash", "image", imageName);
+		hash=SimpleImageDifference::contentHash(getImgPath(imageName).c_str());
+	}
+	if(hash==0){
+		return "";
+	}
+
+	char hexHash[24];
+	std::snprintf(hexHash, sizeof(hexHash), "%016llx", static_cast<unsigned long long>(hash));
+
+	// keep the format the image was captured in
+	std::string storedName=hexHash;
+	const char* extension=std::strrchr(imageName, '.');
+	if(extension){
+		storedName.append(extension);
+	}
+
+	std::error_code ec;
+	std::filesystem::path imgPath{getImgPath(imageName)};
+	std::filesystem::path storedPath{getImgPath(storedName)};
+
+	if(std::filesystem::exists(storedPath, ec)){
+		// same pixels already stored
+		std::filesystem::remove(imgPath, ec);
+	}
+	else{
+		std::filesystem::rename(imgPath, storedPath, ec);
+		if(ec.value()!=0){
+			return "";
+		}
+	}
+
+	dbg("stored image: ", storedName);
+
+	return storedName;
+}
+
+//--------------------------------------------------------------------
+
+void ImageStore::acquire(const std::string& imageName)
+{
+	if(imageName.length()>0){
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_references[imageName]++;
+	}
+}
+
+//--------------------------------------------------------------------
+
+void ImageStore::release(const std::string& imageName)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it=m_references.find(imageName);
+	if(it!=m_references.end()){
+		if(--it->second==0){
+			m_references.erase(it);
+		}
+	}
+}
+
+//--------------------------------------------------------------------
+
+uint ImageStore::references(const std::string& imageName) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it=m_references.find(imageName);
+	if(it!=m_references.end()){
+		return it->second;
+	}
+	return 0;
+}
+
+//--------------------------------------------------------------------
+
+size_t ImageStore::collectGarbage(const std::vector<std::string>& scriptFiles)
+{
+	std::map<std::string, uint> imgReferences;
+
+	std::error_code ec;
+	std::string imageFile;
+	std::filesystem::directory_iterator dirIterator(getImgPath(), ec);
+	if(ec.value()!=0){
+		return 0;
+	}
+
+	for(auto& dirEntry : dirIterator){
+		if(dirEntry.is_regular_file()){
+			imageFile=dirEntry.path().filename().c_str();
+			if(imageFile[0]!='.'){
+				imgReferences[imageFile]=references(imageFile);
+			}
+		}
+	}
+
+	std::vector<std::string> patterns;
+	for(int i=0; i<int(ImageFormat::_LAST); i++){
+		patterns.push_back(imageExtension(ImageFormat(i)));
+		patterns.back().append(SEPARATOR);
+	}
+
+	auto isCtrlCommand=[&patterns](const std::string& commandLine){
+		for(const std::string& pattern : patterns){
+			if(commandLine.find(pattern)!=std::string::npos){
+				return true;
+			}
+		}
+		return false;
+	};
+
+	// commands saved to the journal of a script count as well, the prefix of
+	// its operations only touches the first field
+	std::vector<std::string> files;
+	for(const std::string& scriptFile : scriptFiles){
+		files.push_back(scriptFile);
+		files.push_back(ScriptJournal::logPath(scriptFile));
+	}
+
+	for(const std::string& scriptFile : files){
+		std::ifstream commandFile;
+		commandFile.open(scriptFile, std::ifstream::in);
+		if(commandFile.is_open()){
+			std::string commandLine;
+			while(std::getline(commandFile, commandLine)){
+				if(isCtrlCommand(commandLine)){
+					FieldSplit<20> parts(commandLine, SEPARATOR);
+					auto it=imgReferences.find(parts.str(3));
+					if(it!=imgReferences.end()){
+						it->second++;
+					}
+				}
+			}
+			commandFile.close();
+		}
+	}
+
+	size_t removed=0;
+	for(auto& data : imgReferences){
+		if(data.second==0 && removeImage(data.first)){
+			removed++;
+		}
+	}
+
+	return removed;
+}
+
+//====================================================================
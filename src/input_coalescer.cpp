@@ -0,0 +1,456 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class InputCoalescer                                               *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "input_coalescer.h"
+#include "key_conversion.h"
+#include "key_map.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <linux/input.h>
+
+#define SCREEN "root"
+
+// travel in pixels below which a press and release is a click
+#define CLICK_TOLERANCE 4
+
+// how far in pixels the replayed pointer may be from the recorded one
+#define PATH_TOLERANCE 3.0
+
+//====================================================================
+
+namespace
+{
+	uint waitMs(int64_t gap)
+	{
+		if(gap<0){
+			return 0;
+		}
+		return uint(gap/1000);
+	}
+
+	int leftModifier(int keyCode)
+	{
+		switch(keyCode)
+		{
+			case KEY_RIGHTSHIFT:
+				return KEY_LEFTSHIFT;
+			case KEY_RIGHTCTRL:
+				return KEY_LEFTCTRL;
+			case KEY_RIGHTALT:
+				return KEY_LEFTALT;
+			case KEY_RIGHTMETA:
+				return KEY_LEFTMETA;
+		}
+		return keyCode;
+	}
+}
+
+//====================================================================
+
+InputCoalescer::InputCoalescer(uint lastWait)
+: m_pointer{0, 0, 0}
+, m_leftPress{0, 0, 0}
+, m_scrollAt{0, 0, 0}
+, m_scrollEnd(0)
+, m_scrollV(0)
+, m_scrollH(0)
+, m_textStart(0)
+, m_textEnd(0)
+, m_lastWait(lastWait)
+, m_leftDown(false)
+{
+	readPrintableCharacters("printable_characters.txt", uinputKeyMap, [this](char c, const int* values){
+		int mods=0;
+		int i=0;
+		while(i<4 && values[i+1]>-1){
+			mods|=modifierBit(values[i]);
+			i++;
+		}
+		m_characters.emplace(values[i] | (mods<<16), c);
+	});
+
+	m_characters.emplace(KEY_SPACE, ' ');
+	m_characters.emplace(KEY_TAB, '\t');
+
+	for(auto& data : shortcutParserKeyMap){
+		m_keyNames.emplace(data.second, data.first);
+	}
+	m_keyNames.emplace(KEY_RIGHTMETA, "SUPER");
+}
+
+//--------------------------------------------------------------------
+
+InputCoalescer::~InputCoalescer()
+{
+	reset();
+}
+
+//--------------------------------------------------------------------
+
+void InputCoalescer::reset()
+{
+	for(BaseCommand* cmd : m_commands){
+		delete cmd;
+	}
+	m_commands.clear();
+	m_segment.clear();
+	m_heldModifiers.clear();
+	m_text.clear();
+	m_pending.m_builder=nullptr;
+	m_leftDown=false;
+	m_scrollV=0;
+	m_scrollH=0;
+}
+
+//--------------------------------------------------------------------
+
+int InputCoalescer::modifierBit(int keyCode)
+{
+	switch(keyCode)
+	{
+		case KEY_LEFTSHIFT:
+		case KEY_RIGHTSHIFT:
+			return SHIFT;
+		case KEY_LEFTCTRL:
+		case KEY_RIGHTCTRL:
+			return CTRL;
+		case KEY_LEFTALT:
+			return ALT;
+		case KEY_RIGHTALT:
+			return ALTGR;
+		case KEY_LEFTMETA:
+		case KEY_RIGHTMETA:
+			return META;
+	}
+	return 0;
+}
+
+//--------------------------------------------------------------------
+
+int InputCoalescer::modifiers() const
+{
+	int mods=0;
+	for(int keyCode : m_heldModifiers){
+		mods|=modifierBit(keyCode);
+	}
+	return mods;
+}
+
+//--------------------------------------------------------------------
+
+void InputCoalescer::add(CommandBuilder builder, int64_t start, int64_t end)
+{
+	if(m_pending.m_builder){
+		m_commands.push_back(m_pending.m_builder(waitMs(start-m_pending.m_end)));
+	}
+	m_pending.m_builder=builder;
+	m_pending.m_end=end;
+}
+
+//--------------------------------------------------------------------
+
+void InputCoalescer::flushText()
+{
+	if(m_text.length()==0){
+		return;
+	}
+
+	std::string text=m_text;
+	std::string partial=text;
+	if(text.length()>16){
+		partial=text.substr(0, 16);
+		partial.append("...");
+	}
+
+	add([text, partial](uint wait){
+		return TextCommand::Builder(partial.c_str(), wait, text);
+	}, m_textStart, m_textEnd);
+
+	m_text.clear();
+}
+
+//--------------------------------------------------------------------
+
+void InputCoalescer::flushMove()
+{
+	if(m_segment.size()<2){
+		m_segment.clear();
+		return;
+	}
+
+	std::vector<PointerSample> waypoints=simplifyTrajectory(m_segment, PATH_TOLERANCE);
+	for(size_t i=1; i<waypoints.size(); i++){
+		PointerSample from=waypoints[i-1];
+		PointerSample to=waypoints[i];
+		uint duration=waitMs(to.m_time-from.m_time);
+		add([to, duration](uint wait){
+			return MoveMouseCommand::Builder("Move mouse", wait, to.m_x, to.m_y, SCREEN, duration);
+		}, from.m_time, to.m_time);
+	}
+
+	m_segment.clear();
+}
+
+//--------------------------------------------------------------------
+
+void InputCoalescer::flushScroll()
+{
+	if(m_scrollV==0 && m_scrollH==0){
+		return;
+	}
+
+	PointerSample at=m_scrollAt;
+	int vertical=m_scrollV;
+	int horizontal=m_scrollH;
+	add([at, vertical, horizontal](uint wait){
+		return MouseScrollCommand::Builder("Mouse scroll", wait, at.m_x, at.m_y, SCREEN, vertical, horizontal);
+	}, at.m_time, m_scrollEnd);
+
+	m_scrollV=0;
+	m_scrollH=0;
+}
+
+//--------------------------------------------------------------------
+
+void InputCoalescer::onWheel(const RawInputEvent& event, const PointerSample& pointer)
+{
+	if(m_scrollV!=0 || m_scrollH!=0){
+		if(pointer.m_x!=m_scrollAt.m_x || pointer.m_y!=m_scrollAt.m_y){
+			flushScroll();
+		}
+	}
+
+	if(m_scrollV==0 && m_scrollH==0){
+		flushText();
+		closeSegment(pointer);
+		flushMove();
+		m_scrollAt=pointer;
+	}
+
+	if(event.m_code==REL_WHEEL){
+		m_scrollV+=event.m_value;
+	}
+	else{
+		m_scrollH+=event.m_value;
+	}
+	m_scrollEnd=event.m_time;
+}
+
+//--------------------------------------------------------------------
+
+void InputCoalescer::onKey(const RawInputEvent& event)
+{
+	int keyCode=event.m_code;
+	int modifier=modifierBit(keyCode);
+	if(modifier!=0){
+		auto it=std::find(m_heldModifiers.begin(), m_heldModifiers.end(), keyCode);
+		if(event.m_value==0 && it!=m_heldModifiers.end()){
+			m_heldModifiers.erase(it);
+		}
+		else if(event.m_value==1 && it==m_heldModifiers.end()){
+			m_heldModifiers.push_back(keyCode);
+		}
+		return;
+	}
+
+	if(event.m_value==0){
+		return;
+	}
+
+	int mods=modifiers();
+	if((mods & (CTRL | ALT | META))==0){
+		auto it=m_characters.find(keyCode | ((mods & (SHIFT | ALTGR))<<16));
+		if(it!=m_characters.end()){
+			flushMove();
+			if(m_text.length()==0){
+				m_textStart=event.m_time;
+			}
+			m_text.push_back(it->second);
+			m_textEnd=event.m_time;
+			return;
+		}
+	}
+
+	flushText();
+	flushMove();
+
+	if(mods==0){
+		for(int i=1; i<int(SPKEYS::_LAST); i++){
+			if(KeyConversion::getKeyCode<UinputKeyboard>(SPKEYS(i))==uint(keyCode)){
+				auto nameIt=m_keyNames.find(keyCode);
+				std::string name=(nameIt!=m_keyNames.end()) ? nameIt->second : "Key";
+				if(keyCode==KEY_ENTER){
+					name="Enter";
+				}
+				else if(keyCode==KEY_ESC){
+					name="Esc";
+				}
+
+				add([name, i](uint wait){
+					return KeyCommad::Builder(name.c_str(), i, wait);
+				}, event.m_time, event.m_time);
+
+				return;
+			}
+		}
+	}
+
+	auto nameIt=m_keyNames.find(keyCode);
+	if(nameIt==m_keyNames.end() || m_heldModifiers.size()>=MAX_HID_CODES){
+		dbg("key not recorded: ", keyCode);
+		return;
+	}
+
+	std::string shortcut;
+	for(int modifierCode : m_heldModifiers){
+		// a right-hand modifier without a name plays as the left one,
+		// one without either is left out rather than saved as "+"
+		auto modifierIt=m_keyNames.find(modifierCode);
+		if(modifierIt==m_keyNames.end()){
+			modifierIt=m_keyNames.find(leftModifier(modifierCode));
+		}
+		if(modifierIt==m_keyNames.end()){
+			dbg("modifier not recorded: ", modifierCode);
+			continue;
+		}
+		shortcut.append(modifierIt->second);
+		shortcut.append("+");
+	}
+	shortcut.append(nameIt->second);
+
+	add([shortcut](uint wait){
+		return ShortcutCommand::Builder(shortcut.c_str(), wait, shortcut.c_str());
+	}, event.m_time, event.m_time);
+}
+
+//--------------------------------------------------------------------
+
+void InputCoalescer::onButton(const RawInputEvent& event, const PointerSample& pointer)
+{
+	if(event.m_code==BTN_LEFT){
+		if(event.m_value==1){
+			flushText();
+			closeSegment(pointer);
+			flushMove();
+			m_leftDown=true;
+			m_leftPress=pointer;
+		}
+		else if(event.m_value==0 && m_leftDown){
+			m_leftDown=false;
+			PointerSample press=m_leftPress;
+			if(std::abs(pointer.m_x-press.m_x)+std::abs(pointer.m_y-press.m_y)<CLICK_TOLERANCE){
+				add([press](uint wait){
+					return MouseLeftBtnCommand::Builder("Mouse left button click", wait, press.m_x, press.m_y, SCREEN);
+				}, press.m_time, pointer.m_time);
+			}
+			else{
+				PointerSample release=pointer;
+				uint duration=waitMs(release.m_time-press.m_time);
+				add([press, release, duration](uint wait){
+					return MouseDragCommand::Builder("Mouse grab/drop", wait,
+								press.m_x, press.m_y, release.m_x, release.m_y, SCREEN, duration);
+				}, press.m_time, release.m_time);
+			}
+		}
+	}
+	else if(event.m_code==BTN_RIGHT && event.m_value==1){
+		flushText();
+		closeSegment(pointer);
+		flushMove();
+		PointerSample click=pointer;
+		add([click](uint wait){
+			return MouseRightBtnCommand::Builder("Mouse right button click", wait, click.m_x, click.m_y, SCREEN);
+		}, click.m_time, click.m_time);
+	}
+}
+
+//--------------------------------------------------------------------
+
+void InputCoalescer::process(const std::vector<RawInputEvent>& events, int x, int y)
+{
+	// buttons pressed before any motion in this batch happened where the
+	// pointer was at the end of the previous batch
+	bool moved=false;
+	for(const RawInputEvent& event : events){
+		if(event.m_type==EV_KEY){
+			if(event.m_value==1){
+				flushScroll();
+			}
+			if(event.m_code>=BTN_MOUSE && event.m_code<BTN_JOYSTICK){
+				PointerSample pointer{event.m_time, moved ? x : m_pointer.m_x, moved ? y : m_pointer.m_y};
+				onButton(event, pointer);
+			}
+			else if(event.m_code<BTN_MISC){
+				if(moved && !m_leftDown){
+					// the key may end the pointer path
+					closeSegment({event.m_time, x, y});
+				}
+				onKey(event);
+			}
+		}
+		else if(event.m_type==EV_REL && (event.m_code==REL_WHEEL || event.m_code==REL_HWHEEL)){
+			// the high resolution codes repeat the same ticks
+			if(!m_leftDown){
+				onWheel(event, {event.m_time, moved ? x : m_pointer.m_x, moved ? y : m_pointer.m_y});
+			}
+		}
+		else if(event.m_type==EV_REL && (event.m_code==REL_X || event.m_code==REL_Y)){
+			flushScroll();
+			if(!m_leftDown && m_segment.size()==0){
+				// the path starts where the pointer was
+				m_segment.push_back({event.m_time, m_pointer.m_x, m_pointer.m_y});
+			}
+			moved=true;
+			m_pointer.m_time=event.m_time;
+		}
+	}
+
+	m_pointer.m_x=x;
+	m_pointer.m_y=y;
+	if(moved && !m_leftDown){
+		closeSegment(m_pointer);
+	}
+}
+
+//--------------------------------------------------------------------
+
+void InputCoalescer::closeSegment(const PointerSample& pointer)
+{
+	if(m_segment.size()>0 && pointer.m_time>m_segment.back().m_time){
+		m_segment.push_back(pointer);
+	}
+}
+
+//--------------------------------------------------------------------
+
+std::vector<BaseCommand*> InputCoalescer::takeCommands()
+{
+	flushText();
+	flushScroll();
+	flushMove();
+	if(m_pending.m_builder){
+		m_commands.push_back(m_pending.m_builder(m_lastWait));
+		m_pending.m_builder=nullptr;
+	}
+
+	std::vector<BaseCommand*> commands;
+	commands.swap(m_commands);
+
+	return commands;
+}
+
+//====================================================================
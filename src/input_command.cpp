@@ -10,6 +10,7 @@
 * class ExitCode                                                     *
 * struct MouseCmdExitPosition                                        *
 * class WindowOffset                                                 *
+* class MouseMotion                                                  *
 * class BaseCommand                                                  *
 * class InputCommand                                                 *
 * class TextCommand                                                  *
@@ -22,6 +23,7 @@
 * class MouseRightBtnCommand                                         *
 * class MouseSelectCommand                                           *
 * class MouseSelectCommand2                                          *
+* class RawEventsCommand                                             *
 * class CtrlCommand                                                  *
 *         	                                                         *
 * Version: 1.0                                                       *
@@ -31,6 +33,8 @@
 #include "input_command.h"
 #include "hid_manager.h"
 #include "ImageDiff_Lib/simple_image_difference.h"
+#include "image_store.h"
+#include "settings_manager.h"
 #include "utilities.h"
 #include "debug_utils.h"
 
@@ -68,15 +72,34 @@ static SimpleImageDifference* GetImageDifference()
 	return &s_simpleImageDifference;
 }
 
+// preprocessing of the base and sample images, the one
+// SimpleImageDifference::loadBaseImage(const char*) applies
+constexpr bool SHARP_IMAGES=true;
+constexpr bool DENOISE_IMAGES=true;
+
+// base image currently decoded in GetImageDifference() and the
+// preprocessing it was decoded with
+static struct
+{
+	std::string m_name;
+	bool m_sharp=false;
+	bool m_denoise=false;
+} s_loadedBaseImage;
+
+//====================================================================
+
+static void PointerPosition(int& pX, int& pY)
+{
+	wxPoint mousePosition=wxGetMousePosition();
+	pX=mousePosition.x;
+	pY=mousePosition.y;
+}
+
 //====================================================================
 
 void MouseLeftClick(int x, int y)
 {
-	s_MouseEmulator->go2Position(x, y, [](int& pX, int& pY){
-		wxPoint mousePosition=wxGetMousePosition();
-		pX=mousePosition.x;
-		pY=mousePosition.y;
-	});
+	s_MouseEmulator->go2Position(x, y, PointerPosition);
 
 	s_MouseEmulator->clickLeftBtn();
 }
@@ -106,8 +129,8 @@ bool WindowOffset::isTargetValid(int x, int y)
 		return true;
 	}
 
-	if(::windowExists(m_windowName.c_str())){
-		WindowRect rect=getWindowRect(m_windowName.c_str(), true);
+	if(::windowExists(m_windowId)){
+		WindowRect rect=getWindowRect(m_windowId, true);
 		m_absoluteX=x+rect.m_x;
 		m_absoluteY=y+rect.m_y;
 		return rect.inside(x, y);
@@ -211,11 +234,12 @@ ShortcutCommand* ShortcutCommand::Builder(const char* description, int wait, con
 
 //====================================================================
 
-MoveMouseCommand::MoveMouseCommand(const char* description, int wait, int x, int y, const char* windowName)
+MoveMouseCommand::MoveMouseCommand(const char* description, int wait, int x, int y, const char* windowName, uint duration)
 :InputCommand(description, wait)
 , WindowOffset(windowName)
 , m_x(x)
 , m_y(y)
+, m_duration(duration)
 {
 	m_cmd=[this](){
 		m_statusCode=ExitCode::TARGET_WINDOW_CLOSED;
@@ -223,11 +247,12 @@ MoveMouseCommand::MoveMouseCommand(const char* description, int wait, int x, int
 			m_statusCode=ExitCode::OUT_OF_BOUND;
 			if(isTargetValid(m_x, m_y)){
 				m_statusCode=ExitCode::OK;
-				s_MouseEmulator->go2Position(m_absoluteX, m_absoluteY, [](int& pX, int& pY){
-					wxPoint mousePosition=wxGetMousePosition();
-					pX=mousePosition.x;
-					pY=mousePosition.y;
-				});
+				if(m_duration>0){
+					s_MouseEmulator->glide(m_absoluteX, m_absoluteY, m_duration, PointerPosition);
+				}
+				else{
+					s_MouseEmulator->go2Position(m_absoluteX, m_absoluteY, PointerPosition, m_motion);
+				}
 			}
 		}
 	};
@@ -235,7 +260,7 @@ MoveMouseCommand::MoveMouseCommand(const char* description, int wait, int x, int
 	int ID=static_cast<int>(CommandTypes::MouseMove);
 
 	m_strCmd=[this, ID](){
-		return ToString2(ID, m_description, m_run, m_x, m_y, m_windowName);
+		return ToString2(ID, m_description, m_run, m_x, m_y, m_windowName, m_duration, m_motion.toString());
 	};
 }
 
@@ -253,11 +278,7 @@ MouseLeftBtnCommand::MouseLeftBtnCommand(const char* description, int wait, int
 			m_statusCode=ExitCode::OUT_OF_BOUND;
 			if(isTargetValid(m_x, m_y)){
 				m_statusCode=ExitCode::OK;
-				s_MouseEmulator->go2Position(m_absoluteX, m_absoluteY, [](int& pX, int& pY){
-					wxPoint mousePosition=wxGetMousePosition();
-					pX=mousePosition.x;
-					pY=mousePosition.y;
-				});
+				s_MouseEmulator->go2Position(m_absoluteX, m_absoluteY, PointerPosition, m_motion);
 
 				s_MouseEmulator->clickLeftBtn();
 			}
@@ -268,7 +289,7 @@ MouseLeftBtnCommand::MouseLeftBtnCommand(const char* description, int wait, int
 	int ID=static_cast<int>(CommandTypes::MouseLeftBtn);
 
 	m_strCmd=[this, ID](){
-		return ToString2(ID, m_description, m_run, m_x, m_y, m_windowName);
+		return ToString2(ID, m_description, m_run, m_x, m_y, m_windowName, m_motion.toString());
 	};
 }
 
@@ -286,11 +307,7 @@ MouseRightBtnCommand::MouseRightBtnCommand(const char* description, int wait, in
 			m_statusCode=ExitCode::OUT_OF_BOUND;
 			if(isTargetValid(m_x, m_y)){
 				m_statusCode=ExitCode::OK;
-				s_MouseEmulator->go2Position(m_absoluteX, m_absoluteY, [](int& pX, int& pY){
-					wxPoint mousePosition=wxGetMousePosition();
-					pX=mousePosition.x;
-					pY=mousePosition.y;
-				});
+				s_MouseEmulator->go2Position(m_absoluteX, m_absoluteY, PointerPosition, m_motion);
 
 				s_MouseEmulator->clickRightBtn();
 			}
@@ -301,7 +318,7 @@ MouseRightBtnCommand::MouseRightBtnCommand(const char* description, int wait, in
 	int ID=static_cast<int>(CommandTypes::MouseRightBtn);
 
 	m_strCmd=[this, ID](){
-		return ToString2(ID, m_description, m_run, m_x, m_y, m_windowName);
+		return ToString2(ID, m_description, m_run, m_x, m_y, m_windowName, m_motion.toString());
 	};
 }
 
@@ -321,11 +338,7 @@ MouseSelectCommand::MouseSelectCommand(const char* description, int wait, uint p
 			m_statusCode=ExitCode::OUT_OF_BOUND;
 			if(isTargetValid(m_posX, m_posY)){
 				m_statusCode=ExitCode::OK;
-				s_MouseEmulator->select(m_absoluteX, m_absoluteY, m_width, m_height, [](int& pX, int& pY){
-					wxPoint mousePosition=wxGetMousePosition();
-					pX=mousePosition.x;
-					pY=mousePosition.y;
-				});
+				s_MouseEmulator->select(m_absoluteX, m_absoluteY, m_width, m_height, PointerPosition, m_motion);
 			}
 		}
 		MouseCmdExitPosition::setExitPosition();
@@ -334,19 +347,20 @@ MouseSelectCommand::MouseSelectCommand(const char* description, int wait, uint p
 	int ID=static_cast<int>(CommandTypes::MouseSelection);
 
 	m_strCmd=[this, ID](){
-		return ToString2(ID, m_description, m_run, m_posX, m_posY, m_width, m_height, m_windowName);
+		return ToString2(ID, m_description, m_run, m_posX, m_posY, m_width, m_height, m_windowName, m_motion.toString());
 	};
 }
 
 //====================================================================
 
-MouseDragCommand::MouseDragCommand(const char* description, int wait, int startX, int startY, int endX, int endY, const char* windowName)
+MouseDragCommand::MouseDragCommand(const char* description, int wait, int startX, int startY, int endX, int endY, const char* windowName, uint duration)
 :InputCommand(description, wait)
 , WindowOffset(windowName)
 , m_startX(startX)
 , m_startY(startY)
 , m_endX(endX)
 , m_endY(endY)
+, m_duration(duration)
 {
 	m_cmd=[this](){
 		m_statusCode=ExitCode::TARGET_WINDOW_CLOSED;
@@ -360,11 +374,7 @@ MouseDragCommand::MouseDragCommand(const char* description, int wait, int startX
 					int absEndX=m_absoluteX;
 					int absEndY=m_absoluteY;
 
-					s_MouseEmulator->drag(absStartX, absStartY, absEndX, absEndY, [](int& pX, int& pY){
-						wxPoint mousePosition=wxGetMousePosition();
-						pX=mousePosition.x;
-						pY=mousePosition.y;
-					});
+					s_MouseEmulator->drag(absStartX, absStartY, absEndX, absEndY, PointerPosition, m_duration, m_motion);
 				}
 			}
 		}
@@ -374,7 +384,7 @@ MouseDragCommand::MouseDragCommand(const char* description, int wait, int startX
 	int ID=static_cast<int>(CommandTypes::MouseDrag);
 
 	m_strCmd=[this, ID](){
-		return ToString2(ID, m_description, m_run, m_startX, m_startY, m_endX, m_endY, m_windowName);
+		return ToString2(ID, m_description, m_run, m_startX, m_startY, m_endX, m_endY, m_windowName, m_duration, m_motion.toString());
 	};
 }
 
@@ -387,6 +397,7 @@ MouseDragCommand::MouseDragCommand(const char* description, int wait, int endX,
 , m_startY(-1)
 , m_endX(endX)
 , m_endY(endY)
+, m_duration(0)
 {
 	/*
 	 * Notice that if the current mouse position is not the same as the
@@ -403,11 +414,7 @@ MouseDragCommand::MouseDragCommand(const char* description, int wait, int endX,
 				int startX=MouseCmdExitPosition::s_x;
 				int startY=MouseCmdExitPosition::s_y;
 
-				s_MouseEmulator->drag(startX, startY, m_absoluteX, m_absoluteY, [](int& pX, int& pY){
-					wxPoint mousePosition=wxGetMousePosition();
-					pX=mousePosition.x;
-					pY=mousePosition.y;
-				});
+				s_MouseEmulator->drag(startX, startY, m_absoluteX, m_absoluteY, PointerPosition, 0, m_motion);
 			}
 		}
 		MouseCmdExitPosition::setExitPosition();
@@ -416,24 +423,96 @@ MouseDragCommand::MouseDragCommand(const char* description, int wait, int endX,
 	int ID=static_cast<int>(CommandTypes::MouseDrag);
 
 	m_strCmd=[this, ID](){
-		return ToString2(ID, m_description, m_run, -1, -1, m_endX, m_endY, m_windowName);
+		return ToString2(ID, m_description, m_run, -1, -1, m_endX, m_endY, m_windowName, 0, m_motion.toString());
 	};
 }
 
 //====================================================================
 
-CtrlCommand::CtrlCommand(const char* description, const std::string& baseImageName, const char* roiStr, const char* windowName, bool removeImg)
+MouseScrollCommand::MouseScrollCommand(const char* description, int wait, int x, int y, const char* windowName, int vertical, int horizontal)
+:InputCommand(description, wait)
+, WindowOffset(windowName)
+, m_x(x)
+, m_y(y)
+, m_vertical(vertical)
+, m_horizontal(horizontal)
+{
+	m_cmd=[this](){
+		m_statusCode=ExitCode::TARGET_WINDOW_CLOSED;
+		if(windowExists()){
+			m_statusCode=ExitCode::OUT_OF_BOUND;
+			if(isTargetValid(m_x, m_y)){
+				m_statusCode=ExitCode::OK;
+				s_MouseEmulator->go2Position(m_absoluteX, m_absoluteY, PointerPosition, m_motion);
+
+				s_MouseEmulator->scroll(m_vertical, m_horizontal);
+			}
+		}
+		MouseCmdExitPosition::setExitPosition();
+	};
+
+	int ID=static_cast<int>(CommandTypes::MouseScroll);
+
+	m_strCmd=[this, ID](){
+		return ToString2(ID, m_description, m_run, m_x, m_y, m_windowName, m_vertical, m_horizontal, m_motion.toString());
+	};
+}
+
+//====================================================================
+
+RawEventsCommand::RawEventsCommand(const char* description, int wait, const std::vector<RawEvent>& events)
+:InputCommand(description, wait)
+, m_events(events)
+, m_statusCode(ExitCode::OK)
+{
+	init();
+}
+
+//--------------------------------------------------------------------
+
+RawEventsCommand::RawEventsCommand(const char* description, int wait, const std::string& encoded)
+:InputCommand(description, wait)
+, m_statusCode(ExitCode::OK)
+{
+	if(!decodeRawEvents(encoded.c_str(), encoded.length(), m_events)){
+		dbg("corrupted raw events: ", description);
+	}
+	init();
+}
+
+//--------------------------------------------------------------------
+
+void RawEventsCommand::init()
+{
+	m_cmd=[this](){
+		m_statusCode=ExitCode::OK;
+		if(!HIDManager::PlayRawEvents(m_events)){
+			m_statusCode=ExitCode::FAILED;
+		}
+	};
+
+	int ID=static_cast<int>(CommandTypes::RawEvents);
+
+	m_strCmd=[this, ID](){
+		return ToString2(ID, m_description, m_run, encodeRawEvents(m_events));
+	};
+}
+
+//====================================================================
+
+CtrlCommand::CtrlCommand(const char* description, const std::string& baseImageName, const char* roiStr, const char* windowName, bool checkImage)
 :BaseCommand(description)
 , WindowOffset(windowName)
 , m_baseImageName(baseImageName)
 , m_roiStr(roiStr)
+, m_difference(-1)
 , m_tries(1)
 , m_triesCount(0)
 , m_threshold(240)
 , m_sensitivity(100)
 , m_similarity(true)
 , m_strictRun(true)
-, m_cleanImg(removeImg)
+, m_baseImageExists(true)
 {
 	m_cbk=[](){
 		return true;
@@ -443,15 +522,19 @@ CtrlCommand::CtrlCommand(const char* description, const std::string& baseImageNa
 
 	m_cmd=[this](){
 		m_triesCount=0;
-		if(imageExists(m_baseImageName)){
-			GetImageDifference()->loadBaseImage(getImgPath(m_baseImageName).c_str());
-		}
-		else{
+		// pick up changes of the sample format
+		setCtrlCallback();
+		m_baseImageExists=loadBaseImage();
+		if(!m_baseImageExists){
 			m_triesCount=m_tries;
 			m_statusCode=ExitCode::BASE_IMAGE_MISSING;
 		}
 	};
 
+	ImageStore::getImageStore().acquire(m_baseImageName);
+	if(checkImage){
+		m_baseImageExists=imageExists(m_baseImageName);
+	}
 	setCtrlCallback();
 }
 
@@ -459,42 +542,45 @@ CtrlCommand::CtrlCommand(const char* description, const std::string& baseImageNa
 
 CtrlCommand::~CtrlCommand()
 {
-	std::string sampleImg="sample_"+m_baseImageName;
-	removeImage(sampleImg);
-	if(m_cleanImg){
-		removeImg();
-	}
+	removeImage(m_sampleImageName);
+	// unreferenced images are removed by ImageStore::collectGarbage
+	ImageStore::getImageStore().release(m_baseImageName);
 }
 
 //--------------------------------------------------------------------
 
 void CtrlCommand::setCtrlCallback()
 {
-	std::string sampleImg="sample_"+m_baseImageName;
-
-	std::string screenshotCmd;
-
-	if(m_roiStr.length()>0){
-		screenshotCmd=mkScreenshotStrCmd(m_windowName, sampleImg, m_roiStr);
+	ImageFormat sampleFormat=SettingsManager::getSettingManager().getSampleFormat();
+	std::string sampleImg=setImageFormat("sample_"+m_baseImageName, sampleFormat);
+	if(sampleImg!=m_sampleImageName){
+		removeImage(m_sampleImageName);
+		m_sampleImageName=sampleImg;
 	}
-	else{
-		screenshotCmd=mkScreenshotStrCmd(m_windowName, sampleImg);
-	}
-	
-	std::string smpImgPath=getImgPath(sampleImg);
 
-	bool baseImageExists=imageExists(m_baseImageName);
+	std::string smpImgPath=getImgPath(sampleImg);
 
-	m_cbk=[this, screenshotCmd, smpImgPath, baseImageExists](){
-		
-		if(baseImageExists){
+	m_cbk=[this, sampleImg, smpImgPath](){
+		m_difference=-1;
+		if(m_baseImageExists){
 			m_statusCode=ExitCode::TARGET_WINDOW_CLOSED;
 			if(windowExists()){
 				m_statusCode=ExitCode::SYSTEM_FAILED;
-				if(0==system(screenshotCmd.c_str())){
+				// built now, the X id of the window is only known once it is open
+				std::string screenshotCmd=mkScreenshotStrCmd(m_windowId, sampleImg, m_roiStr);
+				int screenshotStatus=-1;
+				if(!screenshotCmd.empty()){
+					TraceSpan span("screenshot", "image", m_windowName);
+					screenshotStatus=system(screenshotCmd.c_str());
+				}
+				if(0==screenshotStatus){
 					m_statusCode=ExitCode::OK;
 					try{
-						return GetImageDifference()->isSimilar(smpImgPath.c_str(), m_threshold, m_sensitivity);
+						TraceSpan span("getDifference", "image", m_baseImageName.c_str());
+						// same test as isSimilar, the score goes to the run report;
+						// the count stops at m_sensitivity, the outcome is known then
+						m_difference=GetImageDifference()->getDifference(smpImgPath.c_str(), m_threshold, m_sensitivity);
+						return m_difference<long(m_sensitivity);
 					}
 					catch(const std::exception& e){
 						m_statusCode=ExitCode::CV_EXCEPTION;
@@ -510,9 +596,11 @@ void CtrlCommand::setCtrlCallback()
 
 void CtrlCommand::updateBaseImg(const char* baseImg, const char* roiStr)
 {
-	//removeImg(); do not remove the image because we do not know if it is used by another test
+	ImageStore::getImageStore().release(m_baseImageName);
 	m_baseImageName=baseImg;
+	ImageStore::getImageStore().acquire(m_baseImageName);
 	m_roiStr=roiStr;
+	m_baseImageExists=imageExists(m_baseImageName);
 	setCtrlCallback();	
 }
 
@@ -522,6 +610,8 @@ bool CtrlCommand::ready()
 {
 	dbg("ctrl cmd ready");
 
+	TraceSpan span("ready", "command", m_description.c_str());
+
 	bool result=m_cbk();
 	if(!m_similarity){
 		result=!result;
@@ -541,14 +631,23 @@ bool CtrlCommand::ready()
 	return result;
 }
 
+
 //--------------------------------------------------------------------
 
-void CtrlCommand::removeImg()
+bool CtrlCommand::loadBaseImage()
 {
-	// remove sample image too
-	if(removeImage(m_baseImageName)){
-		m_baseImageName="";
+	if(!imageExists(m_baseImageName)){
+		return false;
+	}
+
+	// stored images never change, decode them only when the base changes
+	if(s_loadedBaseImage.m_name!=m_baseImageName
+		|| s_loadedBaseImage.m_sharp!=SHARP_IMAGES || s_loadedBaseImage.m_denoise!=DENOISE_IMAGES){
+		TraceSpan span("loadBaseImage", "image", m_baseImageName.c_str());
+		GetImageDifference()->loadBaseImage(getImgPath(m_baseImageName).c_str(), SHARP_IMAGES, DENOISE_IMAGES);
+		s_loadedBaseImage={m_baseImageName, SHARP_IMAGES, DENOISE_IMAGES};
 	}
+	return true;
 }
 
 //====================================================================
@@ -7,6 +7,7 @@
 * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 * THE SOFTWARE. 
 * 
+* bool readPrintableCharacters(const char*, const std::map<std::string, int>&, ...)
 * class KeyboardEmulatorI                                            *
 * class DummyKeyboard                                                *
 *         	                                                         *
@@ -81,38 +82,51 @@ static char printableCharacterParser(const std::string& str, int* values, const
 
 //--------------------------------------------------------------------
 
+bool readPrintableCharacters(const char* fileName, const std::map<std::string, int>& keyMap,
+		std::function<void(char, const int*)> cbk)
+{
+	std::ifstream characterTable;
+
+	characterTable.open(resourcePath(fileName), std::ifstream::in);
+	if(!characterTable.is_open()){
+		return false;
+	}
+
+	std::string combo;
+	combo.reserve(32);
+	while(std::getline(characterTable, combo)){
+		if(combo.length()==0){
+			continue;
+		}
+		int values[5]={-1, -1, -1, -1, -1};
+		char c=printableCharacterParser(combo, values, keyMap);
+		if(c>0){
+			cbk(c, values);
+		}
+	}
+	characterTable.close();
+
+	return true;
+}
+
+//--------------------------------------------------------------------
+
 void KeyboardEmulatorI::loadPrintableCharacters(const char* fileName, const std::map<std::string, int>& keyMap)
 {
 	if(isActive()){
 		addWhiteCharacters();
 
-		std::ifstream characterTable;
-		
-		std::string filePath=resourcePath(fileName);
-		
-		characterTable.open(filePath, std::ifstream::in);
-		if(!characterTable.is_open()){
-			characterTable.close();
+		bool ok=readPrintableCharacters(fileName, keyMap, [this](char c, const int* values){
+			addCombo(c, values[0], values[1], values[2], values[3], values[4]);
+		});
+
+		if(!ok){
+			std::string filePath=resourcePath(fileName);
 			filePath.append(" : not found");
 			setLastError([this](){
 				return true;
 			}, filePath.c_str());
-			return;
-		}
-
-		std::string combo;
-		combo.reserve(32);
-		while(std::getline(characterTable, combo)){
-			if(combo.length()==0){
-				continue;
-			}
-			int values[5]={-1, -1, -1, -1, -1};
-			char c=printableCharacterParser(combo, values, keyMap);
-			if(c>0){
-				addCombo(c, values[0], values[1], values[2], values[3], values[4]);
-			}
 		}
-		characterTable.close();
 	}
 }
 
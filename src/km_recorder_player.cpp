@@ -19,15 +19,22 @@
 #include "wx_textctrl.h"
 #include "wxstring_array.h"
 #include "utilities.h"
+#include "image_store.h"
+#include "uinput_event_batch.h"
+#include "input_coalescer.h"
 #include "hid_manager.h"
+#include "window_registry.h"
+#include "pre_flight.h"
 #include "debug_utils.h"
 #include "progress_bar.h"
 #include "wx_worker.h"
+#include "trace.h"
 
 #include <wx/display.h>
 #include <wx/menu.h>
 #include <wx/valnum.h>
 #include <wx/spinctrl.h>
+#include <wx/numdlg.h>
 
 #include <filesystem>
 
@@ -37,6 +44,9 @@
 #define CMD_LIST_WIDTH 380
 #define CMD_LIST_HEIGHT 450
 
+// how often captured input is drained, in milliseconds
+#define CAPTURE_PERIOD 10
+
 extern MouseEmulatorI* s_MouseEmulator;
 extern KeyboardEmulatorI* s_KeyboardEmulator;
 
@@ -49,6 +59,8 @@ wxTextValidator s_shortcutValidator(wxFILTER_EXCLUDE_CHAR_LIST);
 
 extern wxIntegerValidator<unsigned int> s_integerValidator;
 
+int RecorderPlayerKM::s_exitCode=0;
+
 //====================================================================
 
 static wxBitmapBundle mkBitmapBundle(const char* icon)
@@ -83,11 +95,15 @@ RecorderPlayerKM::RecorderPlayerKM(const wxString& title)
 	)
 , m_settings(SettingsManager::getSettingManager())
 , m_timer(this, WX::TIMER)
+, m_captureTimer(this, WX::CAPTURE_TIMER)
 , m_playBitmapBundle(mkBitmapBundle("actions/media-playback-start-symbolic.symbolic.png"))
 , m_pauseBitmapBundle(mkBitmapBundle("actions/media-playback-pause-symbolic.symbolic.png"))
 , m_statusBar(nullptr)
 , m_inputBlocker(nullptr)
 , m_workerPtr(nullptr)
+, m_evdevRecorder(nullptr)
+, m_inputCoalescer(nullptr)
+, m_rawCapture(false)
 , m_commandInputMode(CommandInputMode::REPEAT_LAST)
 , m_state(State::INITIAL)
 , m_currentPanelState(PanelStates::Initial)
@@ -96,6 +112,8 @@ RecorderPlayerKM::RecorderPlayerKM(const wxString& title)
 , m_fullFunctionality(SystemStatus::OK)
 , m_fullMenu(true)
 , m_indentation(false)
+, m_autoPlay(getenv(PLAY_ENV)!=nullptr)
+, m_runFailed(false)
 {
 	wxBoxSizer* mainContentSizerV = new wxBoxSizer(wxVERTICAL);
 
@@ -117,6 +135,10 @@ RecorderPlayerKM::RecorderPlayerKM(const wxString& title)
 	s_fileValidator.AddCharExcludes(" ");
 	s_fileValidator.SuppressBellOnError(false);
 
+	HIDManager::SetTypingMode(m_settings.getFastTyping(), m_settings.getTypingRate());
+	HIDManager::SetOpenLoopMouse(m_settings.getOpenLoopMouse());
+	HIDManager::SetPointerResponse(m_settings.getPointerResponse());
+
 	HIDManager::SetHidEmulator(m_settings.getInterface(),
 			m_settings.alpha().mb_str(), m_settings.numeric(), m_settings.isSerial());
 
@@ -426,6 +448,16 @@ RecorderPlayerKM::RecorderPlayerKM(const wxString& title)
 		m_statusBar->SetLabel(wxString::Format(wxT("Total commands: %i"), m_scrolledWindow->getCommandCount()));
 	}, EvtID::CMD_COUNT_UPDATED);
 
+	Bind(wxEVT_CUSTOM_EVENT, [this](wxCommandEvent& event){
+		m_demoBtn->Enable();
+		m_playBtn->Enable();
+		m_saveBtn->Enable();
+		m_statusBar->SetLabel(wxString::Format(wxT("Total commands: %i"), m_scrolledWindow->getCommandCount()));
+		if(m_autoPlay && !StartPlaying()){
+			AutoPlayFinished(2);
+		}
+	}, EvtID::SCRIPT_LOADED);
+
 	//===============================================
 	//===============================================
 	//------------------ Get Focus ------------------
@@ -468,67 +500,44 @@ RecorderPlayerKM::RecorderPlayerKM(const wxString& title)
 
 	Centre();
 
+	// KMRP_TRACE=<file> traces the whole session, see ~RecorderPlayerKM
+	if(getenv(TRACE_ENV)){
+		Tracer::getTracer().setEnabled(true);
+	}
+
 	checkConnection();
+
+	if(m_autoPlay){
+		wxString scriptName(getenv(PLAY_ENV));
+		CallAfter([this, scriptName](){
+			AutoPlay(scriptName);
+		});
+	}
 }
 
 //====================================================================
 
 RecorderPlayerKM::~RecorderPlayerKM()
 {
+	const char* traceFile=getenv(TRACE_ENV);
+	if(traceFile && !Tracer::getTracer().dump(traceFile)){
+		debugWarning("cannot write the trace to ", traceFile);
+	}
+
 	m_settings.save();
+	m_captureTimer.Stop();
+	wxDELETE(m_evdevRecorder);
+	wxDELETE(m_inputCoalescer);
 	wxDELETE(m_statusBar);
 	m_scrolledWindow->clear();
 
 	// remove unused images
-	std::vector<std::pair<std::string, bool> > imgVector;
-
-	std::error_code ec;
-	std::string imageFile;
-	std::filesystem::directory_iterator dirIterator(getImgPath(), ec);
-	if(ec.value()==0){
-		for(auto& dirEntry : dirIterator){
-			if(dirEntry.is_regular_file()){
-				imageFile=dirEntry.path().filename().c_str();
-				if(imageFile[0]!='.'){
-					imgVector.push_back({imageFile.c_str(), false});
-				}
-			}
-		}
-	}
-	
-	std::string pattern=".png";
-	pattern.append(SEPARATOR);
-	wxString fileName;
-
+	std::vector<std::string> scriptFiles;
 	for(unsigned int i=0; i<m_fileDropDown->GetCount(); i++){
-		fileName=m_fileDropDown->GetString(i);
-		std::ifstream commandFiles;
-		commandFiles.open(getFilePath(fileName.mb_str()), std::ifstream::in);
-		if(commandFiles.is_open()){
-	
-			std::string commandLine;
-			std::string img;
-			while(std::getline(commandFiles, commandLine)){
-				if(commandLine.find(pattern)!=std::string::npos){
-					CstrSplit<20> parts(commandLine.c_str(), SEPARATOR);
-					const char* imageName=parts[3];
-					for(auto& data : imgVector){
-						if(data.first==imageName){
-							data.second=true;
-							break;
-						}
-					}
-				}
-			}
-			commandFiles.close();
-		}
+		scriptFiles.push_back(getFilePath(m_fileDropDown->GetString(i).mb_str()));
 	}
+	ImageStore::getImageStore().collectGarbage(scriptFiles);
 
-	for(auto& data : imgVector){
-		if(!data.second){
-			removeImage(data.first);
-		}
-	}
 	wxDELETE(m_roiOptions);
    wxDELETE(m_selectWindowPopup);
    wxDELETE(m_screenshotPopup);
@@ -553,6 +562,7 @@ BEGIN_EVENT_TABLE(RecorderPlayerKM, wxFrame)
 	EVT_BUTTON(WX::DEMO, RecorderPlayerKM::OnControlBtns)
 	EVT_BUTTON(WX::SAVE_TO_FILE, RecorderPlayerKM::OnSave)
 	EVT_TIMER(WX::TIMER, RecorderPlayerKM::OnRunCmdTimer)
+	EVT_TIMER(WX::CAPTURE_TIMER, RecorderPlayerKM::OnCaptureTimer)
 
 	EVT_MENU(WX::MENU::WINDOW_INPUT, RecorderPlayerKM::OnMenuClick)
 	EVT_MENU(WX::MENU::OPEN_LOOP, RecorderPlayerKM::OnLoopBtn)
@@ -560,6 +570,8 @@ BEGIN_EVENT_TABLE(RecorderPlayerKM, wxFrame)
 	EVT_MENU(WX::MENU::MOVE_HERE, RecorderPlayerKM::OnMenuClick)
 	EVT_MENU(WX::MENU::DO_LEFT_CLICK, RecorderPlayerKM::OnMenuClick)
 	EVT_MENU(WX::MENU::DO_RIGHT_CLICK, RecorderPlayerKM::OnMenuClick)
+	EVT_MENU(WX::MENU::SCROLL_UP_HERE, RecorderPlayerKM::OnMenuClick)
+	EVT_MENU(WX::MENU::SCROLL_DOWN_HERE, RecorderPlayerKM::OnMenuClick)
 	EVT_MENU(WX::MENU::SCREENSHOT_CMD, RecorderPlayerKM::OnMenuClick)
 	EVT_MENU(WX::MENU::START_ROI, RecorderPlayerKM::OnMenuClick)
 	EVT_MENU(WX::MENU::START_DRAGGING, RecorderPlayerKM::OnMenuClick)
@@ -571,6 +583,8 @@ BEGIN_EVENT_TABLE(RecorderPlayerKM, wxFrame)
 	EVT_MENU(WX::MENU::CLOSE_MENU, RecorderPlayerKM::OnMenuClick)
 	EVT_MENU(WX::MENU::CANCEL_NEW_ROI, RecorderPlayerKM::OnMenuClick)
 	EVT_MENU(WX::MENU::DISPLAY_KBOARD, RecorderPlayerKM::OnMenuClick)
+	EVT_MENU(WX::MENU::CAPTURE_INPUT, RecorderPlayerKM::OnMenuClick)
+	EVT_MENU(WX::MENU::CAPTURE_RAW_INPUT, RecorderPlayerKM::OnMenuClick)
 
 	EVT_BUTTON(WX::LOOP_BUTTON, RecorderPlayerKM::OnLoopBtn)
 
@@ -784,14 +798,16 @@ void RecorderPlayerKM::OnSelection(wxCommandEvent& event)
 
 //====================================================================
 
-std::string RecorderPlayerKM::imageId()
+std::string RecorderPlayerKM::storeCapture(const std::string& captureImage, bool taken)
 {
-	static int imgCount=0;
-	std::string id=session();
-	id.append("_");
-	id.append(std::to_string(imgCount++));
-	id.append(".png");
-	return id;
+	if(taken){
+		std::string imageName=ImageStore::getImageStore().store(captureImage.c_str());
+		if(imageName.length()>0){
+			return imageName;
+		}
+	}
+	removeImage(captureImage);
+	return "";
 }
 
 //====================================================================
@@ -824,16 +840,106 @@ void RecorderPlayerKM::addCommand()
 
 //====================================================================
 
+void RecorderPlayerKM::startInputCapture(bool raw)
+{
+	if(!m_evdevRecorder){
+		m_evdevRecorder=new EvdevRecorder;
+	}
+
+	wxDELETE(m_inputCoalescer);
+	m_inputCoalescer=new InputCoalescer(m_settings.getTimePadding());
+	m_capturedEvents.clear();
+	m_rawCapture=raw;
+	m_captureStart=wxGetMousePosition();
+
+	ManagePanels(PanelStates::Playing);
+	if(!m_evdevRecorder->start()){
+		ManagePanels(PanelStates::Recording);
+		wxMessageBox(wxT("Input devices cannot be read.\nThe user must be in the \"input\" group."));
+		return;
+	}
+
+	m_captureTimer.Start(CAPTURE_PERIOD);
+}
+
+//--------------------------------------------------------------------
+
+void RecorderPlayerKM::OnCaptureTimer(wxTimerEvent& event)
+{
+	static std::vector<RawInputEvent> s_batch;
+
+	s_batch.clear();
+	m_evdevRecorder->drain(s_batch);
+	if(s_batch.size()>0){
+		wxPoint pointer=wxGetMousePosition();
+		m_inputCoalescer->process(s_batch, pointer.x, pointer.y);
+		m_capturedEvents.insert(m_capturedEvents.end(), s_batch.begin(), s_batch.end());
+	}
+
+	if(m_evdevRecorder->stopRequested()){
+		stopInputCapture();
+	}
+}
+
+//--------------------------------------------------------------------
+
+void RecorderPlayerKM::stopInputCapture()
+{
+	m_captureTimer.Stop();
+	m_evdevRecorder->stop();
+
+	std::vector<RawInputEvent> batch;
+	if(m_evdevRecorder->drain(batch)>0){
+		wxPoint pointer=wxGetMousePosition();
+		m_inputCoalescer->process(batch, pointer.x, pointer.y);
+		m_capturedEvents.insert(m_capturedEvents.end(), batch.begin(), batch.end());
+	}
+
+	dbg("captured events: ", m_capturedEvents.size(), " kernel drops: ", m_evdevRecorder->kernelDrops());
+
+	std::vector<BaseCommand*> commands;
+	if(m_rawCapture){
+		std::vector<RawEvent> rawEvents=toRawEvents(m_capturedEvents);
+		if(rawEvents.size()>0){
+			// raw pointer motion is relative to where it started
+			commands.push_back(MoveMouseCommand::Builder("Move mouse", 0, m_captureStart.x, m_captureStart.y, FULL_SCREEN));
+			std::string description=wxString::Format(wxT("Raw input: %zu events"), rawEvents.size()).ToStdString();
+			commands.push_back(RawEventsCommand::Builder(description.c_str(), m_settings.getTimePadding(), rawEvents));
+		}
+	}
+	else{
+		commands=m_inputCoalescer->takeCommands();
+	}
+
+	// the user already did these, do not replay them
+	for(BaseCommand* cmd : commands){
+		m_scrolledWindow->addCommand<InputCommand>(cmd, m_indentation);
+	}
+
+	if(commands.size()>0){
+		m_dataChanged++;
+		m_demoBtn->Enable();
+		m_playBtn->Enable();
+		m_saveBtn->Enable();
+		m_statusBar->SetLabel(wxString::Format(wxT("Total commands: %i"), m_scrolledWindow->getCommandCount()));
+	}
+
+	ManagePanels(PanelStates::Recording);
+}
+
+//====================================================================
+
 void RecorderPlayerKM::takeRoiScreenshoot(PanelStates exitState, int roiMode)
 {
 	ManagePanels(PanelStates::Playing);
-	m_baseImage=imageId();
 	m_roiStr=m_selectionRect.getRoiStr();
+	std::string captureImage=setImageFormat(CAPTURE_IMAGE, m_settings.getBaseImageFormat());
 
-	bool ok=wxTakeScreenshot(300, m_currentWindow.c_str(), m_baseImage.c_str(), m_roiStr.mb_str());
+	bool ok=wxTakeScreenshot(300, m_currentWindow.c_str(), captureImage.c_str(), m_roiStr.mb_str());
 
 	ManagePanels(exitState);
-	if(ok){
+	m_baseImage=storeCapture(captureImage, ok);
+	if(m_baseImage.length()>0){
 		if(roiMode==1){
 			m_setupCtrlCmdPopup->loadRoi(m_baseImage.c_str(), m_roiStr.c_str(), m_currentWindow.c_str());			
 			m_setupCtrlCmdPopup->Popup();
@@ -945,6 +1051,18 @@ void RecorderPlayerKM::OnMenuClick(wxCommandEvent& event)
 		case WX::MENU::DO_RIGHT_CLICK:
 			addCommand(MouseRightBtnCommand::Builder("Mouse right button click", m_settings.getTimePadding(), m_click.x, m_click.y, m_currentWindow.c_str()));
 			break;
+		case WX::MENU::SCROLL_UP_HERE:
+		case WX::MENU::SCROLL_DOWN_HERE:
+			{
+				long ticks=wxGetNumberFromUser(wxT("Number of wheel ticks"), wxT("Ticks:"),
+									wxT("Mouse scroll"), 5, 1, 1000, this);
+				if(ticks>0){
+					const bool up=event.GetId()==WX::MENU::SCROLL_UP_HERE;
+					addCommand(MouseScrollCommand::Builder(up ? "Mouse scroll up" : "Mouse scroll down",
+						m_settings.getTimePadding(), m_click.x, m_click.y, m_currentWindow.c_str(), up ? ticks : -ticks));
+				}
+			}
+			break;
 		case WX::MENU::SCREENSHOT_CMD:
 			m_screenshotPopup->Popup();
 			break;
@@ -964,6 +1082,12 @@ void RecorderPlayerKM::OnMenuClick(wxCommandEvent& event)
 		case WX::MENU::DISPLAY_KBOARD:
 			m_auxKeyboard->Popup();
 			break;
+		case WX::MENU::CAPTURE_INPUT:
+			startInputCapture(false);
+			break;
+		case WX::MENU::CAPTURE_RAW_INPUT:
+			startInputCapture(true);
+			break;
 		case WX::MENU::CANCEL_NEW_ROI:
 			{
 				m_fullMenu=true;
@@ -1058,11 +1182,18 @@ void RecorderPlayerKM::mkMenu(bool allowScreenshot, bool fullMenu)
 			menu.Append(WX::MENU::MOVE_HERE, wxT("Move Here"));
 			menu.Append(WX::MENU::DO_LEFT_CLICK, wxT("Left Click Here"));
 			menu.Append(WX::MENU::DO_RIGHT_CLICK, wxT("Right Click Here"));
+			menu.Append(WX::MENU::SCROLL_UP_HERE, wxT("Scroll Up Here..."));
+			menu.Append(WX::MENU::SCROLL_DOWN_HERE, wxT("Scroll Down Here..."));
 			menu.Append(WX::MENU::START_ROI, wxT("Select Area"));
 			menu.Append(WX::MENU::START_DRAGGING, wxT("Start Dragging"));
 			menu.Append(WX::MENU::DRAG_HERE, wxT("Drag/Drop Here"));
 				menu.Enable(WX::MENU::DRAG_HERE, false);
 			menu.Append(WX::MENU::DISPLAY_KBOARD, wxT("Text and Keyboard Input"));
+			menu.Append(WX::MENU::CAPTURE_INPUT, wxT("Capture Live Input (Pause to stop)"));
+				menu.Enable(WX::MENU::CAPTURE_INPUT, m_fullFunctionality==SystemStatus::OK);
+			menu.Append(WX::MENU::CAPTURE_RAW_INPUT, wxT("Capture Raw Input (Pause to stop)"));
+				menu.Enable(WX::MENU::CAPTURE_RAW_INPUT, m_fullFunctionality==SystemStatus::OK
+								&& HIDManager::currentEmulator(HID_TARGET::UINPUT));
 			menu.Append(WX::MENU::SCREENSHOT_CMD, wxT("Take Screenshot"));
 				menu.Enable(WX::MENU::SCREENSHOT_CMD, allowScreenshot && m_fullFunctionality==SystemStatus::OK);
 
@@ -1140,6 +1271,8 @@ void RecorderPlayerKM::RunCommands(ExtScrolledWindow::PlayMode mode)
 
 	m_mode=mode;
 	m_scrolledWindow->reset();
+	// the pointer has been moved by the user since the last run
+	HIDManager::ResetPointerModel();
 
 	int ms=m_settings.getTimeDelay();
 	if(m_mode==ExtScrolledWindow::PlayMode::DEMO){
@@ -1148,6 +1281,8 @@ void RecorderPlayerKM::RunCommands(ExtScrolledWindow::PlayMode mode)
 	}
 
 	m_currentRunningCmd=nullptr;	
+	m_runFailed=false;
+	m_runReport.begin();
 	m_timer.StartOnce(ms);
 }
 
@@ -1161,7 +1296,12 @@ void RecorderPlayerKM::OnRunCmdTimer(wxTimerEvent& event)
 
 	if(m_currentRunningCmd==nullptr){
 		if(m_scrolledWindow->getCommand(m_currentRunningCmd, m_mode)){
+			// windows may have moved or closed since the last step
+			WindowRegistry::getWindowRegistry().expire();
+			uint64_t uinputWrites=UinputEventBatch::writeCount();
+			m_runReport.commandStarted(m_currentRunningCmd, m_scrolledWindow->getLoopIteration());
 			m_currentRunningCmd->execute();
+			dbg("uinput write calls: ", UinputEventBatch::writeCount()-uinputWrites);
 			m_timer.StartOnce(m_currentRunningCmd->wait());
 		}
 		else{
@@ -1169,7 +1309,10 @@ void RecorderPlayerKM::OnRunCmdTimer(wxTimerEvent& event)
 		}
 	}
 	else{
-		if(m_currentRunningCmd->ready()){
+		WindowRegistry::getWindowRegistry().expire();
+		bool done=m_currentRunningCmd->ready();
+		m_runReport.commandPolled(m_currentRunningCmd, done);
+		if(done){
 			int cmdExitCode=m_currentRunningCmd->getExitCode();
 
 			m_currentRunningCmd=nullptr;
@@ -1177,6 +1320,7 @@ void RecorderPlayerKM::OnRunCmdTimer(wxTimerEvent& event)
 			m_scrolledWindow->lastCommandFailed();
 			
 			if((cmdExitCode & 1)>0){
+				m_runFailed=true;
 				SequenceFinished();
 			}
 			else{			
@@ -1197,6 +1341,25 @@ void RecorderPlayerKM::SequenceFinished()
 	m_playStatus=PlayStatus::STOPPED;
 	m_playBtn->SetBitmap(m_playBitmapBundle);
 
+	if(m_mode==ExtScrolledWindow::PlayMode::NORMAL && !m_runReport.empty()){
+		std::string scriptName=std::string(m_fileDropDown->GetStringSelection().mb_str());
+		if(scriptName.length()==0){
+			scriptName="untitled";
+		}
+		std::string reportPath=getFilePath(("."+scriptName+REPORT_EXT).c_str());
+		if(m_runReport.save(reportPath, scriptName)){
+			m_statusBar->SetLabel(wxString::Format(wxT("Run report: %s.json"), reportPath));
+		}
+		else{
+			debugWarning("cannot write the run report ", reportPath);
+		}
+	}
+
+	if(m_autoPlay && m_mode==ExtScrolledWindow::PlayMode::NORMAL){
+		AutoPlayFinished(m_runFailed ? 1 : 0);
+		return;
+	}
+
 	if(m_state!=State::RECORDING){
 		ManagePanels(PanelStates::Initial);
 	}
@@ -1235,9 +1398,6 @@ void RecorderPlayerKM::takeScreenshotByWindow(const char* windowName)
 		return;
 	}
 
-	m_baseImage=imageId();
-	const char* outputImage=m_baseImage.c_str();
-
 	if(!windowExists(windowName)){
 		wxMsgBox("Window with name \"%s\" not exists.", windowName);
 		return;
@@ -1245,16 +1405,17 @@ void RecorderPlayerKM::takeScreenshotByWindow(const char* windowName)
 
 	ManagePanels(PanelStates::Playing);
 
-	bool taken=takeScreenshot(windowName, outputImage);
+	std::string captureImage=setImageFormat(CAPTURE_IMAGE, m_settings.getBaseImageFormat());
+	bool taken=takeScreenshot(windowName, captureImage.c_str());
 
 	ManagePanels(PanelStates::Recording);
 
-	if(taken){
+	m_baseImage=storeCapture(captureImage, taken);
+	if(m_baseImage.length()>0){
 		m_setupCtrlCmdPopup->loadRoi(m_baseImage.c_str(), "", windowName);
 		m_setupCtrlCmdPopup->Popup();
 	}
 	else{
-		removeImage(outputImage);
 		wxMsgBox("Window with name \"%s\" not exists.", windowName);
 	}
 }
@@ -1483,6 +1644,80 @@ bool RecorderPlayerKM::Pause()
 
 //====================================================================
 
+bool RecorderPlayerKM::PreFlightCheck()
+{
+	PreFlight preFlight;
+	{
+		wxBusyCursor busy;
+		preFlight.run(m_scrolledWindow->getActiveCommands());
+	}
+
+	if(preFlight.getProblems().empty()){
+		return true;
+	}
+
+	wxString report=wxString::FromUTF8(preFlight.report().c_str());
+	if(preFlight.hasErrors()){
+		dialogConfirm(report, wxT("The script cannot run"));
+		return false;
+	}
+
+	if(m_autoPlay){
+		dialogConfirm(report, wxT("Pre-flight warnings"));
+		return true;
+	}
+
+	wxMessageDialog dialog(this, report, wxT("Run the script anyway?"), wxYES_NO|wxCENTRE|wxICON_WARNING);
+	return dialog.ShowModal()==wxID_YES;
+}
+
+//====================================================================
+
+bool RecorderPlayerKM::StartPlaying()
+{
+	if(!PreFlightCheck()){
+		return false;
+	}
+
+	m_playStatus=PlayStatus::PLAYING;
+	m_state=State::PLAY;
+	m_inputBlocker->reset();
+	RunCommands(ExtScrolledWindow::PlayMode::NORMAL);
+	m_playBtn->SetBitmap(m_pauseBitmapBundle);
+	return true;
+}
+
+//====================================================================
+
+void RecorderPlayerKM::AutoPlay(const wxString& scriptName)
+{
+	if(!m_fileDropDown->SetStringSelection(scriptName)
+		|| !m_scrolledWindow->loadDataFile(scriptName.mb_str())){
+		dialogConfirm(wxString(m_scrolledWindow->getLoadError()), wxT("Cannot load ")+scriptName);
+		AutoPlayFinished(2);
+		return;
+	}
+
+	// the run starts once the panels are in, see EvtID::SCRIPT_LOADED
+	m_fileNameInput->SetValue(scriptName);
+	m_statusBar->SetLabel(wxT("Loading..."));
+}
+
+//====================================================================
+
+void RecorderPlayerKM::AutoPlayFinished(int exitCode)
+{
+	s_exitCode=exitCode;
+	m_autoPlay=false;
+	m_playStatus=PlayStatus::STOPPED;
+	m_timer.Stop();
+	// nothing to ask about on the way out
+	m_dataChanged=0;
+	Close(true);
+}
+
+//====================================================================
+
 void RecorderPlayerKM::OnControlBtns(wxCommandEvent& event)
 {
 	switch(event.GetId())
@@ -1490,11 +1725,7 @@ void RecorderPlayerKM::OnControlBtns(wxCommandEvent& event)
 		case WX::PLAY:
 			{
 				if(m_playStatus==PlayStatus::STOPPED){
-					m_playStatus=PlayStatus::PLAYING;
-					m_state=State::PLAY;
-					m_inputBlocker->reset();
-					RunCommands(ExtScrolledWindow::PlayMode::NORMAL);					
-					m_playBtn->SetBitmap(m_pauseBitmapBundle);
+					StartPlaying();
 				}
 				else{
 					if(!Pause()){
@@ -1638,15 +1869,20 @@ void RecorderPlayerKM::OnSelectedFile(wxCommandEvent& event)
 
 	m_dataChanged=0;
 	if(m_scrolledWindow->loadDataFile(selectedFile.mb_str())){
+		// the buttons are enabled once the panels are in, see EvtID::SCRIPT_LOADED
 		m_indentation=false;
-		m_demoBtn->Enable();
-		m_playBtn->Enable();
-		m_saveBtn->Enable();
-		m_statusBar->SetLabel(wxString::Format(wxT("Total commands: %i"), m_scrolledWindow->getCommandCount()));
+		m_statusBar->SetLabel(wxT("Loading..."));
 	}
 	else{
+		// keep the error, clearCommands does not touch it
+		wxString loadError(m_scrolledWindow->getLoadError());
 		clearCommands();
-		wxMsgBox("Failed to load the file: %s", selectedFile);
+		if(loadError.length()>0){
+			wxMessageBox(wxString::Format(wxT("Failed to load the file: %s\n%s"), selectedFile, loadError));
+		}
+		else{
+			wxMsgBox("Failed to load the file: %s", selectedFile);
+		}
 	}
 }
 
@@ -1790,6 +2026,144 @@ void RecorderPlayerKM::initPopups()
 			}
 		});
 
+		ArrayStringType imageFormats(int(ImageFormat::_LAST), "");
+		imageFormats[int(ImageFormat::PNG)]="PNG";
+		imageFormats[int(ImageFormat::PPM)]="PPM (uncompressed)";
+		imageFormats[int(ImageFormat::BMP)]="BMP (uncompressed)";
+
+		auto sampleFormatTag=settingsPopup->builder<wxStaticText>(wxID_ANY,
+									wxT("Sample image format: "));
+
+		auto sampleFormat=settingsPopup->builder<wxChoice>(wxID_ANY, wxDefaultPosition,
+									wxDefaultSize, imageFormats);
+
+		sampleFormat->SetSelection(int(m_settings.getSampleFormat()));
+		sampleFormat->Bind(wxEVT_CHOICE, [this, sampleFormat](wxCommandEvent& event){
+			m_settings.setSampleFormat(sampleFormat->GetSelection());
+		});
+
+		auto baseFormatTag=settingsPopup->builder<wxStaticText>(wxID_ANY,
+									wxT("Control image format: "));
+
+		auto baseFormat=settingsPopup->builder<wxChoice>(wxID_ANY, wxDefaultPosition,
+									wxDefaultSize, imageFormats);
+
+		baseFormat->SetSelection(int(m_settings.getBaseImageFormat()));
+		baseFormat->Bind(wxEVT_CHOICE, [this, baseFormat](wxCommandEvent& event){
+			m_settings.setBaseImageFormat(baseFormat->GetSelection());
+		});
+
+		auto fastTypingCheck=settingsPopup->builder<wxCheckBox>(wxID_ANY, wxT("Fast typing (uinput), keys/s: "));
+		fastTypingCheck->SetValue(m_settings.getFastTyping());
+
+		auto typingRate=settingsPopup->builder<WX_TextCtrl>(wxID_ANY, wxT("500"), wxDefaultPosition,
+						FromDIP(wxSize(-1, 30)), 0, s_integerValidator);
+
+		typingRate->ChangeValue(wxString::Format(wxT("%i"), m_settings.getTypingRate()));
+		typingRate->setCallback([this, fastTypingCheck](const char* val){
+			m_settings.setTypingMode(fastTypingCheck->GetValue(), std::atoi(val));
+		});
+
+		fastTypingCheck->Bind(wxEVT_CHECKBOX, [this, fastTypingCheck](wxCommandEvent& event){
+			m_settings.setTypingMode(fastTypingCheck->GetValue(), m_settings.getTypingRate());
+		});
+
+		auto typingTestBtn=settingsPopup->builder<wxButton>(wxID_ANY, wxT("Test"));
+
+		typingTestBtn->Bind(wxEVT_BUTTON, [this](wxCommandEvent& event){
+			if(!HIDManager::currentEmulator(HID_TARGET::UINPUT)){
+				wxMessageBox(wxT("Typing test is only available for /dev/uinput."));
+				return;
+			}
+			const uint keys=200;
+			uint received=0;
+			if(HIDManager::TypingSelfTest(keys, received)){
+				wxMessageBox(wxString::Format(wxT("Typing test passed: %u keys received."), received));
+			}
+			else{
+				wxMessageBox(wxString::Format(wxT("Typing test failed: %u of %u keys received.\nLower the typing rate."), received, keys));
+			}
+		});
+
+		ArrayStringType motionProfiles(int(MotionProfile::_LAST), "");
+		motionProfiles[int(MotionProfile::LEGACY)]="Legacy";
+		motionProfiles[int(MotionProfile::INSTANT)]="Instant";
+		motionProfiles[int(MotionProfile::LINEAR)]="Linear (steps)";
+		motionProfiles[int(MotionProfile::EASE_IN_OUT)]="Ease in-out (steps)";
+		motionProfiles[int(MotionProfile::VELOCITY)]="Constant velocity (px/s)";
+
+		auto motionTag=settingsPopup->builder<wxStaticText>(wxID_ANY,
+									wxT("Mouse motion: "));
+
+		auto motionProfile=settingsPopup->builder<wxChoice>(wxID_ANY, wxDefaultPosition,
+									wxDefaultSize, motionProfiles);
+
+		motionProfile->SetSelection(int(m_settings.getMotion().profile()));
+
+		auto motionParam=settingsPopup->builder<WX_TextCtrl>(wxID_ANY, wxT("0"), wxDefaultPosition,
+						FromDIP(wxSize(80, 30)), 0, s_integerValidator);
+
+		motionParam->ChangeValue(wxString::Format(wxT("%u"), m_settings.getMotion().param()));
+		motionParam->setCallback([this, motionProfile](const char* val){
+			m_settings.setMotion(motionProfile->GetSelection(), std::atoi(val));
+		});
+
+		motionProfile->Bind(wxEVT_CHOICE, [this, motionProfile](wxCommandEvent& event){
+			m_settings.setMotion(motionProfile->GetSelection(), m_settings.getMotion().param());
+		});
+
+		auto openLoopCheck=settingsPopup->builder<wxCheckBox>(wxID_ANY, wxT("Open loop pointer positioning"));
+		openLoopCheck->SetValue(m_settings.getOpenLoopMouse());
+		openLoopCheck->Bind(wxEVT_CHECKBOX, [this, openLoopCheck](wxCommandEvent& event){
+			m_settings.setOpenLoopMouse(openLoopCheck->GetValue());
+		});
+
+		auto calibrateBtn=settingsPopup->builder<wxButton>(wxID_ANY, wxT("Calibrate pointer"));
+
+		calibrateBtn->Bind(wxEVT_BUTTON, [this](wxCommandEvent& event){
+			if(!HIDManager::currentEmulator(HID_TARGET::UINPUT)){
+				wxMessageBox(wxT("Pointer calibration is only available for /dev/uinput."));
+				return;
+			}
+			PointerResponse response;
+			bool ok=HIDManager::CalibratePointer([](int& x, int& y){
+				wxPoint mousePosition=wxGetMousePosition();
+				x=mousePosition.x;
+				y=mousePosition.y;
+			}, response);
+
+			if(ok){
+				m_settings.setPointerResponse(response);
+				wxMessageBox(wxString::Format(wxT("Pointer calibrated: %i counts move %.1f pixels."),
+									response.maxCounts(), response.maxPixels()));
+			}
+			else{
+				m_settings.setPointerResponse(PointerResponse());
+				wxMessageBox(wxT("Pointer calibration failed, the pointer did not move."));
+			}
+		});
+
+		auto traceCheck=settingsPopup->builder<wxCheckBox>(wxID_ANY, wxT("Trace command latency"));
+		traceCheck->SetValue(Tracer::getTracer().isEnabled());
+		traceCheck->Bind(wxEVT_CHECKBOX, [traceCheck](wxCommandEvent& event){
+			Tracer::getTracer().setEnabled(traceCheck->GetValue());
+		});
+
+		auto saveTraceBtn=settingsPopup->builder<wxButton>(wxID_ANY, wxT("Save trace"));
+
+		saveTraceBtn->Bind(wxEVT_BUTTON, [](wxCommandEvent& event){
+			std::string tracePath=getFilePath(TRACE_FILE);
+			Tracer& tracer=Tracer::getTracer();
+			if(tracer.dump(tracePath.c_str())){
+				wxMessageBox(wxString::Format(wxT("%zu spans (%zu dropped) saved to %s,\nopen it with chrome://tracing or ui.perfetto.dev"),
+									tracer.size(), tracer.dropped(), tracePath));
+				tracer.clear();
+			}
+			else{
+				wxMessageBox(wxString::Format(wxT("Cannot write %s"), tracePath));
+			}
+		});
+
 		auto interfacePopupBtn=settingsPopup->builder<wxButton>(wxID_ANY, wxT("Set Interface"));
 
 		interfacePopupBtn->Bind(wxEVT_BUTTON, [this](wxCommandEvent& event){
@@ -1820,7 +2194,33 @@ void RecorderPlayerKM::initPopups()
 			row4->Add(selectionBrushColour, 1);
 
 			wxBoxSizer* row5=new wxBoxSizer(wxHORIZONTAL);
-			row5->Add(interfacePopupBtn, 0);
+			row5->Add(sampleFormatTag, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, FromDIP(10));
+			row5->Add(sampleFormat, 1);
+
+			wxBoxSizer* row6=new wxBoxSizer(wxHORIZONTAL);
+			row6->Add(baseFormatTag, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, FromDIP(10));
+			row6->Add(baseFormat, 1);
+
+			wxBoxSizer* row7=new wxBoxSizer(wxHORIZONTAL);
+			row7->Add(fastTypingCheck, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, FromDIP(10));
+			row7->Add(typingRate, 1, wxRIGHT, FromDIP(10));
+			row7->Add(typingTestBtn, 0);
+
+			wxBoxSizer* row8=new wxBoxSizer(wxHORIZONTAL);
+			row8->Add(motionTag, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, FromDIP(10));
+			row8->Add(motionProfile, 1, wxRIGHT, FromDIP(10));
+			row8->Add(motionParam, 0);
+
+			wxBoxSizer* row9=new wxBoxSizer(wxHORIZONTAL);
+			row9->Add(openLoopCheck, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, FromDIP(10));
+			row9->Add(calibrateBtn, 0);
+
+			wxBoxSizer* row10=new wxBoxSizer(wxHORIZONTAL);
+			row10->Add(traceCheck, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, FromDIP(10));
+			row10->Add(saveTraceBtn, 0);
+
+			wxBoxSizer* row11=new wxBoxSizer(wxHORIZONTAL);
+			row11->Add(interfacePopupBtn, 0);
 
 			wxBoxSizer* col = new wxBoxSizer(wxVERTICAL);
 			col->Add(row, 0, wxBOTTOM | wxEXPAND, FromDIP(10));
@@ -1828,7 +2228,13 @@ void RecorderPlayerKM::initPopups()
 			col->Add(row2, 0, wxBOTTOM | wxEXPAND, FromDIP(10));
 			col->Add(row3, 0, wxBOTTOM | wxEXPAND, FromDIP(10));
 			col->Add(row4, 0, wxBOTTOM | wxEXPAND, FromDIP(10));
-			col->Add(row5, 0);
+			col->Add(row5, 0, wxBOTTOM | wxEXPAND, FromDIP(10));
+			col->Add(row6, 0, wxBOTTOM | wxEXPAND, FromDIP(10));
+			col->Add(row7, 0, wxBOTTOM | wxEXPAND, FromDIP(10));
+			col->Add(row8, 0, wxBOTTOM | wxEXPAND, FromDIP(10));
+			col->Add(row9, 0, wxBOTTOM | wxEXPAND, FromDIP(10));
+			col->Add(row10, 0, wxBOTTOM | wxEXPAND, FromDIP(10));
+			col->Add(row11, 0);
 
 			settingsPopup->setSizer(col);
 		}
@@ -42,6 +42,16 @@ bool MyApp::OnInit()
 	return true;
 }
 
+int MyApp::OnRun()
+{
+	int exitCode=wxApp::OnRun();
+	if(exitCode==0){
+		// outcome of the script played with KMRP_PLAY
+		exitCode=RecorderPlayerKM::getExitCode();
+	}
+	return exitCode;
+}
+
 void MyApp::OnClose(wxCloseEvent &event)
 {
 	//std::cout<<"closing app!\n";
@@ -0,0 +1,138 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* enum class MotionProfile                                           *
+* struct MotionStep                                                  *
+* class MotionSpec                                                   *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "motion_profile.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#define DEFAULT_STEPS 20
+#define DEFAULT_VELOCITY 2000
+
+//====================================================================
+
+static const char* const s_profileNames[int(MotionProfile::_LAST)]={
+	"legacy",
+	"instant",
+	"linear",
+	"ease",
+	"velocity",
+};
+
+//====================================================================
+
+MotionSpec::MotionSpec(MotionProfile profile, uint param)
+: m_profile(profile)
+, m_param(param)
+{
+	if(m_param==0){
+		if(m_profile==MotionProfile::LINEAR || m_profile==MotionProfile::EASE_IN_OUT){
+			m_param=DEFAULT_STEPS;
+		}
+		else if(m_profile==MotionProfile::VELOCITY){
+			m_param=DEFAULT_VELOCITY;
+		}
+	}
+}
+
+//--------------------------------------------------------------------
+
+const char* MotionSpec::name(MotionProfile profile)
+{
+	if(profile<MotionProfile::_LAST){
+		return s_profileNames[int(profile)];
+	}
+	return s_profileNames[0];
+}
+
+//--------------------------------------------------------------------
+
+std::string MotionSpec::toString() const
+{
+	std::string str=name(m_profile);
+	str.append(",");
+	str.append(std::to_string(m_param));
+	return str;
+}
+
+//--------------------------------------------------------------------
+
+MotionSpec MotionSpec::parse(std::string_view str)
+{
+	std::string_view name=str.substr(0, str.find(','));
+	for(int i=0; i<int(MotionProfile::_LAST); i++){
+		if(name==s_profileNames[i]){
+			uint param=0;
+			if(name.length()<str.length()){
+				std::from_chars(str.data()+name.length()+1, str.data()+str.length(), param);
+			}
+			return MotionSpec(MotionProfile(i), param);
+		}
+	}
+
+	return MotionSpec();
+}
+
+//--------------------------------------------------------------------
+
+std::vector<MotionStep> MotionSpec::steps(int dx, int dy) const
+{
+	std::vector<MotionStep> buffer;
+	if(dx==0 && dy==0){
+		return buffer;
+	}
+
+	uint total=1;
+	uint32_t period=STEP_PERIOD;
+	if(m_profile==MotionProfile::LINEAR || m_profile==MotionProfile::EASE_IN_OUT){
+		total=std::max(1u, m_param);
+	}
+	else if(m_profile==MotionProfile::VELOCITY){
+		double distance=std::hypot(dx, dy);
+		double duration=1e6*distance/std::max(1u, m_param);
+		total=std::max(1u, uint(std::ceil(duration/STEP_PERIOD)));
+		period=uint32_t(duration/total);
+	}
+
+	buffer.reserve(total);
+
+	// position error does not build up, each step goes to where the
+	// pointer has to be rather than adding rounded deltas
+	int lastX=0;
+	int lastY=0;
+	for(uint i=1; i<=total; i++){
+		double t=double(i)/total;
+		if(m_profile==MotionProfile::EASE_IN_OUT){
+			t=t*t*(3.0-2.0*t);
+		}
+
+		int x=int(std::lround(dx*t));
+		int y=int(std::lround(dy*t));
+		if(x!=lastX || y!=lastY){
+			buffer.push_back({x-lastX, y-lastY, (i-1)*period});
+		}
+		lastX=x;
+		lastY=y;
+	}
+
+	return buffer;
+}
+
+//====================================================================
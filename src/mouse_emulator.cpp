@@ -19,9 +19,14 @@
 #include "utilities.h"
 #include "debug_utils.h"
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <thread>
 
 #define MAX_TRIES 3000
+// the model is trusted if the pointer ends up this close to the target
+#define MODEL_TOLERANCE 4
 
 //====================================================================
 
@@ -83,12 +88,32 @@ void MouseEmulatorI::move(const int x, const int y)
 //--------------------------------------------------------------------
 
 void MouseEmulatorI::go2Position(const int absX, const int absY, ClientMousePosition getMousePosition)
+{
+	if(m_openLoop){
+		openLoopMove(absX, absY, getMousePosition);
+		return;
+	}
+
+	closedLoop(absX, absY, getMousePosition);
+}
+
+//--------------------------------------------------------------------
+
+void MouseEmulatorI::closedLoop(const int absX, const int absY, ClientMousePosition getMousePosition)
 {
 	int pX;
 	int pY;
 	getMousePosition(pX, pY);
 	int rX=absX-pX;
 	int rY=absY-pY;
+
+	if(!m_response.empty()){
+		// it should land on target, the loop below only mops up
+		jump(rX, rY);
+		getMousePosition(pX, pY);
+		rX=absX-pX;
+		rY=absY-pY;
+	}
 	int tries=0;
 	while((std::abs(rX/2)>0 || std::abs(rY/2)>0) && tries++<MAX_TRIES){
 		setPosition(rX/2, rY/2);
@@ -102,30 +127,101 @@ void MouseEmulatorI::go2Position(const int absX, const int absY, ClientMousePosi
 
 //--------------------------------------------------------------------
 
-void MouseEmulatorI::select(uint absX, uint absY, uint width, uint height, ClientMousePosition getMousePosition)
+void MouseEmulatorI::go2Position(const int absX, const int absY, ClientMousePosition getMousePosition, const MotionSpec& motion)
+{
+	if(motion.isLegacy()){
+		go2Position(absX, absY, getMousePosition);
+		return;
+	}
+
+	moveAbs(absX, absY, getMousePosition, motion);
+}
+
+//--------------------------------------------------------------------
+
+void MouseEmulatorI::select(uint absX, uint absY, uint width, uint height, ClientMousePosition getMousePosition, const MotionSpec& motion)
 {
 	dbg(absX, " + ", width, " : ", absY, " + ", height);
-	go2Position(absX, absY, getMousePosition);
+	go2Position(absX, absY, getMousePosition, motion);
 	buttonDown(MOUSE_BUTTONS::LEFT);
 	std::this_thread::sleep_for(std::chrono::milliseconds(25));
-	moveAbs(absX+width, absY+height, getMousePosition);
+	moveAbs(absX+width, absY+height, getMousePosition, motion);
 	buttonUp(MOUSE_BUTTONS::LEFT);
 }
 
 //--------------------------------------------------------------------
 
-void MouseEmulatorI::drag(uint startX, uint startY, uint endX, uint endY, ClientMousePosition getMousePosition)
+void MouseEmulatorI::drag(uint startX, uint startY, uint endX, uint endY, ClientMousePosition getMousePosition,
+						uint duration, const MotionSpec& motion)
 {
-	go2Position(startX, startY, getMousePosition);
+	go2Position(startX, startY, getMousePosition, motion);
 	buttonDown(MOUSE_BUTTONS::LEFT);
 	std::this_thread::sleep_for(std::chrono::milliseconds(25));
-	moveAbs(endX, endY, getMousePosition);
+	if(duration>0){
+		glide(endX, endY, duration, getMousePosition);
+	}
+	else{
+		moveAbs(endX, endY, getMousePosition, motion);
+	}
 	buttonUp(MOUSE_BUTTONS::LEFT);
 }
+
+//--------------------------------------------------------------------
+
+void MouseEmulatorI::glide(const int absX, const int absY, uint duration, ClientMousePosition getMousePosition)
+{
+	int startX;
+	int startY;
+	if(m_openLoop){
+		syncModel(getMousePosition);
+		startX=m_modelX;
+		startY=m_modelY;
+	}
+	else{
+		getMousePosition(startX, startY);
+	}
+
+	const int steps=std::max(1, int(duration/GLIDE_PERIOD));
+	const auto start=std::chrono::steady_clock::now();
+	const auto total=std::chrono::milliseconds(duration);
+
+	// where the pointer is believed to be in closed loop, steps do not
+	// wait (setPosition does), pointer acceleration is corrected every
+	// GLIDE_CHECK steps by reading the actual position
+	int pX=startX;
+	int pY=startY;
+	for(int i=1; i<steps; i++){
+		// where the pointer should be now
+		int targetX=startX+((absX-startX)*i)/steps;
+		int targetY=startY+((absY-startY)*i)/steps;
+		if(m_openLoop){
+			int dx=targetX-m_modelX;
+			int dy=targetY-m_modelY;
+			emitPixels(dx, dy);
+			moveStep(dx, dy);
+		}
+		else{
+			if(i%GLIDE_CHECK==0){
+				getMousePosition(pX, pY);
+			}
+			moveStep(targetX-pX, targetY-pY);
+			pX=targetX;
+			pY=targetY;
+		}
+		std::this_thread::sleep_until(start+(total*i)/steps);
+	}
+
+	go2Position(absX, absY, getMousePosition);
+}
 //--------------------------------------------------------------------
 
 void MouseEmulatorI::moveAbs(const int absX, const int absY, ClientMousePosition getMousePosition)
 {
+	if(m_openLoop){
+		openLoopMove(absX, absY, getMousePosition);
+		return;
+	}
+
 	int pX;
 	int pY;
 	getMousePosition(pX, pY);
@@ -163,4 +259,233 @@ void MouseEmulatorI::moveAbs(const int absX, const int absY, ClientMousePosition
 	setPosition(relX, relY);
 }
 
+//--------------------------------------------------------------------
+
+void MouseEmulatorI::moveAbs(const int absX, const int absY, ClientMousePosition getMousePosition, const MotionSpec& motion)
+{
+	if(motion.isLegacy()){
+		moveAbs(absX, absY, getMousePosition);
+		return;
+	}
+
+	if(m_openLoop){
+		syncModel(getMousePosition);
+		int dx=absX-m_modelX;
+		int dy=absY-m_modelY;
+		emitPixels(dx, dy);
+		playSteps(motion.steps(dx, dy));
+		verify(absX, absY, getMousePosition);
+		return;
+	}
+
+	int pX;
+	int pY;
+	getMousePosition(pX, pY);
+	playSteps(motion.steps(absX-pX, absY-pY));
+
+	// pointer acceleration may leave it a bit off, the rest of the
+	// way is travelled with the same motion
+	getMousePosition(pX, pY);
+	int passes=0;
+	while((pX!=absX || pY!=absY) && passes++<MOTION_PASSES){
+		playSteps(motion.steps(absX-pX, absY-pY));
+		getMousePosition(pX, pY);
+	}
+
+	if(pX!=absX || pY!=absY){
+		dbg("motion off by: ", absX-pX, ", ", absY-pY);
+		closedLoop(absX, absY, getMousePosition);
+	}
+}
+
+//--------------------------------------------------------------------
+
+void MouseEmulatorI::playSteps(const std::vector<MotionStep>& steps)
+{
+	const auto start=std::chrono::steady_clock::now();
+	for(const MotionStep& step : steps){
+		std::this_thread::sleep_until(start+std::chrono::microseconds(step.m_at));
+		moveStep(step.m_dx, step.m_dy);
+	}
+}
+
+//--------------------------------------------------------------------
+
+void MouseEmulatorI::setOpenLoop(bool openLoop)
+{
+	m_openLoop=openLoop;
+	m_modelValid=false;
+	// the pointer settings may have changed in the meantime
+	m_calibrated=false;
+}
+
+//--------------------------------------------------------------------
+
+void MouseEmulatorI::openLoopMove(const int absX, const int absY, ClientMousePosition getMousePosition)
+{
+	syncModel(getMousePosition);
+	int dx=absX-m_modelX;
+	int dy=absY-m_modelY;
+	if(!m_response.empty()){
+		jump(dx, dy);
+		m_modelX=absX;
+		m_modelY=absY;
+	}
+	else if(dx!=0 || dy!=0){
+		emitPixels(dx, dy);
+		playSteps(MotionSpec(MotionProfile::VELOCITY, OPEN_LOOP_SPEED).steps(dx, dy));
+	}
+	verify(absX, absY, getMousePosition);
+}
+
+//--------------------------------------------------------------------
+
+/*
+ * Convert a movement in pixels into device counts and account for it
+ * in the model. The pointer is always moved at OPEN_LOOP_SPEED or in
+ * small steps so pointer acceleration applies the gain that was
+ * measured by calibrate.
+ * */
+void MouseEmulatorI::emitPixels(int& dx, int& dy)
+{
+	const int countsX=int(std::lround(dx/m_gain));
+	const int countsY=int(std::lround(dy/m_gain));
+	m_modelX+=int(std::lround(countsX*m_gain));
+	m_modelY+=int(std::lround(countsY*m_gain));
+	dx=countsX;
+	dy=countsY;
+}
+
+//--------------------------------------------------------------------
+
+void MouseEmulatorI::calibrate(ClientMousePosition getMousePosition)
+{
+	int startX;
+	int startY;
+	getMousePosition(startX, startY);
+
+	// towards the centre of the screen, so the pointer is not stopped at an edge
+	const int direction=startX>=5*CALIBRATION_COUNTS ? -1 : 1;
+	playSteps(MotionSpec(MotionProfile::VELOCITY, OPEN_LOOP_SPEED).steps(direction*CALIBRATION_COUNTS, 0));
+
+	int endX;
+	int endY;
+	getMousePosition(endX, endY);
+
+	const double gain=std::abs(endX-startX)/double(CALIBRATION_COUNTS);
+	m_gain=(gain>0.2 && gain<5.0) ? gain : 1.0;
+	m_calibrated=true;
+	m_modelX=endX;
+	m_modelY=endY;
+	m_modelValid=true;
+
+	dbg("pointer gain: ", m_gain);
+}
+
+//--------------------------------------------------------------------
+
+void MouseEmulatorI::syncModel(ClientMousePosition getMousePosition)
+{
+	// the response curve supersedes the gain
+	if(!m_calibrated && m_response.empty()){
+		calibrate(getMousePosition);
+	}
+
+	if(!m_modelValid){
+		getMousePosition(m_modelX, m_modelY);
+		m_modelValid=true;
+	}
+}
+
+//--------------------------------------------------------------------
+
+void MouseEmulatorI::verify(const int absX, const int absY, ClientMousePosition getMousePosition)
+{
+	int pX;
+	int pY;
+	getMousePosition(pX, pY);
+	const int rX=absX-pX;
+	const int rY=absY-pY;
+
+	if(std::abs(rX)<=MODEL_TOLERANCE && std::abs(rY)<=MODEL_TOLERANCE){
+		if(rX!=0 || rY!=0){
+			setPosition(rX, rY);
+		}
+	}
+	else{
+		// the pointer was moved by somebody else or the gain is off
+		dbg("pointer model off by: ", rX, ", ", rY);
+		closedLoop(absX, absY, getMousePosition);
+	}
+
+	m_modelX=absX;
+	m_modelY=absY;
+	m_modelValid=true;
+}
+
+//--------------------------------------------------------------------
+
+/*
+ * Each event goes through setPosition, so it is followed by the same
+ * pause the response was measured with and pointer acceleration sees
+ * it as a single movement from rest.
+ * */
+void MouseEmulatorI::jump(const int dx, const int dy)
+{
+	const double limit=m_response.maxPixels();
+	double rX=dx;
+	double rY=dy;
+	double length=std::hypot(rX, rY);
+	int tries=0;
+	while(length>=1.0 && tries++<MAX_TRIES){
+		const double fraction=std::min(1.0, limit/length);
+		const double pX=rX*fraction;
+		const double pY=rY*fraction;
+		const double chunk=std::hypot(pX, pY);
+
+		// acceleration acts on the length of the movement, not per axis
+		const double scale=m_response.counts(chunk)/chunk;
+		setPosition(int(std::lround(pX*scale)), int(std::lround(pY*scale)));
+
+		rX-=pX;
+		rY-=pY;
+		length=std::hypot(rX, rY);
+	}
+}
+
+//--------------------------------------------------------------------
+
+bool MouseEmulatorI::calibrateResponse(ClientMousePosition getMousePosition, PointerResponse& response)
+{
+	static const int s_sizes[]={1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64, 96, 128};
+
+	int startX;
+	int startY;
+	getMousePosition(startX, startY);
+
+	// towards the centre of the screen, so the pointer is not stopped at an edge
+	const int direction=startX>=5*s_sizes[std::size(s_sizes)-1] ? -1 : 1;
+
+	response.clear();
+	int x0, y0, x1, y1;
+	for(int size : s_sizes){
+		double travel=0;
+		for(int i=0; i<RESPONSE_REPEATS; i++){
+			getMousePosition(x0, y0);
+			setPosition(direction*size, 0);
+			getMousePosition(x1, y1);
+			travel+=std::abs(x1-x0);
+			setPosition(-direction*size, 0);
+		}
+		response.addSample(size, travel/RESPONSE_REPEATS);
+		dbg("pointer response: ", size, " -> ", travel/RESPONSE_REPEATS);
+	}
+
+	m_response=response;
+	m_modelValid=false;
+	closedLoop(startX, startY, getMousePosition);
+
+	return !m_response.empty();
+}
+
 //====================================================================
@@ -0,0 +1,158 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class PointerResponse                                              *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "pointer_response.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+//====================================================================
+
+void PointerResponse::addSample(int counts, double pixels)
+{
+	// acceleration never moves the pointer back, drop noisy readings
+	if(counts<1 || pixels<=0){
+		return;
+	}
+	if(!m_samples.empty() && (counts<=m_samples.back().m_counts || pixels<=m_samples.back().m_pixels)){
+		return;
+	}
+	m_samples.push_back({counts, pixels});
+}
+
+//--------------------------------------------------------------------
+
+double PointerResponse::pixels(int counts) const
+{
+	if(empty()){
+		return counts;
+	}
+
+	const int sign=counts<0 ? -1 : 1;
+	counts*=sign;
+
+	// below the first sample the response is taken as linear
+	const Sample* low=&m_samples.front();
+	if(counts<=low->m_counts){
+		return sign*low->m_pixels*counts/low->m_counts;
+	}
+
+	for(size_t i=1; i<m_samples.size(); i++){
+		const Sample& high=m_samples[i];
+		if(counts<=high.m_counts){
+			double t=double(counts-low->m_counts)/(high.m_counts-low->m_counts);
+			return sign*(low->m_pixels+t*(high.m_pixels-low->m_pixels));
+		}
+		low=&high;
+	}
+
+	// beyond the last sample keep the slope of the last segment
+	const Sample& prev=m_samples[m_samples.size()-2];
+	double slope=(low->m_pixels-prev.m_pixels)/(low->m_counts-prev.m_counts);
+	return sign*(low->m_pixels+slope*(counts-low->m_counts));
+}
+
+//--------------------------------------------------------------------
+
+int PointerResponse::counts(double pixels) const
+{
+	if(empty()){
+		return int(std::lround(pixels));
+	}
+
+	const int sign=pixels<0 ? -1 : 1;
+	pixels*=sign;
+
+	const Sample* low=&m_samples.front();
+	if(pixels<=low->m_pixels){
+		return sign*int(std::lround(low->m_counts*pixels/low->m_pixels));
+	}
+
+	for(size_t i=1; i<m_samples.size(); i++){
+		const Sample& high=m_samples[i];
+		if(pixels<=high.m_pixels){
+			double t=(pixels-low->m_pixels)/(high.m_pixels-low->m_pixels);
+			return sign*int(std::lround(low->m_counts+t*(high.m_counts-low->m_counts)));
+		}
+		low=&high;
+	}
+
+	const Sample& prev=m_samples[m_samples.size()-2];
+	double slope=(low->m_counts-prev.m_counts)/(low->m_pixels-prev.m_pixels);
+	return sign*int(std::lround(low->m_counts+slope*(pixels-low->m_pixels)));
+}
+
+//--------------------------------------------------------------------
+
+double PointerResponse::maxPixels() const
+{
+	if(m_samples.empty()){
+		return 0;
+	}
+	return m_samples.back().m_pixels;
+}
+
+//--------------------------------------------------------------------
+
+int PointerResponse::maxCounts() const
+{
+	if(m_samples.empty()){
+		return 0;
+	}
+	return m_samples.back().m_counts;
+}
+
+//--------------------------------------------------------------------
+
+std::string PointerResponse::toString() const
+{
+	std::string str;
+	char buffer[32];
+	for(const Sample& sample : m_samples){
+		std::snprintf(buffer, sizeof(buffer), "%s%d/%.2f", str.empty() ? "" : ",", sample.m_counts, sample.m_pixels);
+		str.append(buffer);
+	}
+	return str;
+}
+
+//--------------------------------------------------------------------
+
+PointerResponse PointerResponse::parse(const char* str)
+{
+	PointerResponse response;
+	const char* p=str;
+	while(*p!='\0'){
+		char* end=nullptr;
+		long counts=std::strtol(p, &end, 10);
+		if(end==p || *end!='/'){
+			break;
+		}
+		p=end+1;
+		double pixels=std::strtod(p, &end);
+		if(end==p){
+			break;
+		}
+		response.addSample(int(counts), pixels);
+		p=end;
+		if(*p==','){
+			p++;
+		}
+	}
+
+	return response;
+}
+
+//====================================================================
@@ -0,0 +1,200 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class PreFlight                                                    *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "pre_flight.h"
+#include "input_command.h"
+#include "hid_manager.h"
+#include "window_registry.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <thread>
+
+//====================================================================
+
+namespace {
+
+struct ImageCheck
+{
+	std::string m_name;
+	std::vector<CtrlCommand*> m_commands;
+	bool m_exists=false;
+};
+
+//--------------------------------------------------------------------
+
+struct WindowCheck
+{
+	WindowId m_id;
+	size_t m_commands=0;
+	bool m_exists=false;
+};
+
+//--------------------------------------------------------------------
+
+// run @param check on every item, the items are shared out as the threads get free
+template<typename T, typename Func>
+void shareOut(std::vector<T>& items, uint workers, Func check)
+{
+	std::atomic<size_t> next(0);
+	auto worker=[&items, &next, &check](){
+		for(size_t i=next++; i<items.size(); i=next++){
+			check(items[i]);
+		}
+	};
+
+	workers=std::min<size_t>(workers, items.size());
+	std::vector<std::thread> threads;
+	for(uint i=1; i<workers; i++){
+		threads.emplace_back(worker);
+	}
+	worker();
+	for(std::thread& thread : threads){
+		thread.join();
+	}
+}
+
+//--------------------------------------------------------------------
+
+std::string usedBy(size_t commands)
+{
+	return commands==1 ? "used by 1 command" : "used by "+std::to_string(commands)+" commands";
+}
+
+}
+
+//====================================================================
+
+bool PreFlight::run(const std::vector<BaseCommand*>& commands, uint workers)
+{
+	TraceSpan span("preFlight", "script");
+
+	m_problems.clear();
+
+	if(workers==0){
+		workers=std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	// uinput devices are made again only if they are gone, X takes a
+	// while to pick up new ones; the handshake of TinyUSB may take seconds
+	bool connected=false;
+	std::thread interface([&connected](){
+		TraceSpan span("checkConnection", "script");
+		connected=(HIDManager::currentEmulator(HID_TARGET::UINPUT) && s_KeyboardEmulator->isActive())
+					|| HIDManager::checkConnection();
+	});
+
+	std::vector<ImageCheck> images;
+	std::vector<WindowCheck> windows;
+	{
+		std::map<std::string, size_t> imageIndex;
+		std::map<WindowId, size_t> windowIndex;
+		for(BaseCommand* command : commands){
+			if(command->getCmdType()==CommandInputTypes::CTRL){
+				CtrlCommand* ctrlCommand=static_cast<CtrlCommand*>(command);
+				auto it=imageIndex.emplace(ctrlCommand->getBaseImg(), images.size()).first;
+				if(it->second==images.size()){
+					images.emplace_back();
+					images.back().m_name=it->first;
+				}
+				images[it->second].m_commands.push_back(ctrlCommand);
+			}
+
+			WindowOffset* windowOffset=dynamic_cast<WindowOffset*>(command);
+			if(windowOffset && !windowOffset->isAbsolute()){
+				auto it=windowIndex.emplace(windowOffset->getWindowId(), windows.size()).first;
+				if(it->second==windows.size()){
+					windows.emplace_back();
+					windows.back().m_id=it->first;
+				}
+				windows[it->second].m_commands++;
+			}
+		}
+	}
+
+	shareOut(images, workers, [](ImageCheck& image){
+		image.m_exists=imageExists(image.m_name);
+	});
+
+	// the X ids found stay in the registry for the run
+	shareOut(windows, workers, [](WindowCheck& window){
+		window.m_exists=WindowRegistry::getWindowRegistry().exists(window.m_id);
+	});
+
+	interface.join();
+
+	for(ImageCheck& image : images){
+		for(CtrlCommand* command : image.m_commands){
+			command->setBaseImageExists(image.m_exists);
+		}
+		if(!image.m_exists){
+			m_problems.push_back({ERROR, "base image "+image.m_name+" is missing, "+usedBy(image.m_commands.size())});
+		}
+	}
+
+	for(WindowCheck& window : windows){
+		if(!window.m_exists){
+			std::string name=WindowRegistry::getWindowRegistry().name(window.m_id);
+			m_problems.push_back({WARNING, "window \""+name+"\" is not open, "+usedBy(window.m_commands)});
+		}
+	}
+
+	if(!connected){
+		m_problems.push_back({ERROR, "the input interface does not answer"});
+	}
+
+	// the first control command of the run does not wait for its image
+	for(BaseCommand* command : commands){
+		if(command->getCmdType()==CommandInputTypes::CTRL){
+			static_cast<CtrlCommand*>(command)->loadBaseImage();
+			break;
+		}
+	}
+
+	std::stable_sort(m_problems.begin(), m_problems.end(), [](const Problem& a, const Problem& b){
+		return a.m_severity>b.m_severity;
+	});
+
+	return !hasErrors();
+}
+
+//--------------------------------------------------------------------
+
+bool PreFlight::hasErrors() const
+{
+	for(const Problem& problem : m_problems){
+		if(problem.m_severity==ERROR){
+			return true;
+		}
+	}
+	return false;
+}
+
+//--------------------------------------------------------------------
+
+std::string PreFlight::report() const
+{
+	std::string report;
+	for(const Problem& problem : m_problems){
+		report.append(problem.m_severity==ERROR ? "Error: " : "Warning: ");
+		report.append(problem.m_message);
+		report.push_back('\n');
+	}
+	return report;
+}
+
+//====================================================================
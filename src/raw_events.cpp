@@ -0,0 +1,167 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* struct RawEvent                                                    *
+* std::vector<RawEvent> toRawEvents(...)                             *
+* std::string encodeRawEvents(...)                                   *
+* bool decodeRawEvents(...)                                          *
+* bool isPointerEvent(...)                                           *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "raw_events.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <linux/input.h>
+
+//====================================================================
+
+static const char s_base64[]="ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+//--------------------------------------------------------------------
+
+static int base64Value(char c)
+{
+	if(c>='A' && c<='Z'){
+		return c-'A';
+	}
+	if(c>='a' && c<='z'){
+		return c-'a'+26;
+	}
+	if(c>='0' && c<='9'){
+		return c-'0'+52;
+	}
+	if(c=='+'){
+		return 62;
+	}
+	if(c=='/'){
+		return 63;
+	}
+	return -1;
+}
+
+//--------------------------------------------------------------------
+
+bool isPointerEvent(const RawEvent& event)
+{
+	if(event.m_type==EV_REL){
+		return true;
+	}
+	return event.m_type==EV_KEY && event.m_code>=BTN_MOUSE && event.m_code<BTN_JOYSTICK;
+}
+
+//--------------------------------------------------------------------
+
+std::vector<RawEvent> toRawEvents(const std::vector<RawInputEvent>& captured)
+{
+	std::vector<RawEvent> events;
+	events.reserve(captured.size());
+
+	int64_t previous=captured.size()>0 ? captured.front().m_time : 0;
+	for(const RawInputEvent& rawInput : captured){
+		bool keep=rawInput.m_type==EV_KEY || rawInput.m_type==EV_REL
+				|| (rawInput.m_type==EV_SYN && rawInput.m_code==SYN_REPORT);
+		if(!keep){
+			continue;
+		}
+
+		// events of several devices are merged, keep them in order
+		int64_t delay=rawInput.m_time-previous;
+		if(delay<0){
+			delay=0;
+		}
+		previous=std::max(previous, rawInput.m_time);
+
+		events.push_back({uint32_t(delay), rawInput.m_type, rawInput.m_code, rawInput.m_value});
+	}
+
+	return events;
+}
+
+//--------------------------------------------------------------------
+
+std::string encodeRawEvents(const std::vector<RawEvent>& events)
+{
+	const unsigned char* data=reinterpret_cast<const unsigned char*>(events.data());
+	const size_t size=events.size()*sizeof(RawEvent);
+
+	std::string encoded;
+	encoded.reserve(((size+2)/3)*4);
+
+	for(size_t i=0; i<size; i+=3){
+		uint32_t chunk=data[i]<<16;
+		if(i+1<size){
+			chunk|=data[i+1]<<8;
+		}
+		if(i+2<size){
+			chunk|=data[i+2];
+		}
+
+		encoded.push_back(s_base64[(chunk>>18) & 0x3F]);
+		encoded.push_back(s_base64[(chunk>>12) & 0x3F]);
+		encoded.push_back(i+1<size ? s_base64[(chunk>>6) & 0x3F] : '=');
+		encoded.push_back(i+2<size ? s_base64[chunk & 0x3F] : '=');
+	}
+
+	return encoded;
+}
+
+//--------------------------------------------------------------------
+
+bool decodeRawEvents(const char* encoded, size_t length, std::vector<RawEvent>& events)
+{
+	events.clear();
+	if(length%4!=0){
+		return false;
+	}
+
+	std::vector<unsigned char> data;
+	data.reserve((length/4)*3);
+
+	for(size_t i=0; i<length; i+=4){
+		uint32_t chunk=0;
+		int padding=0;
+		for(size_t j=0; j<4; j++){
+			int value=0;
+			if(encoded[i+j]=='='){
+				padding++;
+			}
+			else{
+				value=base64Value(encoded[i+j]);
+				if(value<0 || padding>0){
+					return false;
+				}
+			}
+			chunk=(chunk<<6) | value;
+		}
+
+		data.push_back((chunk>>16) & 0xFF);
+		if(padding<2){
+			data.push_back((chunk>>8) & 0xFF);
+		}
+		if(padding<1){
+			data.push_back(chunk & 0xFF);
+		}
+	}
+
+	if(data.size()%sizeof(RawEvent)!=0){
+		return false;
+	}
+
+	events.resize(data.size()/sizeof(RawEvent));
+	std::memcpy(events.data(), data.data(), data.size());
+
+	return true;
+}
+
+//====================================================================
@@ -0,0 +1,242 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class RunReport                                                    *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "run_report.h"
+#include "input_command.h"
+#include "json_string.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+
+//====================================================================
+
+namespace {
+
+void writeCsvString(FILE* file, const std::string& str)
+{
+	std::fputc('"', file);
+	for(char c : str){
+		if(c=='"'){
+			std::fputc('"', file);
+		}
+		std::fputc(c, file);
+	}
+	std::fputc('"', file);
+}
+
+}
+
+//====================================================================
+
+void RunReport::begin()
+{
+	m_commandIds.clear();
+	m_descriptions.clear();
+	m_runs.clear();
+	m_begin=std::chrono::steady_clock::now();
+
+	char timeStamp[32];
+	std::time_t now=std::time(nullptr);
+	std::strftime(timeStamp, sizeof(timeStamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+	m_startedAt=timeStamp;
+}
+
+//--------------------------------------------------------------------
+
+double RunReport::elapsed() const
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()-m_begin).count();
+}
+
+//--------------------------------------------------------------------
+
+void RunReport::commandStarted(const BaseCommand* cmd, uint iteration)
+{
+	auto it=m_commandIds.find(cmd);
+	if(it==m_commandIds.end()){
+		it=m_commandIds.emplace(cmd, m_descriptions.size()).first;
+		m_descriptions.push_back(cmd->getDescription());
+	}
+
+	double now=elapsed();
+	m_runs.push_back({it->second, iteration, 0, ExitCode::OK, -1, now, now, false});
+}
+
+//--------------------------------------------------------------------
+
+void RunReport::commandPolled(const BaseCommand* cmd, bool done)
+{
+	if(m_runs.empty() || m_runs.back().m_done){
+		return;
+	}
+
+	CommandRun& run=m_runs.back();
+	run.m_polls++;
+
+	long difference=cmd->getDifference();
+	if(difference>-1){
+		run.m_difference=difference;
+	}
+
+	if(done){
+		run.m_end=elapsed();
+		run.m_exitCode=cmd->getExitCode();
+		run.m_done=true;
+	}
+}
+
+//--------------------------------------------------------------------
+
+RunReport::Latency RunReport::latency(std::vector<double>& values)
+{
+	Latency result{0, 0, 0, 0, 0};
+	if(values.empty()){
+		return result;
+	}
+
+	std::sort(values.begin(), values.end());
+
+	// nearest rank
+	auto percentile=[&values](double p){
+		size_t rank=size_t(std::ceil(p*values.size()/100.0));
+		return values[rank>0 ? rank-1 : 0];
+	};
+
+	double total=0;
+	for(double value : values){
+		total+=value;
+	}
+
+	result.m_p50=percentile(50);
+	result.m_p95=percentile(95);
+	result.m_p99=percentile(99);
+	result.m_max=values.back();
+	result.m_mean=total/values.size();
+
+	return result;
+}
+
+//--------------------------------------------------------------------
+
+bool RunReport::save(const std::string& basePath, const std::string& scriptName) const
+{
+	bool jsonOk=saveJson(basePath+".json", scriptName);
+	bool csvOk=saveCsv(basePath+".csv");
+	return jsonOk && csvOk;
+}
+
+//--------------------------------------------------------------------
+
+bool RunReport::saveJson(const std::string& filePath, const std::string& scriptName) const
+{
+	FILE* file=std::fopen(filePath.c_str(), "w");
+	if(file==nullptr){
+		return false;
+	}
+
+	std::vector<std::vector<double>> commandLatencies(m_descriptions.size());
+	std::vector<uint> commandFailures(m_descriptions.size(), 0);
+	std::vector<uint> commandPolls(m_descriptions.size(), 0);
+	std::vector<double> latencies;
+	uint failures=0;
+
+	// power of two buckets, the last one takes everything above 2^14 ms
+	constexpr int BUCKETS=16;
+	uint histogram[BUCKETS]={0};
+
+	for(const CommandRun& run : m_runs){
+		double runLatency=run.m_end-run.m_start;
+		commandLatencies[run.m_command].push_back(runLatency);
+		commandPolls[run.m_command]+=run.m_polls;
+		latencies.push_back(runLatency);
+		if(run.m_exitCode!=ExitCode::OK){
+			commandFailures[run.m_command]++;
+			failures++;
+		}
+
+		int bucket=0;
+		while(bucket<BUCKETS-1 && runLatency>=double(1<<bucket)){
+			bucket++;
+		}
+		histogram[bucket]++;
+	}
+
+	auto writeLatency=[file](const Latency& lat){
+		std::fprintf(file, "\"p50_ms\":%.3f,\"p95_ms\":%.3f,\"p99_ms\":%.3f,\"max_ms\":%.3f,\"mean_ms\":%.3f",
+					lat.m_p50, lat.m_p95, lat.m_p99, lat.m_max, lat.m_mean);
+	};
+
+	std::fputs("{\n\"script\":", file);
+	writeJsonString(file, scriptName);
+	std::fprintf(file, ",\n\"started\":\"%s\",\n\"duration_ms\":%.3f,\n\"commands\":%zu,\n\"runs\":%zu,\n\"failures\":%u,\n",
+				m_startedAt.c_str(), m_runs.empty() ? 0.0 : m_runs.back().m_end, m_descriptions.size(), m_runs.size(), failures);
+
+	std::fputs("\"latency\":{", file);
+	writeLatency(latency(latencies));
+	std::fputs("},\n\"histogram\":[", file);
+	for(int i=0; i<BUCKETS; i++){
+		if(i<BUCKETS-1){
+			std::fprintf(file, "%s{\"below_ms\":%i,\"count\":%u}", i>0 ? "," : "", 1<<i, histogram[i]);
+		}
+		else{
+			std::fprintf(file, ",{\"below_ms\":null,\"count\":%u}", histogram[i]);
+		}
+	}
+
+	std::fputs("],\n\"per_command\":[", file);
+	for(size_t i=0; i<m_descriptions.size(); i++){
+		std::fprintf(file, "%s\n{\"id\":%zu,\"description\":", i>0 ? "," : "", i);
+		writeJsonString(file, m_descriptions[i]);
+		std::fprintf(file, ",\"runs\":%zu,\"polls\":%u,\"failures\":%u,",
+					commandLatencies[i].size(), commandPolls[i], commandFailures[i]);
+		writeLatency(latency(commandLatencies[i]));
+		std::fputc('}', file);
+	}
+
+	std::fputs("\n],\n\"runs\":[", file);
+	for(size_t i=0; i<m_runs.size(); i++){
+		const CommandRun& run=m_runs[i];
+		std::fprintf(file, "%s\n{\"id\":%zu,\"iteration\":%u,\"start_ms\":%.3f,\"end_ms\":%.3f,\"polls\":%u,\"difference\":%ld,\"exit_code\":%i,\"finished\":%s}",
+					i>0 ? "," : "", run.m_command, run.m_iteration, run.m_start, run.m_end, run.m_polls,
+					run.m_difference, run.m_exitCode, run.m_done ? "true" : "false");
+	}
+	std::fputs("\n]\n}\n", file);
+
+	return std::fclose(file)==0;
+}
+
+//--------------------------------------------------------------------
+
+bool RunReport::saveCsv(const std::string& filePath) const
+{
+	FILE* file=std::fopen(filePath.c_str(), "w");
+	if(file==nullptr){
+		return false;
+	}
+
+	std::fputs("id,description,iteration,start_ms,end_ms,latency_ms,polls,difference,exit_code\n", file);
+	for(const CommandRun& run : m_runs){
+		std::fprintf(file, "%zu,", run.m_command);
+		writeCsvString(file, m_descriptions[run.m_command]);
+		std::fprintf(file, ",%u,%.3f,%.3f,%.3f,%u,%ld,%i\n", run.m_iteration, run.m_start, run.m_end,
+					run.m_end-run.m_start, run.m_polls, run.m_difference, run.m_exitCode);
+	}
+
+	return std::fclose(file)==0;
+}
+
+//====================================================================
@@ -0,0 +1,407 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class ScriptJournal                                                *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "script_journal.h"
+#include "debug_utils.h"
+#include "trace.h"
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+//====================================================================
+
+namespace {
+
+constexpr const char* LOG_HEADER="kmrp-journal";
+constexpr const char* LOG_EXT=".journal";
+constexpr const char* TMP_EXT=".tmp";
+
+//--------------------------------------------------------------------
+
+std::string header(uint64_t baseHash)
+{
+	char line[48];
+	std::snprintf(line, sizeof(line), "%s %016llx\n", LOG_HEADER, static_cast<unsigned long long>(baseHash));
+	return line;
+}
+
+//--------------------------------------------------------------------
+
+// hidden file .name@param extension next to @param filePath
+std::string sideFile(const std::string& filePath, const char* extension)
+{
+	std::filesystem::path path(filePath);
+	return (path.parent_path()/("."+path.filename().string()+extension)).string();
+}
+
+//--------------------------------------------------------------------
+
+bool writeAll(int fd, std::string_view data)
+{
+	while(data.length()>0){
+		ssize_t written=write(fd, data.data(), data.length());
+		if(written<0){
+			return false;
+		}
+		data.remove_prefix(written);
+	}
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+// a new or renamed file is only durable once its directory is
+void syncDirectory(const std::string& filePath)
+{
+	std::string directory=std::filesystem::path(filePath).parent_path().string();
+	int fd=open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY);
+	if(fd>-1){
+		fsync(fd);
+		close(fd);
+	}
+}
+
+//--------------------------------------------------------------------
+
+struct Operation
+{
+	char m_type;
+	size_t m_index;
+	std::string_view m_line;
+};
+
+//--------------------------------------------------------------------
+
+bool parseOperation(std::string_view entry, Operation& operation)
+{
+	if(entry.length()<3 || entry[1]!=' '){
+		return false;
+	}
+
+	operation.m_type=entry[0];
+	const char* end=entry.data()+entry.length();
+	auto result=std::from_chars(entry.data()+2, end, operation.m_index);
+	if(result.ec!=std::errc()){
+		return false;
+	}
+
+	if(operation.m_type=='a' || operation.m_type=='m'){
+		if(result.ptr==end || *result.ptr!=' '){
+			return false;
+		}
+		operation.m_line=std::string_view(result.ptr+1, end-result.ptr-1);
+		return true;
+	}
+
+	return result.ptr==end && (operation.m_type=='r' || operation.m_type=='s');
+}
+
+//--------------------------------------------------------------------
+
+// the whole batch or nothing, a batch that does not fit is a corrupt log
+bool applyBatch(const std::vector<Operation>& batch, std::vector<std::string>& lines)
+{
+	size_t size=lines.size();
+	for(const Operation& operation : batch){
+		switch(operation.m_type)
+		{
+			case 'a':
+				if(operation.m_index>size){
+					return false;
+				}
+				size++;
+				break;
+			case 'r':
+				if(operation.m_index>=size){
+					return false;
+				}
+				size--;
+				break;
+			case 's':
+				if(operation.m_index+1>=size){
+					return false;
+				}
+				break;
+			default:
+				if(operation.m_index>=size){
+					return false;
+				}
+		}
+	}
+
+	for(const Operation& operation : batch){
+		switch(operation.m_type)
+		{
+			case 'a':
+				lines.emplace(lines.begin()+operation.m_index, operation.m_line);
+				break;
+			case 'r':
+				lines.erase(lines.begin()+operation.m_index);
+				break;
+			case 's':
+				lines[operation.m_index].swap(lines[operation.m_index+1]);
+				break;
+			default:
+				lines[operation.m_index]=operation.m_line;
+		}
+	}
+
+	return true;
+}
+
+}
+
+//====================================================================
+
+ScriptJournal::ScriptJournal()
+: m_baseHash(0)
+, m_logBytes(0)
+, m_attached(false)
+{
+}
+
+//--------------------------------------------------------------------
+
+void ScriptJournal::attach(const std::string& scriptPath, uint64_t baseHash, size_t logBytes)
+{
+	m_scriptPath=scriptPath;
+	m_baseHash=baseHash;
+	m_logBytes=logBytes;
+	m_pending.clear();
+	m_attached=true;
+}
+
+//--------------------------------------------------------------------
+
+void ScriptJournal::detach()
+{
+	m_scriptPath.clear();
+	m_pending.clear();
+	m_logBytes=0;
+	m_attached=false;
+}
+
+//--------------------------------------------------------------------
+
+void ScriptJournal::append(char operation, size_t index, std::string_view line)
+{
+	if(!m_attached){
+		return;
+	}
+
+	char prefix[32];
+	int length=std::snprintf(prefix, sizeof(prefix), "%c %zu", operation, index);
+	m_pending.append(prefix, length);
+	if(operation=='a' || operation=='m'){
+		m_pending.push_back(' ');
+		m_pending.append(line);
+	}
+	m_pending.push_back('\n');
+}
+
+//--------------------------------------------------------------------
+
+void ScriptJournal::add(size_t index, std::string_view line)
+{
+	append('a', index, line);
+}
+
+//--------------------------------------------------------------------
+
+void ScriptJournal::remove(size_t index)
+{
+	append('r', index);
+}
+
+//--------------------------------------------------------------------
+
+void ScriptJournal::swap(size_t index)
+{
+	append('s', index);
+}
+
+//--------------------------------------------------------------------
+
+void ScriptJournal::modify(size_t index, std::string_view line)
+{
+	append('m', index, line);
+}
+
+//--------------------------------------------------------------------
+
+bool ScriptJournal::commit()
+{
+	if(!m_attached){
+		return false;
+	}
+
+	if(m_pending.length()==0){
+		return true;
+	}
+
+	TraceSpan span("journalCommit", "script");
+
+	std::string logFile=logPath(m_scriptPath);
+	int fd=open(logFile.c_str(), O_WRONLY | O_CREAT, 0644);
+	if(fd<0){
+		debugWarning("cannot open ", logFile);
+		return false;
+	}
+
+	std::string batch;
+	if(m_logBytes==0){
+		batch=header(m_baseHash);
+	}
+	batch.append(m_pending);
+	batch.append("c\n");
+
+	// drop whatever follows the last commit: a torn batch or a stale log
+	bool result=ftruncate(fd, m_logBytes)==0 && lseek(fd, 0, SEEK_END)>-1
+				&& writeAll(fd, batch) && fsync(fd)==0;
+	close(fd);
+
+	if(!result){
+		debugWarning("cannot write ", logFile);
+		return false;
+	}
+
+	if(m_logBytes==0){
+		syncDirectory(logFile);
+	}
+
+	m_logBytes+=batch.length();
+	m_pending.clear();
+
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+std::string ScriptJournal::logPath(const std::string& scriptPath)
+{
+	return sideFile(scriptPath, LOG_EXT);
+}
+
+//--------------------------------------------------------------------
+
+bool ScriptJournal::hasLog(const std::string& scriptPath)
+{
+	std::error_code ec;
+	return std::filesystem::exists(logPath(scriptPath), ec);
+}
+
+//--------------------------------------------------------------------
+
+void ScriptJournal::removeLog(const std::string& scriptPath)
+{
+	std::error_code ec;
+	std::filesystem::remove(logPath(scriptPath), ec);
+}
+
+//--------------------------------------------------------------------
+
+uint64_t ScriptJournal::contentHash(std::string_view data)
+{
+	// FNV-1a
+	uint64_t hash=0xcbf29ce484222325ULL;
+	for(unsigned char c : data){
+		hash^=c;
+		hash*=0x100000001b3ULL;
+	}
+	return hash;
+}
+
+//--------------------------------------------------------------------
+
+bool ScriptJournal::replay(const std::string& scriptPath, uint64_t baseHash, std::vector<std::string>& lines, size_t& logBytes)
+{
+	logBytes=0;
+
+	std::ifstream logFile(logPath(scriptPath), std::ifstream::in | std::ifstream::binary);
+	if(!logFile.is_open()){
+		return false;
+	}
+	std::string log((std::istreambuf_iterator<char>(logFile)), std::istreambuf_iterator<char>());
+
+	std::string expected=header(baseHash);
+	if(log.compare(0, expected.length(), expected)!=0){
+		dbg("journal of another version of ", scriptPath);
+		return false;
+	}
+
+	std::vector<Operation> batch;
+	size_t begin=expected.length();
+	while(begin<log.length()){
+		size_t end=log.find('\n', begin);
+		if(end==std::string::npos){
+			break;
+		}
+		std::string_view entry(log.data()+begin, end-begin);
+		begin=end+1;
+
+		if(entry=="c"){
+			if(!applyBatch(batch, lines)){
+				break;
+			}
+			batch.clear();
+			logBytes=begin;
+			continue;
+		}
+
+		Operation operation;
+		if(!parseOperation(entry, operation)){
+			break;
+		}
+		batch.push_back(operation);
+	}
+
+	if(logBytes<log.length()){
+		debugWarning("journal of ", scriptPath, " ends with an incomplete save");
+	}
+
+	return logBytes>0;
+}
+
+//--------------------------------------------------------------------
+
+bool ScriptJournal::replaceFile(const std::string& filePath, std::string_view data)
+{
+	std::string tmpFile=sideFile(filePath, TMP_EXT);
+	int fd=open(tmpFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if(fd<0){
+		return false;
+	}
+
+	bool result=writeAll(fd, data) && fsync(fd)==0;
+	close(fd);
+
+	if(!result || std::rename(tmpFile.c_str(), filePath.c_str())!=0){
+		std::remove(tmpFile.c_str());
+		return false;
+	}
+
+	syncDirectory(filePath);
+
+	return true;
+}
+
+//====================================================================
@@ -0,0 +1,321 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class ScriptLoader                                                 *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "script_loader.h"
+#include "command_parser.h"
+#include "field_split.h"
+#include "script_journal.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <map>
+#include <string_view>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//====================================================================
+
+namespace {
+
+// ranges smaller than this are not worth a thread
+constexpr size_t MIN_RANGE=64*1024;
+
+//--------------------------------------------------------------------
+
+class MappedFile
+{
+	public:
+		MappedFile(const char* filePath)
+		: m_data(nullptr)
+		, m_size(0)
+		, m_open(false)
+		{
+			int fd=open(filePath, O_RDONLY);
+			if(fd<0){
+				return;
+			}
+
+			struct stat fileStat;
+			if(fstat(fd, &fileStat)==0){
+				m_size=fileStat.st_size;
+				// nothing to map in an empty file
+				m_open=m_size==0;
+				if(m_size>0){
+					m_data=mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+					m_open=m_data!=MAP_FAILED;
+					if(m_open){
+						madvise(m_data, m_size, MADV_SEQUENTIAL);
+					}
+					else{
+						m_data=nullptr;
+					}
+				}
+			}
+			close(fd);
+		}
+
+		~MappedFile()
+		{
+			if(m_data){
+				munmap(m_data, m_size);
+			}
+		}
+
+		bool isOpen() const
+		{
+			return m_open;
+		}
+
+		std::string_view data() const
+		{
+			if(m_data){
+				return std::string_view(static_cast<const char*>(m_data), m_size);
+			}
+			return std::string_view();
+		}
+
+	private:
+		void* m_data;
+		size_t m_size;
+		bool m_open;
+};
+
+//--------------------------------------------------------------------
+
+struct Range
+{
+	std::string_view m_data;
+	std::vector<ScriptEntry> m_entries;
+	std::string m_error;
+	int m_lines=0;
+	int m_nonEmptyLines=0;
+	bool m_failed=false;
+};
+
+//--------------------------------------------------------------------
+
+void parseRange(Range& range)
+{
+	std::string error;
+	size_t begin=0;
+	while(begin<range.m_data.length()){
+		size_t end=range.m_data.find('\n', begin);
+		if(end==std::string_view::npos){
+			end=range.m_data.length();
+		}
+		std::string_view line=range.m_data.substr(begin, end-begin);
+		begin=end+1;
+		range.m_lines++;
+
+		if(line.length()==0){
+			continue;
+		}
+		range.m_nonEmptyLines++;
+
+		try{
+			if(line.find("loop:")==0){
+				FieldSplit<2> parts(line, ":");
+				int times=parts.number<int>(1);
+				if(!parts.ok()){
+					range.m_error="loop "+parts.errorMessage();
+					range.m_failed=true;
+					return;
+				}
+				range.m_entries.push_back({ScriptEntry::LOOP, times, nullptr});
+				continue;
+			}
+
+			if(line.find("end_loop")==0){
+				range.m_entries.push_back({ScriptEntry::END_LOOP, 0, nullptr});
+				continue;
+			}
+
+			// the base images are checked once the whole file is parsed
+			error.clear();
+			BaseCommand* command=ParserBuilder(line, &error, false);
+			if(command){
+				range.m_entries.push_back({ScriptEntry::COMMAND, 0, command});
+			}
+			else if(error.length()>0){
+				range.m_error=error;
+				range.m_failed=true;
+				return;
+			}
+		}
+		catch(...){
+			range.m_failed=true;
+			return;
+		}
+	}
+}
+
+}
+
+//====================================================================
+
+ScriptLoader::~ScriptLoader()
+{
+	clear();
+}
+
+//--------------------------------------------------------------------
+
+void ScriptLoader::clear()
+{
+	for(ScriptEntry& entry : m_entries){
+		delete entry.m_command;
+	}
+	m_entries.clear();
+}
+
+//--------------------------------------------------------------------
+
+std::vector<ScriptEntry> ScriptLoader::takeEntries()
+{
+	std::vector<ScriptEntry> entries;
+	entries.swap(m_entries);
+	return entries;
+}
+
+//--------------------------------------------------------------------
+
+bool ScriptLoader::load(const char* filePath, uint workers)
+{
+	TraceSpan span("loadScript", "script", filePath);
+
+	clear();
+	m_error.clear();
+
+	MappedFile file(filePath);
+	if(!file.isOpen()){
+		m_error="cannot read the file";
+		return false;
+	}
+
+	std::string_view data=file.data();
+	m_baseHash=ScriptJournal::contentHash(data);
+	m_logBytes=0;
+	m_lineCount=0;
+
+	// edits saved after the last full save
+	std::string replayed;
+	if(ScriptJournal::hasLog(filePath)){
+		std::vector<std::string> lines;
+		size_t begin=0;
+		while(begin<data.length()){
+			size_t end=data.find('\n', begin);
+			if(end==std::string_view::npos){
+				end=data.length();
+			}
+			if(end>begin){
+				lines.emplace_back(data.substr(begin, end-begin));
+			}
+			begin=end+1;
+		}
+
+		if(ScriptJournal::replay(filePath, m_baseHash, lines, m_logBytes)){
+			replayed.reserve(data.length());
+			for(const std::string& line : lines){
+				replayed.append(line);
+				replayed.push_back('\n');
+			}
+			data=replayed;
+		}
+	}
+
+	if(workers==0){
+		workers=std::max(1u, std::thread::hardware_concurrency());
+	}
+	workers=std::min<size_t>(workers, 1+data.length()/MIN_RANGE);
+
+	// whole lines only, a range ends right after a new line
+	std::vector<Range> ranges(workers);
+	size_t begin=0;
+	for(uint i=0; i<workers; i++){
+		size_t end=data.length();
+		if(i+1<workers){
+			end=data.find('\n', std::max(begin, ((i+1)*data.length())/workers));
+			end=(end==std::string_view::npos) ? data.length() : end+1;
+		}
+		ranges[i].m_data=data.substr(begin, end-begin);
+		begin=end;
+	}
+
+	std::vector<std::thread> threads;
+	for(uint i=1; i<workers; i++){
+		threads.emplace_back(parseRange, std::ref(ranges[i]));
+	}
+	parseRange(ranges[0]);
+	for(std::thread& thread : threads){
+		thread.join();
+	}
+
+	size_t total=0;
+	int lineNumber=0;
+	for(Range& range : ranges){
+		if(range.m_failed && m_error.length()==0){
+			m_error="line "+std::to_string(lineNumber+range.m_lines);
+			if(range.m_error.length()>0){
+				m_error+=", "+range.m_error;
+			}
+		}
+		lineNumber+=range.m_lines;
+		m_lineCount+=range.m_nonEmptyLines;
+		total+=range.m_entries.size();
+	}
+
+	m_entries.reserve(total);
+	for(Range& range : ranges){
+		m_entries.insert(m_entries.end(), range.m_entries.begin(), range.m_entries.end());
+	}
+
+	if(m_error.length()>0){
+		clear();
+		return false;
+	}
+
+	checkImages();
+
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+void ScriptLoader::checkImages()
+{
+	TraceSpan span("checkImages", "script");
+
+	// scripts use a handful of images many times
+	std::map<std::string, std::vector<CtrlCommand*>> images;
+	for(ScriptEntry& entry : m_entries){
+		if(entry.m_command && entry.m_command->getCmdType()==CommandInputTypes::CTRL){
+			CtrlCommand* command=static_cast<CtrlCommand*>(entry.m_command);
+			images[command->getBaseImg()].push_back(command);
+		}
+	}
+
+	for(auto& image : images){
+		bool exists=imageExists(image.first);
+		for(CtrlCommand* command : image.second){
+			command->setBaseImageExists(exists);
+		}
+	}
+}
+
+//====================================================================
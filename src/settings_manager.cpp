@@ -37,24 +37,44 @@ bool SettingsManager::loadSettings()
 				if(infoLine.length()==0){
 					continue;
 				}
-				CstrSplit<10> parts(infoLine.c_str(), ":");
-				try{
-					m_timeDelay=std::atoi(parts[0]);
-					m_timePadding=std::atoi(parts[1]);
-					m_transparency=std::atoi(parts[2]);
-					m_screenshotTimeout=std::atoi(parts[3]);
-					m_brushColour=parts[4];
-					m_interface=InterfaceLink(std::atoi(parts[5]));
-					m_serialPort=parts[6];
-					m_baudRate=std::atoi(parts[7]);
-					m_ip=parts[8];
-					m_port=std::atoi(parts[9]);
-					break;
+				FieldSplit<20> parts(infoLine, ":");
+				// files saved by older versions have blank fields at the end
+				auto isSet=[&parts](int i){
+					return parts.has(i) && parts[i].length()>0 && parts[i][0]!=' ';
+				};
+
+				m_timeDelay=parts.number<int>(0);
+				m_timePadding=parts.number<int>(1);
+				m_transparency=parts.number<int>(2);
+				m_screenshotTimeout=parts.number<int>(3);
+				m_brushColour=parts.str(4);
+				m_interface=InterfaceLink(parts.number<int>(5));
+				m_serialPort=parts.str(6);
+				m_baudRate=parts.number<int>(7);
+				m_ip=parts.str(8);
+				m_port=parts.number<int>(9);
+				if(isSet(10) && isSet(11)){
+					setSampleFormat(parts.number<int>(10));
+					setBaseImageFormat(parts.number<int>(11));
 				}
-				catch(...)
-				{
-					continue;
+				if(isSet(12) && isSet(13)){
+					m_fastTyping=parts.number<int>(12)>0;
+					m_typingRate=parts.number<int>(13);
+				}
+				if(isSet(14) && isSet(15)){
+					setMotion(parts.number<int>(14), parts.number<int>(15));
+				}
+				if(isSet(16)){
+					m_openLoopMouse=parts.number<int>(16)>0;
+				}
+				if(isSet(17)){
+					m_pointerResponse=parts.str(17);
+				}
+
+				if(parts.ok()){
+					break;
 				}
+				debugWarning("settings ", parts.errorMessage());
 			}
 			settingsFile.close();
 			s_colour=wxColor(m_brushColour);
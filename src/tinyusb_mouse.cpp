@@ -15,6 +15,7 @@
 **********************************************************************/
 #include "tinyusb_mouse.h"
 #include "debug_utils.h"
+#include <algorithm>
 #include <cstdint>
 
 //====================================================================
@@ -93,3 +94,19 @@ void TinyusbMouse::buttonUp(MOUSE_BUTTONS btn)
 }
 
 //--------------------------------------------------------------------
+
+void TinyusbMouse::wheel(const int vertical, const int horizontal)
+{
+	// a report carries at most 127 ticks per wheel
+	int v=vertical;
+	int h=horizontal;
+	while(v!=0 || h!=0){
+		int sv=std::max(-127, std::min(127, v));
+		int sh=std::max(-127, std::min(127, h));
+		sendMouseData(0, 0, sv, sh);
+		v-=sv;
+		h-=sh;
+	}
+}
+
+//--------------------------------------------------------------------
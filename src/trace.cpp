@@ -0,0 +1,140 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class Tracer                                                       *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "trace.h"
+#include "json_string.h"
+
+#include <cstdio>
+
+//====================================================================
+
+void Tracer::setEnabled(bool enabled)
+{
+	m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------------
+
+Tracer::ThreadBuffer& Tracer::threadBuffer()
+{
+	// the tracer keeps the buffer alive after its thread is gone
+	thread_local std::shared_ptr<ThreadBuffer> t_buffer;
+
+	if(!t_buffer){
+		t_buffer=std::make_shared<ThreadBuffer>();
+		std::lock_guard<std::mutex> lock(m_mutex);
+		t_buffer->m_tid=m_buffers.size()+1;
+		m_buffers.push_back(t_buffer);
+	}
+
+	return *t_buffer;
+}
+
+//--------------------------------------------------------------------
+
+void Tracer::record(const TraceEvent& event)
+{
+	ThreadBuffer& buffer=threadBuffer();
+
+	std::lock_guard<std::mutex> lock(buffer.m_mutex);
+	if(buffer.m_events.size()<MAX_EVENTS){
+		buffer.m_events.push_back(event);
+	}
+	else{
+		buffer.m_dropped++;
+	}
+}
+
+//--------------------------------------------------------------------
+
+void Tracer::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for(auto& buffer : m_buffers){
+		std::lock_guard<std::mutex> bufferLock(buffer->m_mutex);
+		buffer->m_events.clear();
+		buffer->m_dropped=0;
+	}
+}
+
+//--------------------------------------------------------------------
+
+size_t Tracer::size()
+{
+	size_t total=0;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for(auto& buffer : m_buffers){
+		std::lock_guard<std::mutex> bufferLock(buffer->m_mutex);
+		total+=buffer->m_events.size();
+	}
+	return total;
+}
+
+//--------------------------------------------------------------------
+
+size_t Tracer::dropped()
+{
+	size_t total=0;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for(auto& buffer : m_buffers){
+		std::lock_guard<std::mutex> bufferLock(buffer->m_mutex);
+		total+=buffer->m_dropped;
+	}
+	return total;
+}
+
+//--------------------------------------------------------------------
+
+bool Tracer::dump(const char* filePath)
+{
+	FILE* file=std::fopen(filePath, "w");
+	if(file==nullptr){
+		return false;
+	}
+
+	std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+
+	bool first=true;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for(auto& buffer : m_buffers){
+		std::lock_guard<std::mutex> bufferLock(buffer->m_mutex);
+
+		std::fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+					first ? "" : ",", buffer->m_tid, buffer->m_tid);
+		first=false;
+
+		for(const TraceEvent& event : buffer->m_events){
+			std::fputs(",\n{\"name\":", file);
+			writeJsonString(file, event.m_name);
+			std::fputs(",\"cat\":", file);
+			writeJsonString(file, event.m_category);
+			// Chrome trace timestamps are in microseconds
+			std::fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+						buffer->m_tid, event.m_start/1000.0, event.m_duration/1000.0);
+			if(event.m_detail[0]!='\0'){
+				std::fputs(",\"args\":{\"detail\":", file);
+				writeJsonString(file, event.m_detail);
+				std::fputc('}', file);
+			}
+			std::fputc('}', file);
+		}
+	}
+
+	std::fputs("\n]}\n", file);
+
+	return std::fclose(file)==0;
+}
+
+//====================================================================
@@ -0,0 +1,85 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* struct PointerSample                                               *
+* std::vector<PointerSample> simplifyTrajectory(...)                 *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "trajectory.h"
+
+#include <cmath>
+#include <utility>
+
+//====================================================================
+
+// synchronized euclidean distance of @param p to the segment (a, b)
+static double timedDistance(const PointerSample& a, const PointerSample& b, const PointerSample& p)
+{
+	double ratio=0.0;
+	if(b.m_time>a.m_time){
+		ratio=double(p.m_time-a.m_time)/double(b.m_time-a.m_time);
+	}
+
+	double x=a.m_x+ratio*(b.m_x-a.m_x);
+	double y=a.m_y+ratio*(b.m_y-a.m_y);
+
+	return std::hypot(p.m_x-x, p.m_y-y);
+}
+
+//--------------------------------------------------------------------
+
+std::vector<PointerSample> simplifyTrajectory(const std::vector<PointerSample>& path, double tolerance)
+{
+	if(path.size()<3){
+		return path;
+	}
+
+	std::vector<bool> keep(path.size(), false);
+	keep.front()=true;
+	keep.back()=true;
+
+	// segments pending of split, no recursion on long paths
+	std::vector<std::pair<size_t, size_t>> segments;
+	segments.push_back({0, path.size()-1});
+
+	while(segments.size()>0){
+		auto [first, last]=segments.back();
+		segments.pop_back();
+
+		double maxDistance=0.0;
+		size_t index=first;
+		for(size_t i=first+1; i<last; i++){
+			double distance=timedDistance(path[first], path[last], path[i]);
+			if(distance>maxDistance){
+				maxDistance=distance;
+				index=i;
+			}
+		}
+
+		if(maxDistance>tolerance){
+			keep[index]=true;
+			segments.push_back({first, index});
+			segments.push_back({index, last});
+		}
+	}
+
+	std::vector<PointerSample> waypoints;
+	for(size_t i=0; i<path.size(); i++){
+		if(keep[i]){
+			waypoints.push_back(path[i]);
+		}
+	}
+
+	return waypoints;
+}
+
+//====================================================================
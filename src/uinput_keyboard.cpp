@@ -14,21 +14,37 @@
 * Author:  Dan Machado                                               *
 **********************************************************************/
 #include "uinput_keyboard.h"
+#include "utilities.h"
 #include "key_map.h"
 #include "debug_utils.h"
 
 #include <thread>
+#include <atomic>
 #include <cstring>
+#include <filesystem>
 
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 
-#define KEYBOARD_NAME "AutomaticTester keyboard"
+
+//====================================================================
+
+// the same name for the whole session, see uinputDeviceName
+static const char* keyboardName()
+{
+	static const std::string name=uinputDeviceName("keyboard");
+	return name.c_str();
+}
 
 //====================================================================
 
 UinputKeyboard::UinputKeyboard()
 : m_fd(-1)
+, m_batch(m_fd)
+, m_keyPeriod(0)
+, m_fastMode(false)
+, m_inSequence(false)
 {
 	m_shortcutParserKeyMapPtr=&shortcutParserKeyMap;
 	reload();
@@ -59,7 +75,7 @@ bool UinputKeyboard::reload()
 			for(const auto& [key, value] : uinputKeyMap){
 				ioctl(m_fd, UI_SET_KEYBIT, value);
 			}
-			init(KEYBOARD_NAME);
+			init(keyboardName());
 		}			
 	}
 
@@ -83,27 +99,13 @@ void UinputKeyboard::init(const char* deviceName)
 
 //--------------------------------------------------------------------
 
-bool UinputKeyboard::emit(int type, int code, int val)
-{
-   m_inputEvent.type = type;
-   m_inputEvent.code = code;
-   m_inputEvent.value = val;
-   // timestamp values below are ignored
-   m_inputEvent.time.tv_sec = 0;
-   m_inputEvent.time.tv_usec = 0;
-
-   return 0<write(m_fd, &m_inputEvent, sizeof(m_inputEvent));
-}
-
-//--------------------------------------------------------------------
-
 void UinputKeyboard::sendKey(int hidCode)
 {
    emit(EV_KEY, hidCode, 1);
 	emit(EV_SYN, SYN_REPORT, 0);
 	emit(EV_KEY, hidCode, 0);
 	emit(EV_SYN, SYN_REPORT, 0);
-	std::this_thread::sleep_for(std::chrono::milliseconds(15));
+	keyDone();
 }
 
 //--------------------------------------------------------------------
@@ -116,7 +118,7 @@ void UinputKeyboard::sendKey(int hidCode1, int hidCode2)
 	emit(EV_KEY, hidCode1, 0);
 	emit(EV_KEY, hidCode2, 0);
 	emit(EV_SYN, SYN_REPORT, 0);
-	std::this_thread::sleep_for(std::chrono::milliseconds(15));
+	keyDone();
 }
 
 //--------------------------------------------------------------------
@@ -138,8 +140,142 @@ void UinputKeyboard::sendKey(int hidCode1, int hidCode2, int hidCode3, int hidCo
 		emit(EV_KEY, codes[i], 0);
 	}
 	emit(EV_SYN, SYN_REPORT, 0);
+	keyDone();
+}
+
+//--------------------------------------------------------------------
+
+void UinputKeyboard::keyDone()
+{
+	if(!m_fastMode){
+		flush();
+		std::this_thread::sleep_for(std::chrono::milliseconds(15));
+		return;
+	}
+
+	if(m_keyPeriod.count()>0){
+		auto now=std::chrono::steady_clock::now();
+		if(m_nextKey>now){
+			std::this_thread::sleep_until(m_nextKey);
+		}
+		else{
+			m_nextKey=now;
+		}
+		m_nextKey+=m_keyPeriod;
+		flush();
+	}
+	else if(!m_inSequence){
+		flush();
+	}
+}
+
+//--------------------------------------------------------------------
+
+void UinputKeyboard::setFastMode(bool enable, uint keysPerSecond)
+{
+	m_fastMode=enable;
+	m_keyPeriod=std::chrono::steady_clock::duration(0);
+	if(keysPerSecond>0){
+		m_keyPeriod=std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+							std::chrono::seconds(1))/keysPerSecond;
+	}
+	m_nextKey=std::chrono::steady_clock::now();
+}
+
+//--------------------------------------------------------------------
+
+int UinputKeyboard::openEvdevReader()
+{
+	std::error_code ec;
+	std::filesystem::directory_iterator dirIterator("/dev/input", ec);
+	if(ec.value()!=0){
+		return -1;
+	}
+
+	char name[UINPUT_MAX_NAME_SIZE];
+	for(auto& dirEntry : dirIterator){
+		if(dirEntry.path().filename().string().rfind("event", 0)!=0){
+			continue;
+		}
+
+		int fd=open(dirEntry.path().c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+		if(fd<0){
+			continue;
+		}
+
+		std::memset(name, 0, sizeof(name));
+		if(ioctl(fd, EVIOCGNAME(sizeof(name)-1), name)>0 && std::strcmp(name, keyboardName())==0){
+			return fd;
+		}
+		close(fd);
+	}
+
+	return -1;
+}
+
+//--------------------------------------------------------------------
+
+bool UinputKeyboard::selfTest(uint keys, uint& received)
+{
+	received=0;
+	if(m_fd<0){
+		return false;
+	}
+
+	int evFd=openEvdevReader();
+	if(evFd<0){
+		dbg("evdev node of ", keyboardName(), " not found");
+		return false;
+	}
+
+	// while grabbed the test keys only reach us
+	if(ioctl(evFd, EVIOCGRAB, 1)<0){
+		close(evFd);
+		return false;
+	}
+
+	std::atomic<bool> writerDone{false};
+	bool dropped=false;
+
+	std::thread reader([&](){
+		input_event events[64];
+		pollfd pfd={evFd, POLLIN, 0};
+		int idleTime=0;
+		while(received<keys && idleTime<500){
+			if(poll(&pfd, 1, 10)<1){
+				if(writerDone){
+					idleTime+=10;
+				}
+				continue;
+			}
+
+			ssize_t n=read(evFd, events, sizeof(events));
+			for(ssize_t i=0; i<n/ssize_t(sizeof(input_event)); i++){
+				if(events[i].type==EV_SYN && events[i].code==SYN_DROPPED){
+					dropped=true;
+				}
+				else if(events[i].type==EV_KEY && events[i].code==KEY_RIGHTSHIFT && events[i].value==1){
+					received++;
+				}
+			}
+		}
+	});
+
+	beginSequence();
+	for(uint i=0; i<keys; i++){
+		sendKey(KEY_RIGHTSHIFT);
+	}
+	endSequence();
+	writerDone=true;
+
+	reader.join();
+
+	ioctl(evFd, EVIOCGRAB, 0);
+	close(evFd);
+
+	dbg("keyboard self test: ", received, "/", keys, dropped ? " (SYN_DROPPED)" : "");
 
-	std::this_thread::sleep_for(std::chrono::milliseconds(15));
+	return received==keys && !dropped;
 }
 
 //--------------------------------------------------------------------
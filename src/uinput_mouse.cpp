@@ -25,13 +25,24 @@
 #include <errno.h>
 #include <linux/uinput.h>
 
-#define MOUSE_NAME "AutomaticTester mouse"
+// high resolution wheel units per tick
+#define WHEEL_HI_RES_TICK 120
 
 
+//====================================================================
+
+// the same name for the whole session, see uinputDeviceName
+static const char* mouseName()
+{
+	static const std::string name=uinputDeviceName("mouse");
+	return name.c_str();
+}
+
 //====================================================================
 
 UinputMouse::UinputMouse()
 :m_fd(-1)
+, m_batch(m_fd)
 {
 	reload();
 }
@@ -59,11 +70,18 @@ bool UinputMouse::reload()
 			ioctl(m_fd, UI_SET_EVBIT, EV_KEY);
 			ioctl(m_fd, UI_SET_KEYBIT, BTN_LEFT);
 			ioctl(m_fd, UI_SET_KEYBIT, BTN_RIGHT);
+			ioctl(m_fd, UI_SET_KEYBIT, BTN_MIDDLE);
 			ioctl(m_fd, UI_SET_EVBIT, EV_REL);
 			ioctl(m_fd, UI_SET_RELBIT, REL_X);
 			ioctl(m_fd, UI_SET_RELBIT, REL_Y);
-
-			init(MOUSE_NAME);
+			ioctl(m_fd, UI_SET_RELBIT, REL_WHEEL);
+			ioctl(m_fd, UI_SET_RELBIT, REL_HWHEEL);
+#ifdef REL_WHEEL_HI_RES
+			ioctl(m_fd, UI_SET_RELBIT, REL_WHEEL_HI_RES);
+			ioctl(m_fd, UI_SET_RELBIT, REL_HWHEEL_HI_RES);
+#endif
+
+			init(mouseName());
 		}
 	}
 	return m_fd>-1;
@@ -86,24 +104,11 @@ void UinputMouse::init(const char* deviceName)
 
 //--------------------------------------------------------------------
 
-bool UinputMouse::emit(int type, int code, int val)
-{
-   m_inputEvent.type = type;
-   m_inputEvent.code = code;
-   m_inputEvent.value = val;
-   // timestamp values below are ignored
-   m_inputEvent.time.tv_sec = 0;
-   m_inputEvent.time.tv_usec = 0;
-
-   return 0<write(m_fd, &m_inputEvent, sizeof(m_inputEvent));
-}
-
-//--------------------------------------------------------------------
-
 void UinputMouse::buttonDown(MOUSE_BUTTONS button)
 {
 	emit(EV_KEY, getMouseButton(button), 1);
 	emit(EV_SYN, SYN_REPORT, 0);
+	flush();
 }
 
 //--------------------------------------------------------------------
@@ -112,15 +117,47 @@ void UinputMouse::buttonUp(MOUSE_BUTTONS button)
 {
 	emit(EV_KEY, getMouseButton(button), 0);
 	emit(EV_SYN, SYN_REPORT, 0);
+	flush();
 }
 
 //--------------------------------------------------------------------
 
 void UinputMouse::setPosition(const int dx, const int dy)
+{
+	moveStep(dx, dy);
+	std::this_thread::sleep_for(std::chrono::milliseconds(15));
+}
+
+//--------------------------------------------------------------------
+
+void UinputMouse::moveStep(const int dx, const int dy)
 {
 	emit(EV_REL, REL_X, dx);
 	emit(EV_REL, REL_Y, dy);
 	emit(EV_SYN, SYN_REPORT, 0);
+	flush();
+}
+
+//--------------------------------------------------------------------
+
+void UinputMouse::wheel(const int vertical, const int horizontal)
+{
+	// a device with high resolution wheels sends both codes, clients
+	// use one or the other
+	if(vertical!=0){
+		emit(EV_REL, REL_WHEEL, vertical);
+#ifdef REL_WHEEL_HI_RES
+		emit(EV_REL, REL_WHEEL_HI_RES, vertical*WHEEL_HI_RES_TICK);
+#endif
+	}
+	if(horizontal!=0){
+		emit(EV_REL, REL_HWHEEL, horizontal);
+#ifdef REL_HWHEEL_HI_RES
+		emit(EV_REL, REL_HWHEEL_HI_RES, horizontal*WHEEL_HI_RES_TICK);
+#endif
+	}
+	emit(EV_SYN, SYN_REPORT, 0);
+	flush();
 	std::this_thread::sleep_for(std::chrono::milliseconds(15));
 }
 
@@ -13,10 +13,14 @@
 * std::string resourcePath(const char*);                             *
 * std::string getFilePath(const char*);                              *
 * std::string getImgPath(const char*);                               *
+* std::string uinputDeviceName(const char*);                         *
 * bool existPath(const char*)                                        *
 * const char* getTimeStamp(const char*)                              *
 * bool imageExists(const char*)                                      *
+* const char* imageExtension(ImageFormat)                            *
+* std::string setImageFormat(const std::string&, ImageFormat)        *
 * template<int B, typename Func> bool exeCommand(const char*, Func)  *
+* std::string mkScreenshotStrCmd(WindowId, const char*, const char*);  *
 * std::string mkScreenshotStrCmd(const char*, const char*, const char*);
 * std::string mkScreenshotStrCmd(const char*, const char*, bool manual);
 * bool takeScreenshot(const char*, const char*, const char*);        *
@@ -33,7 +37,9 @@
 * Author:  Dan Machado                                               *
 **********************************************************************/
 #include "utilities.h"
-#include "cstr_split.h"
+#include "field_split.h"
+#include "window_registry.h"
+#include "trace.h"
 
 #include <wx/string.h>
 #include <wx/display.h>
@@ -103,6 +109,16 @@ std::string resourcePath(const char* fileName)
 
 std::string getFilePath(const char* file)
 {
+	const char* dataDir=getenv(DATA_DIR_ENV);
+	if(dataDir && std::strlen(dataDir)>0){
+		std::string dirPath=dataDir;
+		if(std::strlen(file)>0){
+			dirPath.append("/");
+			dirPath.append(file);
+		}
+		return dirPath;
+	}
+
 	#ifdef DEBUG
 	const char* hidDir="/wxHID";
 	std::string dirPath=DEBUG_DIR; // define in CMakeLists
@@ -140,6 +156,25 @@ std::string getImgPath(const char* file)
 
 //====================================================================
 
+std::string uinputDeviceName(const char* device)
+{
+	std::string name("AutomaticTester ");
+	const char* tag=getenv(DEVICE_TAG_ENV);
+	if(tag && std::strlen(tag)>0){
+		name.append(tag);
+		name.append(" ");
+	}
+	name.append(device);
+
+	// UINPUT_MAX_NAME_SIZE
+	if(name.length()>79){
+		name.resize(79);
+	}
+	return name;
+}
+
+//====================================================================
+
 bool existPath(const char* fileName)
 {
 	std::string dirPath=getFilePath(fileName);
@@ -190,73 +225,73 @@ bool removeImage(const char* imageName)
 
 //====================================================================
 
-bool windowExists(const char* windowName)
+const char* imageExtension(ImageFormat format)
 {
-	if(cstrCompare(windowName, "root")){
-		return true;
+	switch(format){
+		case ImageFormat::PPM:
+			return ".ppm";
+		case ImageFormat::BMP:
+			return ".bmp";
+		default:
+			return ".png";
 	}
-	auto command=wxString::Format("xprop -name \"%s\" 1>/dev/null 2>&1; echo $?", windowName);
-	bool windowExists=true;
-	exeCommand<64>(command.mb_str(), [&windowExists](const std::string& str){
-		windowExists=(std::atoi(str.c_str())==0);
-	});
+}
 
-	return windowExists;
+//====================================================================
+
+std::string setImageFormat(const std::string& imageName, ImageFormat format)
+{
+	std::string result=imageName;
+	size_t dot=result.find_last_of('.');
+	if(dot!=std::string::npos){
+		result.erase(dot);
+	}
+	result.append(imageExtension(format));
+	return result;
 }
 
 //====================================================================
 
-WindowRect getWindowRect(const char* windowName, bool visible)
+bool windowExists(const char* windowName)
 {
-	bool wExists=windowExists(windowName);
+	return windowExists(WindowRegistry::getWindowRegistry().id(windowName));
+}
+
+//--------------------------------------------------------------------
 
-	if(wExists){
-		const char* data[6]={
-			"Absolute upper-left X:",
-			"Absolute upper-left Y:", 
-			"Relative upper-left X:", 
-			"Relative upper-left Y:", 
-			"Width:", 
-			"Height:"
-		};
+bool windowExists(WindowId windowId)
+{
+	return WindowRegistry::getWindowRegistry().exists(windowId);
+}
 
-		auto command=wxString::Format("xwininfo -name \"%s\" 2>&1", windowName);
+//====================================================================
 
-		int geometry[6];
-		int i=0;
-		exeCommand<64>(command.mb_str(), [data, &geometry, &i, &wExists](const std::string& str){
-			if(i<6){
-				try{
-					size_t r=str.find(data[i]);
-					if(r!=std::string::npos){
-						size_t j=str.find(':', r);
-						geometry[i++]=std::atoi(str.c_str()+j+1);
-					}
-				}
-				catch(...){
-					i=6;
-					wExists=false;
-				}
+WindowRect getWindowRect(const char* windowName, bool visible)
+{
+	return getWindowRect(WindowRegistry::getWindowRegistry().id(windowName), visible);
+}
+
+//--------------------------------------------------------------------
+
+WindowRect getWindowRect(WindowId windowId, bool visible)
+{
+	WindowRegistry::Geometry geometry;
+	if(WindowRegistry::getWindowRegistry().geometry(windowId, geometry)){
+		int x=geometry.m_x;
+		int y=geometry.m_y;
+		int w=geometry.m_width;
+		int h=geometry.m_height;
+
+		if(visible){
+			wxRect rt=wxDisplay().GetGeometry();
+			if(w>rt.GetWidth()-x){
+				w=rt.GetWidth()-x;
 			}
-		});
-		if(wExists){
-			
-			int x=geometry[0]-geometry[2];
-			int y=geometry[1]-geometry[3];
-			int w=geometry[4]+2*geometry[2];
-			int h=geometry[5]+geometry[3];
-
-			if(visible){
-				wxRect rt=wxDisplay().GetGeometry();
-				if(w>rt.GetWidth()-x){
-					w=rt.GetWidth()-x;
-				}
-				if(h>rt.GetHeight()-y){
-					h=rt.GetHeight()-y;
-				}
+			if(h>rt.GetHeight()-y){
+				h=rt.GetHeight()-y;
 			}
-			return WindowRect(x, y, w, h);
 		}
+		return WindowRect(x, y, w, h);
 	}
 	return WindowRect(0, 0, 0, 0);
 }
@@ -272,38 +307,23 @@ std::string getWindowROI(const char* windowName)
 
 std::pair<int, int> getWindowCoord(const char* windowName, int x, int y, const char* position)
 {
-	bool wExists=windowExists(windowName);
+	return getWindowCoord(WindowRegistry::getWindowRegistry().id(windowName), x, y);
+}
 
-	if(wExists){
-		auto command=wxString::Format("xwininfo -name \"%s\" | grep \"upper-left\" | cut -d\":\" -f2 2>&1", windowName, position);
-		int coordinates[2]={x, y};
-		int i=0;
-		
-		exeCommand<16>(command.mb_str(), [&coordinates, &i, &wExists](const std::string& str){
-			try{
-				if(wExists){
-					if(i<2){
-						coordinates[i++]+=std::atoi(str.c_str());
-					}
-					else{
-						coordinates[(i++)-2]-=std::atoi(str.c_str());
-					}
-				}
-			}
-			catch(...){
-				wExists=false;
-			}
-		});
-		if(wExists){
-			return {coordinates[0], coordinates[1]};
-		}
+//--------------------------------------------------------------------
+
+std::pair<int, int> getWindowCoord(WindowId windowId, int x, int y)
+{
+	WindowRegistry::Geometry geometry;
+	if(WindowRegistry::getWindowRegistry().geometry(windowId, geometry)){
+		return {x+geometry.m_x, y+geometry.m_y};
 	}
 	return {-1, -1};
 }
 
 //====================================================================
 
-std::string mkScreenshotStrCmd(const char* windowName, const char* outputImage, const char* roiStr)
+std::string mkScreenshotStrCmd(WindowId windowId, const char* outputImage, const char* roiStr)
 {
 	wxString cropStr;
 	if(std::strlen(roiStr)>0){
@@ -314,16 +334,25 @@ std::string mkScreenshotStrCmd(const char* windowName, const char* outputImage,
 	}
 	
 	wxString screenshotCmd;
-	if(cstrCompare(windowName, "root")){
-		screenshotCmd=wxString::Format(wxT("import -window \"%s\" %s +repage %s -quiet"), windowName, cropStr, getImgPath(outputImage));
+	if(windowId==WindowRegistry::ROOT){
+		screenshotCmd=wxString::Format(wxT("import -window root %s +repage %s -quiet"), cropStr, getImgPath(outputImage));
 	}
 	else{
-		screenshotCmd=wxString::Format(wxT("import -window \"%s\" -frame %s +repage %s -quiet"), windowName, cropStr, getImgPath(outputImage));
+		unsigned long xid=WindowRegistry::getWindowRegistry().xid(windowId);
+		if(xid==0){
+			return "";
+		}
+		screenshotCmd=wxString::Format(wxT("import -window 0x%lx -frame %s +repage %s -quiet"), xid, cropStr, getImgPath(outputImage));
 	}
 
 	return std::string(screenshotCmd.mb_str());
 }
 
+std::string mkScreenshotStrCmd(const char* windowName, const char* outputImage, const char* roiStr)
+{
+	return mkScreenshotStrCmd(WindowRegistry::getWindowRegistry().id(windowName), outputImage, roiStr);
+}
+
 std::string mkScreenshotStrCmd(const char* windowName, const char* outputImage, bool manual)
 {
 	if(!manual){
@@ -342,7 +371,9 @@ std::string mkScreenshotStrCmd(const char* windowName, const char* outputImage,
 bool takeScreenshot(const char* windowName, const char* outputImage, const char* roiStr)
 {
 	if(windowExists(windowName)){
-		return 0==system(mkScreenshotStrCmd(windowName, outputImage, roiStr).c_str());
+		TraceSpan span("screenshot", "image", windowName);
+		std::string screenshotCmd=mkScreenshotStrCmd(windowName, outputImage, roiStr);
+		return !screenshotCmd.empty() && 0==system(screenshotCmd.c_str());
 	}
 	return false;
 }
@@ -350,7 +381,9 @@ bool takeScreenshot(const char* windowName, const char* outputImage, const char*
 bool takeScreenshot(const char* windowName, const char* outputImage, bool manual)
 {
 	if(windowExists(windowName)){
-		return 0==system(mkScreenshotStrCmd(windowName, outputImage, manual).c_str());
+		TraceSpan span("screenshot", "image", windowName);
+		std::string screenshotCmd=mkScreenshotStrCmd(windowName, outputImage, manual);
+		return !screenshotCmd.empty() && 0==system(screenshotCmd.c_str());
 	}
 	return false;
 }
@@ -363,7 +396,9 @@ bool wxTakeScreenshot(const int ms, const char* windowName, const char* outputIm
 			wxMilliSleep(50);
 			i+=50;
 		}
-		return 0==system(mkScreenshotStrCmd(windowName, outputImage, roiStr).c_str());
+		TraceSpan span("screenshot", "image", windowName);
+		std::string screenshotCmd=mkScreenshotStrCmd(windowName, outputImage, roiStr);
+		return !screenshotCmd.empty() && 0==system(screenshotCmd.c_str());
 	}
 	return false;
 }
@@ -376,7 +411,9 @@ bool wxTakeScreenshot(const int ms, const char* windowName, const char* outputIm
 			wxMilliSleep(50);
 			i+=50;
 		}
-		return 0==system(mkScreenshotStrCmd(windowName, outputImage, manual).c_str());
+		TraceSpan span("screenshot", "image", windowName);
+		std::string screenshotCmd=mkScreenshotStrCmd(windowName, outputImage, manual);
+		return !screenshotCmd.empty() && 0==system(screenshotCmd.c_str());
 	}
 	return false;
 }
@@ -387,24 +424,19 @@ bool wxTakeScreenshot(const int ms, const char* windowName, const char* outputIm
 
 bool isRGB(const char* str)
 {
-	CstrSplit<3> parts(str, ",");
+	FieldSplit<3> parts(str, ",");
 	if(parts.dataSize()!=3){
 		return false;
 	}
-	try
-	{
-		for(int i=0; i<3; i++){
-			int r=std::atoi(parts[i]);
-			if(r<0 || r>255){
-				return false;
-			}
+
+	for(int i=0; i<3; i++){
+		int r=parts.number<int>(i);
+		if(r<0 || r>255){
+			return false;
 		}
 	}
-	catch(...){
-		return false;
-	}
 
-	return true;
+	return parts.ok();
 }
 
 
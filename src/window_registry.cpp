@@ -0,0 +1,239 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* class WindowRegistry                                               *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "window_registry.h"
+#include "utilities.h"
+#include "trace.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+//====================================================================
+
+namespace {
+
+struct WindowInfo
+{
+	unsigned long m_xid=0;
+	std::string m_title;
+	// absolute x, y, relative x, y, width, height
+	int m_values[6];
+	int m_count=0;
+};
+
+//--------------------------------------------------------------------
+
+// single quotes keep everything but a single quote, which is '\''
+std::string shellQuote(const std::string& str)
+{
+	std::string quoted("'");
+	for(char c : str){
+		if(c=='\''){
+			quoted.append("'\\''");
+		}
+		else{
+			quoted.push_back(c);
+		}
+	}
+	quoted.push_back('\'');
+	return quoted;
+}
+
+//--------------------------------------------------------------------
+
+bool query(const std::string& command, WindowInfo& info)
+{
+	const char* fields[6]={
+		"Absolute upper-left X:",
+		"Absolute upper-left Y:",
+		"Relative upper-left X:",
+		"Relative upper-left Y:",
+		"Width:",
+		"Height:"
+	};
+
+	TraceSpan span("xwininfo", "window", command.c_str());
+
+	bool failed=false;
+	exeCommand<1024>(command.c_str(), [&](const std::string& line){
+		if(line.find("xwininfo: error")==0 || line.find("X Error")==0){
+			failed=true;
+			return;
+		}
+
+		size_t pos=line.find("Window id:");
+		if(pos!=std::string::npos){
+			info.m_xid=std::strtoul(line.c_str()+pos+10, nullptr, 16);
+			size_t begin=line.find('"', pos);
+			size_t end=line.rfind('"');
+			if(begin!=std::string::npos && end>begin){
+				info.m_title=line.substr(begin+1, end-begin-1);
+			}
+			return;
+		}
+
+		if(info.m_count<6){
+			const char* field=fields[info.m_count];
+			pos=line.find(field);
+			if(pos!=std::string::npos){
+				info.m_values[info.m_count++]=std::atoi(line.c_str()+pos+std::strlen(field));
+			}
+		}
+	});
+
+	return !failed && info.m_xid!=0 && info.m_count==6;
+}
+
+}
+
+//====================================================================
+
+WindowRegistry::WindowRegistry()
+{
+	m_entries.push_back({"root", 0, {0, 0, 0, 0}, Clock::time_point(), false});
+	m_ids.emplace(m_entries.back().m_name, ROOT);
+}
+
+//--------------------------------------------------------------------
+
+WindowId WindowRegistry::id(std::string_view windowName)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it=m_ids.find(windowName);
+	if(it!=m_ids.end()){
+		return it->second;
+	}
+
+	WindowId id=m_entries.size();
+	m_entries.push_back({std::string(windowName), 0, {0, 0, 0, 0}, Clock::time_point(), false});
+	m_ids.emplace(m_entries.back().m_name, id);
+	return id;
+}
+
+//--------------------------------------------------------------------
+
+const char* WindowRegistry::name(WindowId id) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if(id<m_entries.size()){
+		return m_entries[id].m_name.c_str();
+	}
+	return "";
+}
+
+//--------------------------------------------------------------------
+
+bool WindowRegistry::exists(WindowId id)
+{
+	if(id==ROOT){
+		return true;
+	}
+	Geometry geometry;
+	return refresh(id, geometry);
+}
+
+//--------------------------------------------------------------------
+
+unsigned long WindowRegistry::xid(WindowId id)
+{
+	Geometry geometry;
+	if(id==ROOT || !refresh(id, geometry)){
+		return 0;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_entries[id].m_xid;
+}
+
+//--------------------------------------------------------------------
+
+bool WindowRegistry::geometry(WindowId id, Geometry& geometry)
+{
+	return refresh(id, geometry);
+}
+
+//--------------------------------------------------------------------
+
+void WindowRegistry::expire()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for(Entry& entry : m_entries){
+		entry.m_checked=Clock::time_point();
+	}
+}
+
+//--------------------------------------------------------------------
+
+size_t WindowRegistry::size() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_entries.size();
+}
+
+//--------------------------------------------------------------------
+
+bool WindowRegistry::refresh(WindowId id, Geometry& geometry)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if(id>=m_entries.size()){
+		return false;
+	}
+
+	// the entries do not move, the reference outlives the unlock
+	Entry& entry=m_entries[id];
+	if(entry.m_found && Clock::now()-entry.m_checked<std::chrono::milliseconds(GEOMETRY_TTL)){
+		geometry=entry.m_geometry;
+		return true;
+	}
+
+	std::string name=entry.m_name;
+	unsigned long xid=entry.m_xid;
+	lock.unlock();
+
+	WindowInfo info;
+	bool found=false;
+	if(id==ROOT){
+		found=query("xwininfo -root 2>&1", info);
+	}
+	else{
+		if(xid!=0){
+			char command[64];
+			std::snprintf(command, sizeof(command), "xwininfo -id 0x%lx 2>&1", xid);
+			// the X id may be reused by another window, or this one renamed
+			found=query(command, info) && info.m_title==name;
+		}
+		if(!found){
+			info=WindowInfo();
+			found=query("xwininfo -name "+shellQuote(name)+" 2>&1", info);
+		}
+	}
+
+	lock.lock();
+	entry.m_found=found;
+	entry.m_xid=found ? info.m_xid : 0;
+	if(found){
+		// the frame included, as getWindowRect always had it
+		entry.m_geometry.m_x=info.m_values[0]-info.m_values[2];
+		entry.m_geometry.m_y=info.m_values[1]-info.m_values[3];
+		entry.m_geometry.m_width=info.m_values[4]+2*info.m_values[2];
+		entry.m_geometry.m_height=info.m_values[5]+info.m_values[3];
+		entry.m_checked=Clock::now();
+		geometry=entry.m_geometry;
+	}
+
+	return found;
+}
+
+//====================================================================
@@ -0,0 +1,159 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "field_split.h"
+#include "utilities.h"
+
+#include <gtest/gtest.h>
+
+//====================================================================
+
+TEST(FieldSplit, SplitsOnTheSeparator)
+{
+	FieldSplit<4> fields("a#+|+#bc#+|+##+|+#d", SEPARATOR);
+
+	ASSERT_EQ(fields.dataSize(), 4);
+	EXPECT_EQ(fields[0], "a");
+	EXPECT_EQ(fields[1], "bc");
+	EXPECT_EQ(fields[2], "");
+	EXPECT_EQ(fields[3], "d");
+	EXPECT_TRUE(fields.ok());
+}
+
+//--------------------------------------------------------------------
+
+TEST(FieldSplit, LastFieldKeepsTheRest)
+{
+	FieldSplit<2> fields("1,2,3", ",");
+
+	ASSERT_EQ(fields.dataSize(), 2);
+	EXPECT_EQ(fields[0], "1");
+	EXPECT_EQ(fields[1], "2,3");
+}
+
+//--------------------------------------------------------------------
+
+TEST(FieldSplit, LineWithoutSeparator)
+{
+	FieldSplit<3> fields("single", ",");
+
+	ASSERT_EQ(fields.dataSize(), 1);
+	EXPECT_EQ(fields[0], "single");
+
+	FieldSplit<3> empty("", ",");
+	ASSERT_EQ(empty.dataSize(), 1);
+	EXPECT_EQ(empty[0], "");
+}
+
+//--------------------------------------------------------------------
+
+TEST(FieldSplit, FieldsAreViewsIntoTheLine)
+{
+	std::string line="abc,def";
+	FieldSplit<2> fields(line, ",");
+
+	EXPECT_EQ(fields[1].data(), line.data()+4);
+	EXPECT_EQ(fields.str(1), "def");
+}
+
+//--------------------------------------------------------------------
+
+TEST(FieldSplit, Numbers)
+{
+	FieldSplit<4> fields("12,-7,3000000000,0", ",");
+
+	EXPECT_EQ(fields.number<int>(0), 12);
+	EXPECT_EQ(fields.number<int>(1), -7);
+	EXPECT_EQ(fields.number<long long>(2), 3000000000LL);
+	EXPECT_EQ(fields.number<uint>(3), 0u);
+	EXPECT_TRUE(fields.ok());
+}
+
+//--------------------------------------------------------------------
+
+TEST(FieldSplit, NotANumber)
+{
+	FieldSplit<4> fields("12,12a,,x", ",");
+
+	EXPECT_EQ(fields.number<int>(0), 12);
+	EXPECT_TRUE(fields.ok());
+
+	// the whole field must be a number
+	EXPECT_EQ(fields.number<int>(1), 0);
+	EXPECT_FALSE(fields.ok());
+	EXPECT_EQ(fields.error(), FieldSplit<4>::NOT_A_NUMBER);
+	EXPECT_EQ(fields.errorField(), 1);
+	EXPECT_EQ(fields.errorMessage(), "field 1: not a number");
+}
+
+//--------------------------------------------------------------------
+
+TEST(FieldSplit, EmptyFieldIsNotANumber)
+{
+	FieldSplit<2> fields("1,", ",");
+
+	EXPECT_EQ(fields.number<int>(1), 0);
+	EXPECT_EQ(fields.error(), FieldSplit<2>::NOT_A_NUMBER);
+}
+
+//--------------------------------------------------------------------
+
+TEST(FieldSplit, OutOfRangeIsNotANumber)
+{
+	FieldSplit<1> fields("300", ",");
+
+	EXPECT_EQ(fields.number<uint8_t>(0), 0);
+	EXPECT_EQ(fields.error(), FieldSplit<1>::NOT_A_NUMBER);
+}
+
+//--------------------------------------------------------------------
+
+TEST(FieldSplit, MissingField)
+{
+	FieldSplit<5> fields("a,b", ",");
+
+	EXPECT_FALSE(fields.has(2));
+	EXPECT_FALSE(fields.has(-1));
+	EXPECT_TRUE(fields.ok());
+
+	EXPECT_EQ(fields[3], "");
+	EXPECT_EQ(fields.number<int>(4), 0);
+	EXPECT_EQ(fields.error(), FieldSplit<5>::MISSING_FIELD);
+	EXPECT_EQ(fields.errorMessage(), "field 3: missing");
+}
+
+//--------------------------------------------------------------------
+
+TEST(FieldSplit, FirstErrorIsKept)
+{
+	FieldSplit<3> fields("x,1", ",");
+
+	fields.number<int>(0);
+	fields[2];
+	EXPECT_EQ(fields.error(), FieldSplit<3>::NOT_A_NUMBER);
+	EXPECT_EQ(fields.errorField(), 0);
+}
+
+//--------------------------------------------------------------------
+
+TEST(FieldSplit, ToBool)
+{
+	FieldSplit<3> fields("true,false,1", ",");
+
+	EXPECT_TRUE(fields.toBool(0));
+	EXPECT_FALSE(fields.toBool(1));
+	EXPECT_FALSE(fields.toBool(2));
+	EXPECT_TRUE(fields.ok());
+}
+
+//====================================================================
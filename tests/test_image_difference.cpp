@@ -0,0 +1,117 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "ImageDiff_Lib/simple_image_difference.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <functional>
+#include <string>
+
+//====================================================================
+
+namespace {
+
+constexpr int WIDTH=90;
+constexpr int HEIGHT=80;
+
+// grey binary PPM, @param grey gives the level of each pixel
+std::string writeImage(const char* name, std::function<unsigned char(int, int)> grey)
+{
+	std::ofstream file(name, std::ios::binary);
+	file<<"P6\n"<<WIDTH<<" "<<HEIGHT<<"\n255\n";
+	for(int y=0; y<HEIGHT; y++){
+		for(int x=0; x<WIDTH; x++){
+			char level=char(grey(x, y));
+			char pixel[3]={level, level, level};
+			file.write(pixel, 3);
+		}
+	}
+	return name;
+}
+
+// 10x10 blocks, one per cell of the 9x8 hash, alternating two grey
+// levels @param step apart
+unsigned char checker(int x, int y, int phase, int step)
+{
+	return 128+step*((x/10+y/10+phase)%2);
+}
+
+}
+
+//====================================================================
+
+TEST(SimpleImageDifference, LowContrastPairIsStillSimilar)
+{
+	std::string base=writeImage("low_contrast_base.ppm", [](int x, int y){
+		return checker(x, y, 0, 2);
+	});
+	std::string sample=writeImage("low_contrast_sample.ppm", [](int x, int y){
+		return checker(x, y, 1, 2);
+	});
+
+	const unsigned int threshold=10;
+	const unsigned int sensitivity=100;
+
+	SimpleImageDifference imageDifference;
+	imageDifference.loadBaseImage(base.c_str());
+	size_t difference=imageDifference.getDifference(sample.c_str(), threshold);
+	ASSERT_LT(difference, size_t(sensitivity));
+
+	// below the limit the count is exact
+	EXPECT_TRUE(imageDifference.isSimilar(sample.c_str(), threshold, sensitivity));
+	EXPECT_EQ(imageDifference.getDifference(sample.c_str(), threshold, sensitivity), difference);
+}
+
+//--------------------------------------------------------------------
+
+TEST(SimpleImageDifference, CountStopsAtTheLimit)
+{
+	std::string base=writeImage("different_base.ppm", [](int x, int){
+		return x<WIDTH/2 ? 0 : 255;
+	});
+	std::string sample=writeImage("different_sample.ppm", [](int x, int){
+		return x<WIDTH/2 ? 255 : 0;
+	});
+
+	const unsigned int threshold=10;
+	const unsigned int sensitivity=100;
+
+	SimpleImageDifference imageDifference;
+	imageDifference.loadBaseImage(base.c_str());
+	size_t difference=imageDifference.getDifference(sample.c_str(), threshold);
+	ASSERT_GT(difference, size_t(sensitivity));
+
+	EXPECT_FALSE(imageDifference.isSimilar(sample.c_str(), threshold, sensitivity));
+	EXPECT_EQ(imageDifference.getDifference(sample.c_str(), threshold, sensitivity), size_t(sensitivity));
+
+	// without a limit the count is exact
+	EXPECT_EQ(imageDifference.getDifference(sample.c_str(), threshold), difference);
+}
+
+//--------------------------------------------------------------------
+
+TEST(SimpleImageDifference, SameImageHasNoDifference)
+{
+	std::string base=writeImage("same_base.ppm", [](int x, int y){
+		return checker(x, y, 0, 60);
+	});
+
+	SimpleImageDifference imageDifference;
+	imageDifference.loadBaseImage(base.c_str());
+	EXPECT_EQ(imageDifference.getDifference(base.c_str(), 10, 100), 0u);
+	EXPECT_TRUE(imageDifference.isSimilar(base.c_str(), 10, 100));
+}
+
+//====================================================================
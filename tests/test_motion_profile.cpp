@@ -0,0 +1,168 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "motion_profile.h"
+
+#include <gtest/gtest.h>
+
+//====================================================================
+
+namespace {
+
+void sumSteps(const std::vector<MotionStep>& steps, int& x, int& y)
+{
+	x=0;
+	y=0;
+	for(const MotionStep& step : steps){
+		x+=step.m_dx;
+		y+=step.m_dy;
+	}
+}
+
+}
+
+//====================================================================
+
+TEST(MotionSpec, Parse)
+{
+	MotionSpec linear=MotionSpec::parse("linear,10");
+	EXPECT_EQ(linear.profile(), MotionProfile::LINEAR);
+	EXPECT_EQ(linear.param(), 10u);
+
+	MotionSpec velocity=MotionSpec::parse("velocity,1500");
+	EXPECT_EQ(velocity.profile(), MotionProfile::VELOCITY);
+	EXPECT_EQ(velocity.param(), 1500u);
+
+	EXPECT_EQ(MotionSpec::parse("instant,0").profile(), MotionProfile::INSTANT);
+}
+
+//--------------------------------------------------------------------
+
+TEST(MotionSpec, ParseDefaults)
+{
+	// no parameter, or one that is not a number, takes the default
+	EXPECT_EQ(MotionSpec::parse("ease").param(), 20u);
+	EXPECT_EQ(MotionSpec::parse("linear,").param(), 20u);
+	EXPECT_EQ(MotionSpec::parse("velocity,fast").param(), 2000u);
+}
+
+//--------------------------------------------------------------------
+
+TEST(MotionSpec, ParseUnknown)
+{
+	EXPECT_TRUE(MotionSpec::parse("").isLegacy());
+	EXPECT_TRUE(MotionSpec::parse("warp,3").isLegacy());
+	EXPECT_TRUE(MotionSpec::parse("Linear,3").isLegacy());
+}
+
+//--------------------------------------------------------------------
+
+TEST(MotionSpec, ToStringRoundTrip)
+{
+	for(int i=0; i<int(MotionProfile::_LAST); i++){
+		MotionSpec spec(MotionProfile(i), 7);
+		MotionSpec parsed=MotionSpec::parse(spec.toString());
+		EXPECT_EQ(parsed.profile(), spec.profile()) << spec.toString();
+		EXPECT_EQ(parsed.param(), spec.param()) << spec.toString();
+	}
+}
+
+//--------------------------------------------------------------------
+
+TEST(MotionSpec, NoStepsWithoutMovement)
+{
+	EXPECT_TRUE(MotionSpec(MotionProfile::LINEAR, 10).steps(0, 0).empty());
+}
+
+//--------------------------------------------------------------------
+
+TEST(MotionSpec, InstantIsOneStep)
+{
+	std::vector<MotionStep> steps=MotionSpec(MotionProfile::INSTANT).steps(-120, 45);
+
+	ASSERT_EQ(steps.size(), 1u);
+	EXPECT_EQ(steps[0].m_dx, -120);
+	EXPECT_EQ(steps[0].m_dy, 45);
+	EXPECT_EQ(steps[0].m_at, 0u);
+}
+
+//--------------------------------------------------------------------
+
+TEST(MotionSpec, StepsAddUpToTheTarget)
+{
+	const int targets[][2]={{1, 0}, {-3, 7}, {500, -333}, {0, 1919}};
+	for(int i=0; i<int(MotionProfile::_LAST); i++){
+		MotionSpec spec{MotionProfile(i)};
+		for(const auto& target : targets){
+			int x, y;
+			sumSteps(spec.steps(target[0], target[1]), x, y);
+			EXPECT_EQ(x, target[0]) << spec.toString();
+			EXPECT_EQ(y, target[1]) << spec.toString();
+		}
+	}
+}
+
+//--------------------------------------------------------------------
+
+TEST(MotionSpec, LinearSteps)
+{
+	std::vector<MotionStep> steps=MotionSpec(MotionProfile::LINEAR, 10).steps(100, 0);
+
+	ASSERT_EQ(steps.size(), 10u);
+	for(size_t i=0; i<steps.size(); i++){
+		EXPECT_EQ(steps[i].m_dx, 10);
+		EXPECT_EQ(steps[i].m_at, i*MotionSpec::STEP_PERIOD);
+	}
+}
+
+//--------------------------------------------------------------------
+
+TEST(MotionSpec, ShortMoveSkipsEmptySteps)
+{
+	// 3 pixels in 10 steps: only the steps that move are kept
+	std::vector<MotionStep> steps=MotionSpec(MotionProfile::LINEAR, 10).steps(3, 0);
+
+	ASSERT_EQ(steps.size(), 3u);
+	for(const MotionStep& step : steps){
+		EXPECT_EQ(step.m_dx, 1);
+	}
+	EXPECT_LT(steps[0].m_at, steps[1].m_at);
+}
+
+//--------------------------------------------------------------------
+
+TEST(MotionSpec, EaseIsSlowAtBothEnds)
+{
+	std::vector<MotionStep> steps=MotionSpec(MotionProfile::EASE_IN_OUT, 20).steps(1000, 0);
+
+	ASSERT_EQ(steps.size(), 20u);
+	EXPECT_LT(steps.front().m_dx, steps[10].m_dx);
+	EXPECT_LT(steps.back().m_dx, steps[10].m_dx);
+}
+
+//--------------------------------------------------------------------
+
+TEST(MotionSpec, VelocityDuration)
+{
+	// 1000 pixels at 2000 px/s take 500ms
+	std::vector<MotionStep> steps=MotionSpec(MotionProfile::VELOCITY, 2000).steps(600, 800);
+
+	ASSERT_FALSE(steps.empty());
+	EXPECT_EQ(steps.size(), 500000u/MotionSpec::STEP_PERIOD);
+	EXPECT_NEAR(double(steps.back().m_at), 500000.0-MotionSpec::STEP_PERIOD, 1.0);
+	for(size_t i=1; i<steps.size(); i++){
+		EXPECT_GT(steps[i].m_at, steps[i-1].m_at);
+	}
+}
+
+//====================================================================
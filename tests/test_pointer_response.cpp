@@ -0,0 +1,115 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "pointer_response.h"
+
+#include <gtest/gtest.h>
+
+//====================================================================
+
+namespace {
+
+PointerResponse accelerated()
+{
+	PointerResponse response;
+	response.addSample(1, 1.0);
+	response.addSample(5, 8.0);
+	response.addSample(10, 25.0);
+	return response;
+}
+
+}
+
+//====================================================================
+
+TEST(PointerResponse, EmptyIsOneToOne)
+{
+	PointerResponse response;
+	EXPECT_TRUE(response.empty());
+	EXPECT_DOUBLE_EQ(response.pixels(7), 7.0);
+	EXPECT_EQ(response.counts(-7.4), -7);
+
+	// one sample is not a curve
+	response.addSample(2, 6.0);
+	EXPECT_TRUE(response.empty());
+}
+
+//--------------------------------------------------------------------
+
+TEST(PointerResponse, NoisySamplesAreDropped)
+{
+	PointerResponse response=accelerated();
+	response.addSample(8, 30.0);// fewer counts than the last one
+	response.addSample(12, 20.0);// fewer pixels
+	response.addSample(0, 1.0);
+	response.addSample(20, -1.0);
+
+	EXPECT_EQ(response.maxCounts(), 10);
+	EXPECT_DOUBLE_EQ(response.maxPixels(), 25.0);
+}
+
+//--------------------------------------------------------------------
+
+TEST(PointerResponse, Interpolation)
+{
+	PointerResponse response=accelerated();
+
+	EXPECT_DOUBLE_EQ(response.pixels(1), 1.0);
+	EXPECT_DOUBLE_EQ(response.pixels(5), 8.0);
+	EXPECT_DOUBLE_EQ(response.pixels(3), 4.5);
+	EXPECT_DOUBLE_EQ(response.pixels(-3), -4.5);
+
+	// beyond the last sample the slope of the last segment
+	EXPECT_DOUBLE_EQ(response.pixels(12), 25.0+2*3.4);
+}
+
+//--------------------------------------------------------------------
+
+TEST(PointerResponse, CountsIsTheInverse)
+{
+	PointerResponse response=accelerated();
+
+	for(int counts=-15; counts<=15; counts++){
+		EXPECT_EQ(response.counts(response.pixels(counts)), counts);
+	}
+
+	EXPECT_EQ(response.counts(0.2), 0);
+	EXPECT_EQ(response.counts(16.5), 8);
+}
+
+//--------------------------------------------------------------------
+
+TEST(PointerResponse, ToStringRoundTrip)
+{
+	PointerResponse response=accelerated();
+	std::string str=response.toString();
+	EXPECT_EQ(str, "1/1.00,5/8.00,10/25.00");
+
+	PointerResponse parsed=PointerResponse::parse(str.c_str());
+	EXPECT_EQ(parsed.toString(), str);
+	EXPECT_DOUBLE_EQ(parsed.pixels(3), response.pixels(3));
+}
+
+//--------------------------------------------------------------------
+
+TEST(PointerResponse, ParseStopsAtGarbage)
+{
+	EXPECT_TRUE(PointerResponse::parse("").empty());
+	EXPECT_TRUE(PointerResponse::parse("abc").empty());
+
+	PointerResponse parsed=PointerResponse::parse("1/1.5,4/9,x/3,8/20");
+	EXPECT_EQ(parsed.maxCounts(), 4);
+	EXPECT_DOUBLE_EQ(parsed.maxPixels(), 9.0);
+}
+
+//====================================================================
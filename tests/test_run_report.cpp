@@ -0,0 +1,80 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "run_report.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+//====================================================================
+
+TEST(RunReport, NoLatencies)
+{
+	std::vector<double> values;
+	RunReport::Latency latency=RunReport::latency(values);
+
+	EXPECT_EQ(latency.m_p50, 0);
+	EXPECT_EQ(latency.m_p99, 0);
+	EXPECT_EQ(latency.m_max, 0);
+	EXPECT_EQ(latency.m_mean, 0);
+}
+
+//--------------------------------------------------------------------
+
+TEST(RunReport, SingleLatency)
+{
+	std::vector<double> values{12.5};
+	RunReport::Latency latency=RunReport::latency(values);
+
+	EXPECT_EQ(latency.m_p50, 12.5);
+	EXPECT_EQ(latency.m_p95, 12.5);
+	EXPECT_EQ(latency.m_p99, 12.5);
+	EXPECT_EQ(latency.m_max, 12.5);
+	EXPECT_EQ(latency.m_mean, 12.5);
+}
+
+//--------------------------------------------------------------------
+
+TEST(RunReport, NearestRankPercentiles)
+{
+	std::vector<double> values;
+	for(int i=100; i>0; i--){
+		values.push_back(i);
+	}
+	std::shuffle(values.begin(), values.end(), std::mt19937(7));
+
+	RunReport::Latency latency=RunReport::latency(values);
+
+	EXPECT_EQ(latency.m_p50, 50);
+	EXPECT_EQ(latency.m_p95, 95);
+	EXPECT_EQ(latency.m_p99, 99);
+	EXPECT_EQ(latency.m_max, 100);
+	EXPECT_DOUBLE_EQ(latency.m_mean, 50.5);
+}
+
+//--------------------------------------------------------------------
+
+TEST(RunReport, FewLatencies)
+{
+	// with 10 values p95 and p99 are both the largest
+	std::vector<double> values{1, 2, 3, 4, 5, 6, 7, 8, 9, 1000};
+	RunReport::Latency latency=RunReport::latency(values);
+
+	EXPECT_EQ(latency.m_p50, 5);
+	EXPECT_EQ(latency.m_p95, 1000);
+	EXPECT_EQ(latency.m_p99, 1000);
+}
+
+//====================================================================
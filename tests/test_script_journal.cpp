@@ -0,0 +1,264 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "script_journal.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+//====================================================================
+
+namespace {
+
+const std::string SCRIPT="journal_script.txt";
+
+typedef std::vector<std::string> Lines;
+
+void writeFile(const std::string& filePath, const std::string& data)
+{
+	std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+	file<<data;
+}
+
+std::string readFile(const std::string& filePath)
+{
+	std::ifstream file(filePath, std::ios::binary);
+	return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+std::string join(const Lines& lines)
+{
+	std::string data;
+	for(const std::string& line : lines){
+		data.append(line);
+		data.push_back('\n');
+	}
+	return data;
+}
+
+// the script as ScriptLoader reads it: the non empty lines of the file
+// with the journal replayed; @param logBytes the committed length
+Lines load(size_t& logBytes)
+{
+	std::string data=readFile(SCRIPT);
+	Lines lines;
+	size_t begin=0;
+	while(begin<data.length()){
+		size_t end=data.find('\n', begin);
+		if(end==std::string::npos){
+			end=data.length();
+		}
+		if(end>begin){
+			lines.push_back(data.substr(begin, end-begin));
+		}
+		begin=end+1;
+	}
+
+	ScriptJournal::replay(SCRIPT, ScriptJournal::contentHash(data), lines, logBytes);
+	return lines;
+}
+
+Lines load()
+{
+	size_t logBytes;
+	return load(logBytes);
+}
+
+// what ExtScrolledWindow::saveData does when the journal cannot be used
+void fullSave(ScriptJournal& journal, const Lines& lines)
+{
+	std::string data=join(lines);
+	ASSERT_TRUE(ScriptJournal::replaceFile(SCRIPT, data));
+	ScriptJournal::removeLog(SCRIPT);
+	journal.attach(SCRIPT, ScriptJournal::contentHash(data));
+}
+
+//--------------------------------------------------------------------
+
+class ScriptJournalTest : public ::testing::Test
+{
+	protected:
+		void SetUp() override
+		{
+			ScriptJournal::removeLog(SCRIPT);
+			fullSave(m_journal, m_lines);
+		}
+
+		void TearDown() override
+		{
+			ScriptJournal::removeLog(SCRIPT);
+			std::remove(SCRIPT.c_str());
+		}
+
+		Lines m_lines{"loop:2", "first", "end_loop", "last"};
+		ScriptJournal m_journal;
+};
+
+}
+
+//====================================================================
+
+TEST_F(ScriptJournalTest, ReplaysCommittedEdits)
+{
+	m_journal.add(4, "appended");
+	m_journal.remove(0);
+	m_journal.swap(0);
+	m_journal.modify(1, "changed");
+	ASSERT_TRUE(m_journal.commit());
+
+	// the script itself is left as it was
+	EXPECT_EQ(readFile(SCRIPT), join(m_lines));
+	EXPECT_EQ(load(), Lines({"end_loop", "changed", "last", "appended"}));
+}
+
+//--------------------------------------------------------------------
+
+TEST_F(ScriptJournalTest, PendingEditsAreNotSaved)
+{
+	m_journal.add(0, "never committed");
+
+	EXPECT_FALSE(ScriptJournal::hasLog(SCRIPT));
+	EXPECT_EQ(load(), m_lines);
+}
+
+//--------------------------------------------------------------------
+
+TEST_F(ScriptJournalTest, CutAtEveryOffsetGivesOldOrNewScript)
+{
+	m_journal.modify(1, "second");
+	ASSERT_TRUE(m_journal.commit());
+	const std::string firstLog=readFile(ScriptJournal::logPath(SCRIPT));
+	const Lines first{"loop:2", "second", "end_loop", "last"};
+
+	m_journal.add(2, "inside");
+	m_journal.remove(4);
+	ASSERT_TRUE(m_journal.commit());
+	const std::string log=readFile(ScriptJournal::logPath(SCRIPT));
+	const Lines second{"loop:2", "second", "inside", "end_loop"};
+	ASSERT_EQ(log.compare(0, firstLog.length(), firstLog), 0);
+
+	// a crash may leave any prefix of the log behind
+	for(size_t cut=0; cut<=log.length(); cut++){
+		writeFile(ScriptJournal::logPath(SCRIPT), log.substr(0, cut));
+
+		size_t logBytes;
+		Lines lines=load(logBytes);
+		if(cut==log.length()){
+			EXPECT_EQ(lines, second) << "cut at " << cut;
+			EXPECT_EQ(logBytes, log.length());
+		}
+		else if(cut>=firstLog.length()){
+			EXPECT_EQ(lines, first) << "cut at " << cut;
+			EXPECT_EQ(logBytes, firstLog.length());
+		}
+		else{
+			EXPECT_EQ(lines, m_lines) << "cut at " << cut;
+			EXPECT_EQ(logBytes, 0u);
+		}
+	}
+}
+
+//--------------------------------------------------------------------
+
+TEST_F(ScriptJournalTest, NextCommitDropsTornTail)
+{
+	m_journal.modify(3, "final");
+	ASSERT_TRUE(m_journal.commit());
+	const std::string committed=readFile(ScriptJournal::logPath(SCRIPT));
+
+	// an interrupted save, without its commit mark
+	writeFile(ScriptJournal::logPath(SCRIPT), committed+"a 0 torn\nr 1\nm 2 half a li");
+
+	size_t logBytes;
+	Lines lines=load(logBytes);
+	EXPECT_EQ(lines, Lines({"loop:2", "first", "end_loop", "final"}));
+	ASSERT_EQ(logBytes, committed.length());
+
+	ScriptJournal journal;
+	journal.attach(SCRIPT, ScriptJournal::contentHash(readFile(SCRIPT)), logBytes);
+	journal.add(4, "after");
+	ASSERT_TRUE(journal.commit());
+
+	EXPECT_EQ(readFile(ScriptJournal::logPath(SCRIPT)), committed+"a 4 after\nc\n");
+	EXPECT_EQ(load(), Lines({"loop:2", "first", "end_loop", "final", "after"}));
+}
+
+//--------------------------------------------------------------------
+
+TEST_F(ScriptJournalTest, BatchThatDoesNotFitIsDropped)
+{
+	m_journal.remove(10);
+	ASSERT_TRUE(m_journal.commit());
+
+	size_t logBytes;
+	EXPECT_EQ(load(logBytes), m_lines);
+	EXPECT_EQ(logBytes, 0u);
+}
+
+//--------------------------------------------------------------------
+
+TEST_F(ScriptJournalTest, LogOfAnotherVersionIsIgnored)
+{
+	m_journal.add(0, "stale");
+	ASSERT_TRUE(m_journal.commit());
+
+	// a full save that stopped after the rename leaves the old log
+	const Lines rewritten{"rewritten", "script"};
+	const std::string data=join(rewritten);
+	ASSERT_TRUE(ScriptJournal::replaceFile(SCRIPT, data));
+	ASSERT_TRUE(ScriptJournal::hasLog(SCRIPT));
+
+	size_t logBytes;
+	EXPECT_EQ(load(logBytes), rewritten);
+	EXPECT_EQ(logBytes, 0u);
+
+	// journaling the new version starts the log over
+	ScriptJournal journal;
+	journal.attach(SCRIPT, ScriptJournal::contentHash(data), logBytes);
+	journal.modify(1, "edited");
+	ASSERT_TRUE(journal.commit());
+
+	std::string log=readFile(ScriptJournal::logPath(SCRIPT));
+	EXPECT_EQ(log.find("stale"), std::string::npos);
+	EXPECT_EQ(load(), Lines({"rewritten", "edited"}));
+}
+
+//--------------------------------------------------------------------
+
+TEST_F(ScriptJournalTest, CompactionWritesTheScriptInFull)
+{
+	const std::string longLine(4096, 'x');
+	Lines lines=m_lines;
+	while(!m_journal.needsCompaction()){
+		m_journal.add(lines.size(), longLine);
+		lines.push_back(longLine);
+		ASSERT_TRUE(m_journal.commit());
+	}
+	EXPECT_EQ(load(), lines);
+
+	m_journal.remove(0);
+	lines.erase(lines.begin());
+	fullSave(m_journal, lines);
+
+	EXPECT_FALSE(ScriptJournal::hasLog(SCRIPT));
+	EXPECT_EQ(readFile(SCRIPT), join(lines));
+	EXPECT_EQ(load(), lines);
+	EXPECT_FALSE(m_journal.needsCompaction());
+}
+
+//====================================================================
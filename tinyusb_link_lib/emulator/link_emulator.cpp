@@ -0,0 +1,432 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE. 
+*
+* struct HidReport                                                   *
+* class LinkEmulator                                                 *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "TinyUSB_Link_Lib/link_emulator.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+//====================================================================
+
+namespace
+{
+	int64_t nowUs()
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+}
+
+//====================================================================
+
+LinkEmulator::LinkEmulator(uint32_t latency, double lossRate, uint32_t seed)
+: m_thread(nullptr)
+, m_random(seed)
+, m_packets(0)
+, m_dropped(0)
+, m_handshakes(0)
+, m_rejected(0)
+, m_lost(0)
+, m_lossRate(lossRate)
+, m_latency(latency)
+, m_udpFd(-1)
+, m_ptyFd(-1)
+, m_slaveFd(-1)
+, m_wakeFd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+, m_replyFd(-1)
+, m_udpPort(0)
+, m_ackPending(false)
+, m_running(false)
+{
+	std::memset(&m_peer, 0, sizeof(m_peer));
+	std::memset(m_endpoints, 0, sizeof(m_endpoints));
+}
+
+//--------------------------------------------------------------------
+
+LinkEmulator::~LinkEmulator()
+{
+	stop();
+	if(m_udpFd>-1){
+		close(m_udpFd);
+	}
+	if(m_ptyFd>-1){
+		close(m_ptyFd);
+	}
+	if(m_slaveFd>-1){
+		close(m_slaveFd);
+	}
+	if(m_wakeFd>-1){
+		close(m_wakeFd);
+	}
+}
+
+//--------------------------------------------------------------------
+
+bool LinkEmulator::startUDP(uint16_t port)
+{
+	if(m_udpFd>-1){
+		return true;
+	}
+
+	m_udpFd=::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+	if(m_udpFd<0){
+		return false;
+	}
+
+	sockaddr_in addr;
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sin_family=AF_INET;
+	addr.sin_port=htons(port);
+	addr.sin_addr.s_addr=inet_addr("127.0.0.1");
+
+	socklen_t length=sizeof(addr);
+	if(::bind(m_udpFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr))!=0
+		|| ::getsockname(m_udpFd, reinterpret_cast<sockaddr*>(&addr), &length)!=0)
+	{
+		close(m_udpFd);
+		m_udpFd=-1;
+		return false;
+	}
+
+	m_udpPort=ntohs(addr.sin_port);
+	start();
+
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+bool LinkEmulator::startSerial()
+{
+	if(m_ptyFd>-1){
+		return true;
+	}
+
+	int slaveFd;
+	char name[128];
+	if(openpty(&m_ptyFd, &slaveFd, name, nullptr, nullptr)!=0){
+		return false;
+	}
+
+	// raw on our side, the client configures its own side
+	struct termios tty;
+	tcgetattr(m_ptyFd, &tty);
+	cfmakeraw(&tty);
+	tcsetattr(m_ptyFd, TCSANOW, &tty);
+
+	// our copy of the slave keeps the master from reporting POLLHUP
+	// while no client has it open
+	m_serialPath=name;
+	m_slaveFd=slaveFd;
+
+	start();
+
+	return true;
+}
+
+//--------------------------------------------------------------------
+
+void LinkEmulator::start()
+{
+	if(m_thread){
+		// the loop picks up the new descriptor after a wake up
+		uint64_t one=1;
+		if(write(m_wakeFd, &one, sizeof(one))<0){}
+		return;
+	}
+
+	m_running=true;
+	m_thread=new std::thread([this](){
+		run();
+	});
+}
+
+//--------------------------------------------------------------------
+
+void LinkEmulator::stop()
+{
+	if(!m_thread){
+		return;
+	}
+
+	m_running=false;
+	uint64_t one=1;
+	if(write(m_wakeFd, &one, sizeof(one))<0){}
+
+	if(m_thread->joinable()){
+		m_thread->join();
+	}
+	delete m_thread;
+	m_thread=nullptr;
+}
+
+//--------------------------------------------------------------------
+
+void LinkEmulator::run()
+{
+	uint8_t buffer[256];
+	while(m_running){
+		pollfd fds[3];
+		int count=0;
+		fds[count++]={m_wakeFd, POLLIN, 0};
+		if(m_udpFd>-1){
+			fds[count++]={m_udpFd, POLLIN, 0};
+		}
+		if(m_ptyFd>-1){
+			fds[count++]={m_ptyFd, POLLIN, 0};
+		}
+
+		int r=poll(fds, count, nextCompletion(nowUs()));
+
+		// the host polls whether or not a packet came
+		for(int i=nextCompletion(nowUs()); i==0; i=nextCompletion(nowUs())){
+			int64_t now=nowUs();
+			EndpointId endpoint=KEYBOARD_EP;
+			if(!m_endpoints[KEYBOARD_EP].m_busy
+				|| (m_endpoints[MOUSE_EP].m_busy && m_endpoints[MOUSE_EP].m_completes<m_endpoints[KEYBOARD_EP].m_completes))
+			{
+				endpoint=MOUSE_EP;
+			}
+			complete(endpoint, now);
+		}
+
+		if(r<=0){
+			continue;
+		}
+
+		if(fds[0].revents!=0){
+			uint64_t value;
+			if(read(m_wakeFd, &value, sizeof(value))<0){}
+			continue;
+		}
+
+		for(int i=1; i<count; i++){
+			if(fds[i].fd==m_udpFd && (fds[i].revents & POLLIN)){
+				socklen_t length=sizeof(m_peer);
+				ssize_t r=::recvfrom(m_udpFd, buffer, sizeof(buffer), 0, reinterpret_cast<sockaddr*>(&m_peer), &length);
+				if(r>0){
+					handlePacket(m_udpFd, buffer, r);
+				}
+			}
+			else if(fds[i].fd==m_ptyFd && (fds[i].revents & POLLIN)){
+				// the client writes a whole packet and waits for the answer,
+				// so one read is one packet
+				ssize_t r=read(m_ptyFd, buffer, sizeof(buffer));
+				if(r>0){
+					handlePacket(m_ptyFd, buffer, r);
+				}
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------------
+
+void LinkEmulator::handlePacket(int fd, const uint8_t* data, size_t size)
+{
+	m_packets.fetch_add(1, std::memory_order_relaxed);
+
+	if(m_lossRate>0 && std::uniform_real_distribution<double>(0.0, 1.0)(m_random)<m_lossRate){
+		m_dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	if(m_latency>0){
+		std::this_thread::sleep_for(std::chrono::microseconds(m_latency));
+	}
+
+	m_replyFd=fd;
+
+	if(m_endpoints[KEYBOARD_EP].m_busy && m_endpoints[MOUSE_EP].m_busy){
+		m_rejected.fetch_add(1, std::memory_order_relaxed);
+		answer(fd, "Failed");
+		return;
+	}
+
+	if(size==2){
+		if(data[0]==KEYBOARD_START && data[1]==KEYBOARD_END){
+			m_handshakes.fetch_add(1, std::memory_order_relaxed);
+			answer(fd, "OK");
+		}
+		return;
+	}
+
+	HidReport report;
+	std::memset(&report, 0, sizeof(report));
+	report.m_time=nowUs();
+
+	if(data[0]==KEYBOARD_START){
+		report.m_kind=HidReport::KEYBOARD;
+		int keyCount=0;
+		for(size_t i=0; i<size; i++){
+			if(data[i]==KEYBOARD_START){
+				std::memset(report.m_keys, 0, sizeof(report.m_keys));
+				report.m_modifier=0;
+				keyCount=0;
+			}
+			else if(data[i]==KEYBOARD_END){
+				submit(KEYBOARD_EP, report);
+			}
+			else if(data[i]>0xD9){
+				if(data[i]<KEYBOARD_START){
+					report.m_modifier|=1<<(data[i]-0xE0);
+				}
+			}
+			else if(keyCount<6){
+				report.m_keys[keyCount++]=data[i];
+			}
+		}
+	}
+	else if(data[0]==MOUSE_START && size<8 && size>=6){
+		report.m_kind=HidReport::MOUSE;
+		report.m_buttons=data[1];
+		report.m_x=static_cast<int8_t>(data[2]);
+		report.m_y=static_cast<int8_t>(data[3]);
+		report.m_scrollV=static_cast<int8_t>(data[4]);
+		report.m_scrollH=static_cast<int8_t>(data[5]);
+		submit(MOUSE_EP, report);
+	}
+	else if(data[0]==MOUSE_START && size==8){
+		report.m_kind=HidReport::ABS_MOUSE;
+		report.m_buttons=data[1];
+		std::memcpy(&report.m_x, data+2, 2);
+		std::memcpy(&report.m_y, data+4, 2);
+		report.m_scrollV=static_cast<int8_t>(data[6]);
+		report.m_scrollH=static_cast<int8_t>(data[7]);
+		submit(MOUSE_EP, report);
+
+		char msg[64];
+		std::snprintf(msg, sizeof(msg), "position: (%d, %d)", report.m_x, report.m_y);
+		answer(fd, msg);
+	}
+}
+
+//--------------------------------------------------------------------
+
+void LinkEmulator::submit(EndpointId endpoint, const HidReport& report)
+{
+	// the firmware flags the answer even when the report is refused
+	m_ackPending=true;
+
+	if(m_endpoints[endpoint].m_busy){
+		m_lost.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	record(report);
+	m_endpoints[endpoint].m_busy=true;
+	m_endpoints[endpoint].m_completes=report.m_time+POLL_INTERVAL;
+}
+
+//--------------------------------------------------------------------
+
+void LinkEmulator::complete(EndpointId endpoint, int64_t now)
+{
+	m_endpoints[endpoint].m_busy=false;
+
+	if(!m_ackPending){
+		return;
+	}
+
+	m_ackPending=false;
+	if(endpoint==KEYBOARD_EP){
+		HidReport release;
+		std::memset(&release, 0, sizeof(release));
+		release.m_time=now;
+		release.m_kind=HidReport::KEYBOARD;
+		record(release);
+		m_endpoints[KEYBOARD_EP].m_busy=true;
+		m_endpoints[KEYBOARD_EP].m_completes=now+POLL_INTERVAL;
+	}
+
+	if(m_replyFd>-1){
+		answer(m_replyFd, "OK");
+	}
+}
+
+//--------------------------------------------------------------------
+
+int LinkEmulator::nextCompletion(int64_t now) const
+{
+	int64_t next=-1;
+	for(int i=0; i<ENDPOINT_COUNT; i++){
+		if(m_endpoints[i].m_busy && (next<0 || m_endpoints[i].m_completes<next)){
+			next=m_endpoints[i].m_completes;
+		}
+	}
+
+	if(next<0){
+		return -1;
+	}
+
+	if(next<=now){
+		return 0;
+	}
+
+	// rounded up, poll() would otherwise wake up early and spin
+	return static_cast<int>((next-now+999)/1000);
+}
+
+//--------------------------------------------------------------------
+
+void LinkEmulator::record(const HidReport& report)
+{
+	std::lock_guard<std::mutex> lck(m_mtx);
+	m_reports.push_back(report);
+}
+
+//--------------------------------------------------------------------
+
+void LinkEmulator::answer(int fd, const char* msg)
+{
+	ssize_t r;
+	if(fd==m_udpFd){
+		r=::sendto(m_udpFd, msg, std::strlen(msg), 0, reinterpret_cast<sockaddr*>(&m_peer), sizeof(m_peer));
+	}
+	else{
+		r=write(fd, msg, std::strlen(msg));
+	}
+	(void) r;
+}
+
+//--------------------------------------------------------------------
+
+std::vector<HidReport> LinkEmulator::reports() const
+{
+	std::lock_guard<std::mutex> lck(m_mtx);
+	return m_reports;
+}
+
+//--------------------------------------------------------------------
+
+void LinkEmulator::clearReports()
+{
+	std::lock_guard<std::mutex> lck(m_mtx);
+	m_reports.clear();
+}
+
+//====================================================================
@@ -0,0 +1,121 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE. 
+*
+* tinyusb_link_emulator: stand-in for the Pico, prints what it gets  *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "TinyUSB_Link_Lib/link_emulator.h"
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//====================================================================
+
+static volatile std::sig_atomic_t s_stop=0;
+
+static void onSignal(int)
+{
+	s_stop=1;
+}
+
+//--------------------------------------------------------------------
+
+static void printReport(const HidReport& report)
+{
+	if(report.m_kind==HidReport::KEYBOARD){
+		std::printf("%ld keyboard mod=0x%02x keys=%02x %02x %02x %02x %02x %02x\n",
+					long(report.m_time), report.m_modifier,
+					report.m_keys[0], report.m_keys[1], report.m_keys[2],
+					report.m_keys[3], report.m_keys[4], report.m_keys[5]);
+	}
+	else{
+		std::printf("%ld %s btn=0x%02x x=%d y=%d v=%d h=%d\n",
+					long(report.m_time), report.m_kind==HidReport::MOUSE ? "mouse" : "abs mouse",
+					report.m_buttons, report.m_x, report.m_y, report.m_scrollV, report.m_scrollH);
+	}
+}
+
+//====================================================================
+
+int main(int argc, char** argv)
+{
+	uint16_t port=0;
+	bool udp=false;
+	bool serial=false;
+	uint32_t latency=0;
+	double loss=0;
+
+	for(int i=1; i<argc; i++){
+		if(std::strcmp(argv[i], "--udp")==0){
+			udp=true;
+			if(i+1<argc && argv[i+1][0]!='-'){
+				port=std::atoi(argv[++i]);
+			}
+		}
+		else if(std::strcmp(argv[i], "--serial")==0){
+			serial=true;
+		}
+		else if(std::strcmp(argv[i], "--latency")==0 && i+1<argc){
+			latency=std::atoi(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--loss")==0 && i+1<argc){
+			loss=std::atof(argv[++i]);
+		}
+		else{
+			std::printf("usage: %s [--udp [port]] [--serial] [--latency us] [--loss fraction]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if(!udp && !serial){
+		udp=true;
+	}
+
+	LinkEmulator emulator(latency, loss);
+	if(udp){
+		if(!emulator.startUDP(port)){
+			std::printf("cannot bind UDP port %u\n", port);
+			return 1;
+		}
+		std::printf("UDP: 127.0.0.1 %u\n", emulator.udpPort());
+	}
+	if(serial){
+		if(!emulator.startSerial()){
+			std::printf("cannot create a pty\n");
+			return 1;
+		}
+		std::printf("serial: %s\n", emulator.serialPath().c_str());
+	}
+	std::fflush(stdout);
+
+	std::signal(SIGINT, onSignal);
+	std::signal(SIGTERM, onSignal);
+
+	size_t printed=0;
+	while(!s_stop){
+		std::vector<HidReport> reports=emulator.reports();
+		for(; printed<reports.size(); printed++){
+			printReport(reports[printed]);
+		}
+		std::fflush(stdout);
+		usleep(100000);
+	}
+
+	emulator.stop();
+	std::printf("packets: %lu, dropped: %lu, handshakes: %lu, rejected: %lu, lost: %lu\n",
+				(unsigned long)emulator.packets(), (unsigned long)emulator.dropped(), (unsigned long)emulator.handshakes(),
+				(unsigned long)emulator.rejected(), (unsigned long)emulator.lost());
+
+	return 0;
+}
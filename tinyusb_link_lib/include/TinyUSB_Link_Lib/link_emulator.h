@@ -0,0 +1,197 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE. 
+*
+* struct HidReport                                                   *
+* class LinkEmulator                                                 *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _LINK_EMULATOR_H
+#define _LINK_EMULATOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+
+//====================================================================
+
+struct HidReport
+{
+	enum Kind
+	{
+		KEYBOARD,
+		MOUSE,      // relative movement
+		ABS_MOUSE,
+	};
+
+	int64_t m_time; // microseconds, steady clock
+	Kind m_kind;
+	uint8_t m_modifier;
+	uint8_t m_keys[6];
+	uint8_t m_buttons;
+	int16_t m_x;
+	int16_t m_y;
+	int8_t m_scrollV;
+	int8_t m_scrollH;
+};
+
+//====================================================================
+
+/*
+ * Host side stand-in for the Pico firmware (hid_keyboard_and_mouse).
+ * It speaks the same protocol on a local UDP socket and on a pty:
+ *  - 0xE8 0xE9 alone is the handshake,
+ *  - 0xE8 ... 0xE9 frames are keyboard reports (0xE0-0xE7 modifiers),
+ *  - 0xEB + 5 bytes is a relative mouse report, 0xEB + 7 an absolute one.
+ * The reports are recorded instead of being sent to a host, but the
+ * answers follow main.c:
+ *  - each endpoint is busy for one bInterval after a report is queued,
+ *    a report for a busy endpoint is lost, and a packet arriving while
+ *    both are busy is answered "Failed",
+ *  - "OK" goes out when a report completes, not when the packet comes,
+ *  - a completed keyboard report queues the key release (an empty
+ *    keyboard report), which keeps the keyboard busy one more interval,
+ *  - an absolute mouse report is answered "position: (x, y)" at once.
+ * Latency and packet loss can be set to see how the link layer copes.
+ * */
+class LinkEmulator
+{
+	public:
+		// @param latency microseconds before a packet is handled,
+		// @param lossRate fraction of packets silently dropped
+		LinkEmulator(uint32_t latency=0, double lossRate=0.0, uint32_t seed=1);
+		~LinkEmulator();
+
+		// on 127.0.0.1, @param port 0 picks a free one
+		bool startUDP(uint16_t port=0);
+
+		// create a pty pair, the client opens serialPath()
+		bool startSerial();
+
+		void stop();
+
+		uint16_t udpPort() const
+		{
+			return m_udpPort;
+		}
+
+		const std::string& serialPath() const
+		{
+			return m_serialPath;
+		}
+
+		std::vector<HidReport> reports() const;
+
+		void clearReports();
+
+		uint64_t packets() const
+		{
+			return m_packets.load(std::memory_order_relaxed);
+		}
+
+		uint64_t dropped() const
+		{
+			return m_dropped.load(std::memory_order_relaxed);
+		}
+
+		uint64_t handshakes() const
+		{
+			return m_handshakes.load(std::memory_order_relaxed);
+		}
+
+		// packets answered "Failed"
+		uint64_t rejected() const
+		{
+			return m_rejected.load(std::memory_order_relaxed);
+		}
+
+		// reports queued on a busy endpoint
+		uint64_t lost() const
+		{
+			return m_lost.load(std::memory_order_relaxed);
+		}
+
+	private:
+		enum Markers
+		{
+			KEYBOARD_START=0xE8,
+			KEYBOARD_END=0xE9,
+			MOUSE_START=0xEB,
+		};
+
+		enum
+		{
+			POLL_INTERVAL=10000, // microseconds, bInterval of both HID endpoints
+		};
+
+		enum EndpointId
+		{
+			KEYBOARD_EP,
+			MOUSE_EP,
+			ENDPOINT_COUNT,
+		};
+
+		struct Endpoint
+		{
+			int64_t m_completes; // microseconds, steady clock
+			bool m_busy;
+		};
+
+		mutable std::mutex m_mtx;
+		std::vector<HidReport> m_reports;
+		std::string m_serialPath;
+		std::thread* m_thread;
+		std::mt19937 m_random;
+		sockaddr_in m_peer;
+		std::atomic<uint64_t> m_packets;
+		std::atomic<uint64_t> m_dropped;
+		std::atomic<uint64_t> m_handshakes;
+		std::atomic<uint64_t> m_rejected;
+		std::atomic<uint64_t> m_lost;
+		Endpoint m_endpoints[ENDPOINT_COUNT];
+		double m_lossRate;
+		uint32_t m_latency;
+		int m_udpFd;
+		int m_ptyFd;
+		int m_slaveFd;
+		int m_wakeFd;
+		int m_replyFd;
+		uint16_t m_udpPort;
+		bool m_ackPending; // kbrd in main.c
+		std::atomic<bool> m_running;
+
+		void start();
+		void run();
+
+		void handlePacket(int fd, const uint8_t* data, size_t size);
+
+		// queue a report on an endpoint, as tud_hid_n_*_report does
+		void submit(EndpointId endpoint, const HidReport& report);
+
+		// the host has read the report of the endpoint
+		void complete(EndpointId endpoint, int64_t now);
+
+		// milliseconds until the next completion, -1 for none
+		int nextCompletion(int64_t now) const;
+
+		void record(const HidReport& report);
+		void answer(int fd, const char* msg);
+};
+
+//====================================================================
+
+#endif
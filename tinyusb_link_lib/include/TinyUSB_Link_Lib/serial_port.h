@@ -19,13 +19,22 @@
 
 #include "TinyUSB_Link_Lib/connector_interface.h"
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include <termios.h> // Contains POSIX terminal control definitions
 #include <unistd.h>  // write(), read(), close()
 
 //====================================================================
 
+/*
+ * The port is opened non-blocking. Data sent is queued and written in
+ * one go when the acknowledgement is awaited, waits are done with
+ * ppoll so they end as soon as the answer arrives. The baud rate is
+ * given in bits per second (or as one of BAUD_RATE), rates without
+ * a Bxxx constant are set with termios2.
+ * */
 class SerialPort : public ConnectorI
 {
 	public:
@@ -59,6 +68,7 @@ class SerialPort : public ConnectorI
 		, m_readTimeout(readTimeout)
 		, m_baudRate(baudRate)
 		, m_isActive(false)
+		, m_ackPending(false)
 		{}
 
 		SerialPort(unsigned int readTimeout, BAUD_RATE baudRate=BAUD_RATE::B_9600)
@@ -77,6 +87,8 @@ class SerialPort : public ConnectorI
 
 		virtual ssize_t send(const void* data, const size_t dataSize) override;
 
+		// wait up to @param timeout milliseconds for the answer to what
+		// was sent
 		virtual bool receive(int timeout=50) override;
 
 		virtual bool isActive() const override;
@@ -88,14 +100,19 @@ class SerialPort : public ConnectorI
 
 	private:
 		std::string m_portPath;
+		std::vector<uint8_t> m_outBuffer;
 		struct termios m_tty;
 		int m_serialPort;
-		unsigned int m_readTimeout; // in deciseconds
+		unsigned int m_readTimeout; // in deciseconds, for receive(buffer, size)
 		unsigned int m_baudRate;
 		bool m_isActive;
+		bool m_ackPending; // the last wait timed out, its answer may still come
 
 		void closeSerial();
 		void setTimeoutAndBaudRate();
+		bool flush();
+		void discardInput();
+		bool waitFor(short events, int timeout);
 };
 
 //--------------------------------------------------------------------
@@ -112,33 +129,6 @@ inline bool SerialPort::isActive() const
 	return m_isActive;
 }
 
-//--------------------------------------------------------------------
-
-inline ssize_t SerialPort::send(const void* data, const size_t dataSize)
-{
-	return write(m_serialPort, data, dataSize);
-}
-
-//--------------------------------------------------------------------
-
-inline ssize_t SerialPort::receive(void* buffer, const size_t bufferSize)
-{
-	/*
-	// Read bytes. The behaviour of read() (e.g. does it block?,
-	// how long does it block for?) depends on the configuration
-	// settings above, specifically VMIN and VTIME
-	// */
-	return read(m_serialPort, buffer, bufferSize);
-}
-
-//--------------------------------------------------------------------
-
-inline bool SerialPort::receive(int timeout)
-{
-	static char recBuffer[64];
-	return 0<receive(recBuffer, 64);
-}
-
 //====================================================================
 
 #endif
@@ -18,10 +18,9 @@
 
 #include "TinyUSB_Link_Lib/connector_interface.h"
 
+#include <cerrno>
+#include <cstdint>
 #include <cstring>
-#include <thread>
-#include <mutex>
-#include <condition_variable>
 
 #include <unistd.h>
 #include <sys/socket.h>
@@ -30,6 +29,15 @@
 
 //--------------------------------------------------------------------
 
+/*
+ * The device answers every packet with one datagram, so the n-th
+ * datagram received acknowledges the n-th packet sent. The caller
+ * waits in receive(timeout) polling the socket itself, there is no
+ * listener thread. An acknowledgement that arrives after its wait
+ * timed out, or a duplicate, is discarded when the next packet is sent,
+ * so it is not taken for the answer to that one; a lost datagram does
+ * not shift the count either.
+ * */
 class UDPClient : public ConnectorI
 {
 	struct SocketManager
@@ -62,23 +70,28 @@ class UDPClient : public ConnectorI
 
 		virtual ssize_t send(const void* data, const size_t dataSize) override;
 
+		// wait up to @param timeout milliseconds for the acknowledgement
+		// of the last packet sent
 		virtual bool receive(int timeout=50) override;
 
 		virtual bool isActive() const override;
 
 		const char* getLastError() const;
 
+		// it also wakes up a thread waiting in receive
 		void closeConnection();
 
 	private:
 		sockaddr_in m_addr;
-		std::mutex m_mtx;
-		std::condition_variable m_cv;
-		std::thread* m_listeningThreadPtr;
+		uint64_t m_sent;
+		uint64_t m_acked;
 		int m_fd;
+		int m_wakeFd;
 		int m_lastError;
 		bool m_running;
+
 		bool isSameSocket(const char* ip, uint port);
+		void drain();
 };
 
 //--------------------------------------------------------------------
@@ -94,19 +107,17 @@ inline ssize_t UDPClient::receive(void* buffer, const size_t bufferSize)
 
 inline ssize_t UDPClient::send(const void* data, const size_t dataSize)
 {
-	auto r=::send(m_fd, data, dataSize, 0);
-	return r;
-}
+	// whatever came since the last wait is not an answer to this packet:
+	// a late answer to a packet whose wait timed out, or a duplicate; a
+	// packet that never got one is given up on
+	drain();
+	m_acked=m_sent;
 
-//--------------------------------------------------------------------
-
-inline bool UDPClient::receive(int timeout)
-{
-	std::unique_lock<std::mutex> lck(m_mtx);
-	if(m_cv.wait_for(lck, std::chrono::milliseconds(timeout))==std::cv_status::timeout){
-		return false;
+	auto r=::send(m_fd, data, dataSize, 0);
+	if(r>0){
+		m_sent++;
 	}
-	return true;
+	return r;
 }
 
 //--------------------------------------------------------------------
@@ -123,17 +134,6 @@ inline const char* UDPClient::getLastError() const
 	return strerror(m_lastError);
 }
 
-//--------------------------------------------------------------------
-
-inline void UDPClient::closeConnection()
-{
-	if(m_fd>0){
-		shutdown(m_fd, SHUT_RDWR);
-		close(m_fd);
-		m_fd=-1;
-	}
-}
-
 //====================================================================
 
 #endif
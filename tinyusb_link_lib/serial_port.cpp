@@ -15,19 +15,61 @@
 * Author:  Dan Machado                                               *                                         *
 **********************************************************************/
 #include "TinyUSB_Link_Lib/serial_port.h"
+#include "serial_speed.h"
 
+#include <chrono>
 #include <string.h>
 
 #include <fcntl.h>   // Contains file controls like O_RDWR
 #include <errno.h>   // Error integer and strerror() function
+#include <poll.h>
+
+//====================================================================
+
+namespace
+{
+	struct BaudRate
+	{
+		unsigned int m_rate;
+		speed_t m_speed;
+	};
+
+	const BaudRate s_baudRates[]={
+		{50, B50}, {75, B75}, {110, B110}, {134, B134}, {150, B150},
+		{200, B200}, {300, B300}, {600, B600}, {1200, B1200}, {1800, B1800},
+		{2400, B2400}, {4800, B4800}, {9600, B9600}, {19200, B19200},
+		{38400, B38400}, {57600, B57600}, {115200, B115200}, {230400, B230400},
+		{460800, B460800},
+#ifdef B4000000
+		{500000, B500000}, {576000, B576000}, {921600, B921600},
+		{1000000, B1000000}, {1152000, B1152000}, {1500000, B1500000},
+		{2000000, B2000000}, {2500000, B2500000}, {3000000, B3000000},
+		{3500000, B3500000}, {4000000, B4000000},
+#endif
+	};
+
+	// @param baudRate is a rate in bits per second or a Bxxx constant,
+	// it returns B0 if there is no constant for it
+	speed_t standardSpeed(unsigned int baudRate)
+	{
+		for(const BaudRate& data : s_baudRates){
+			if(data.m_rate==baudRate || data.m_speed==baudRate){
+				return data.m_speed;
+			}
+		}
+		return B0;
+	}
+}
 
 //====================================================================
 
 bool SerialPort::connect(const char* serialPortPath)
 {
 	m_portPath=serialPortPath;
-	m_serialPort=open(serialPortPath, O_RDWR);
+	m_serialPort=open(serialPortPath, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
 	m_isActive=true;
+	m_ackPending=false;
+	m_outBuffer.clear();
 
 	if(tcgetattr(m_serialPort, &m_tty) != 0) {
 		m_isActive=false;
@@ -67,17 +109,137 @@ void SerialPort::setTimeoutAndBaudRate()
 		return;
 	}
 
-	m_tty.c_cc[VMIN] = 0; // read doesn't block
-	m_tty.c_cc[VTIME] = m_readTimeout; // deciseconds to wait for but returning as soon as any data is received.
+	// reads never block, waits are done with poll
+	m_tty.c_cc[VMIN] = 0;
+	m_tty.c_cc[VTIME] = 0;
 
-	// Set in/out baud rate to be 9600
-	cfsetispeed(&m_tty, m_baudRate);
-	cfsetospeed(&m_tty, m_baudRate);
+	speed_t speed=standardSpeed(m_baudRate);
+	cfsetispeed(&m_tty, speed!=B0 ? speed : B38400);
+	cfsetospeed(&m_tty, speed!=B0 ? speed : B38400);
 	// Save tty settings, also checking for error
 	
 	if(tcsetattr(m_serialPort, TCSANOW, &m_tty) != 0) {
 		m_isActive=false;
+		return;
+	}
+
+	if(speed==B0 && !setCustomBaudRate(m_serialPort, m_baudRate)){
+		m_isActive=false;
+	}
+}
+
+//--------------------------------------------------------------------
+
+bool SerialPort::waitFor(short events, int timeout)
+{
+	const auto deadline=std::chrono::steady_clock::now()+std::chrono::milliseconds(timeout);
+	pollfd fd;
+	fd.fd=m_serialPort;
+	fd.events=events;
+	while(true){
+		auto remaining=std::chrono::duration_cast<std::chrono::microseconds>(deadline-std::chrono::steady_clock::now());
+		if(remaining.count()<0){
+			return false;
+		}
+
+		timespec ts;
+		ts.tv_sec=remaining.count()/1000000;
+		ts.tv_nsec=(remaining.count()%1000000)*1000;
+
+		int r=ppoll(&fd, 1, &ts, nullptr);
+		if(r>0){
+			// POLLERR/POLLHUP, e.g. the device was unplugged
+			if((fd.revents & events)==0){
+				m_isActive=false;
+				return false;
+			}
+			return true;
+		}
+		if(r<0 && errno!=EINTR){
+			return false;
+		}
+	}
+}
+
+//--------------------------------------------------------------------
+
+bool SerialPort::flush()
+{
+	size_t written=0;
+	while(written<m_outBuffer.size()){
+		ssize_t r=write(m_serialPort, m_outBuffer.data()+written, m_outBuffer.size()-written);
+		if(r>0){
+			written+=r;
+		}
+		else if(r<0 && errno!=EAGAIN && errno!=EINTR){
+			break;
+		}
+		else if(r<0 && errno==EAGAIN && !waitFor(POLLOUT, 100)){
+			break;
+		}
+	}
+
+	bool ok=written==m_outBuffer.size();
+	m_outBuffer.clear();
+	return ok;
+}
+
+//--------------------------------------------------------------------
+
+void SerialPort::discardInput()
+{
+	char buffer[64];
+	while(read(m_serialPort, buffer, sizeof(buffer))>0){}
+}
+
+//--------------------------------------------------------------------
+
+ssize_t SerialPort::send(const void* data, const size_t dataSize)
+{
+	if(!m_isActive){
+		return -1;
+	}
+
+	if(m_ackPending){
+		// a late answer must not be taken for the answer to this packet
+		discardInput();
+		m_ackPending=false;
+	}
+
+	const uint8_t* bytes=static_cast<const uint8_t*>(data);
+	m_outBuffer.insert(m_outBuffer.end(), bytes, bytes+dataSize);
+	return dataSize;
+}
+
+//--------------------------------------------------------------------
+
+ssize_t SerialPort::receive(void* buffer, const size_t bufferSize)
+{
+	if(!m_isActive || !flush()){
+		return -1;
+	}
+
+	if(!waitFor(POLLIN, m_readTimeout*100)){
+		return 0;
+	}
+	return read(m_serialPort, buffer, bufferSize);
+}
+
+//--------------------------------------------------------------------
+
+bool SerialPort::receive(int timeout)
+{
+	if(!m_isActive || !flush()){
+		return false;
+	}
+
+	char recBuffer[64];
+	m_ackPending=true;
+	if(waitFor(POLLIN, timeout) && read(m_serialPort, recBuffer, sizeof(recBuffer))>0){
+		m_ackPending=false;
+		return true;
 	}
+	return false;
 }
 
 //--------------------------------------------------------------------
@@ -97,10 +259,11 @@ bool SerialPort::reset(const char* serialPortPath, unsigned int readTimeout, uns
 
 void SerialPort::closeSerial()
 {
-	if(m_serialPort>0){
+	if(m_serialPort>-1){
 		close(m_serialPort);
-		m_serialPort=0;	
+		m_serialPort=-1;
 	}
+	m_outBuffer.clear();
 	m_isActive=false;
 }
 
@@ -0,0 +1,42 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE. 
+*
+* function setCustomBaudRate                                         *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "serial_speed.h"
+
+#include <sys/ioctl.h>
+#include <asm/termbits.h>
+
+//====================================================================
+
+bool setCustomBaudRate(int fd, unsigned int baudRate)
+{
+#if defined(TCGETS2) && defined(BOTHER)
+	struct termios2 tty;
+	if(ioctl(fd, TCGETS2, &tty)!=0){
+		return false;
+	}
+
+	tty.c_cflag&=~CBAUD;
+	tty.c_cflag|=BOTHER;
+	tty.c_ispeed=baudRate;
+	tty.c_ospeed=baudRate;
+
+	return ioctl(fd, TCSETS2, &tty)==0;
+#else
+	return false;
+#endif
+}
+
+//====================================================================
@@ -0,0 +1,30 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE. 
+*
+* function setCustomBaudRate                                         *
+*         	                                                         *
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#ifndef _SERIAL_SPEED_H
+#define _SERIAL_SPEED_H
+
+//====================================================================
+
+/*
+ * Set any baud rate on @param fd through termios2/BOTHER. It lives in
+ * its own translation unit because <asm/termbits.h> cannot be included
+ * together with <termios.h>. It returns false where it is not supported.
+ * */
+bool setCustomBaudRate(int fd, unsigned int baudRate);
+
+//====================================================================
+
+#endif
@@ -0,0 +1,181 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "TinyUSB_Link_Lib/link_emulator.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+//====================================================================
+
+namespace {
+
+// a bare UDP end, it shows every answer of the emulator
+class Host
+{
+	public:
+		Host(uint16_t port)
+		: m_fd(::socket(AF_INET, SOCK_DGRAM, 0))
+		{
+			sockaddr_in addr;
+			std::memset(&addr, 0, sizeof(addr));
+			addr.sin_family=AF_INET;
+			addr.sin_addr.s_addr=htonl(INADDR_LOOPBACK);
+			addr.sin_port=htons(port);
+			::connect(m_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+		}
+
+		~Host()
+		{
+			::close(m_fd);
+		}
+
+		void send(const uint8_t* data, size_t size)
+		{
+			ASSERT_EQ(::send(m_fd, data, size, 0), ssize_t(size));
+		}
+
+		// the next answer, empty if none came in time
+		std::string receive(int timeout=1000)
+		{
+			pollfd fd={m_fd, POLLIN, 0};
+			if(poll(&fd, 1, timeout)<=0){
+				return std::string();
+			}
+
+			char buffer[64];
+			ssize_t r=::recv(m_fd, buffer, sizeof(buffer), 0);
+			return r>0 ? std::string(buffer, r) : std::string();
+		}
+
+	private:
+		int m_fd;
+};
+
+//--------------------------------------------------------------------
+
+const uint8_t KEY_A[]={0xE8, 0x04, 0xE9};
+const uint8_t KEY_B[]={0xE8, 0x05, 0xE9};
+const uint8_t KEY_C[]={0xE8, 0x06, 0xE9};
+const uint8_t MOVE[]={0xEB, 0x00, 0x01, 0x01, 0x00, 0x00};
+
+bool hasKey(const std::vector<HidReport>& reports, uint8_t key)
+{
+	for(const HidReport& report : reports){
+		if(report.m_kind==HidReport::KEYBOARD && report.m_keys[0]==key){
+			return true;
+		}
+	}
+	return false;
+}
+
+}
+
+//====================================================================
+
+TEST(LinkEmulator, AckComesWhenTheReportCompletes)
+{
+	LinkEmulator emulator;
+	ASSERT_TRUE(emulator.startUDP());
+	Host host(emulator.udpPort());
+
+	auto start=std::chrono::steady_clock::now();
+	host.send(KEY_A, sizeof(KEY_A));
+	EXPECT_EQ(host.receive(), "OK");
+	EXPECT_GE(std::chrono::steady_clock::now()-start, std::chrono::milliseconds(9));
+
+	// the key press and the release queued after it
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	std::vector<HidReport> reports=emulator.reports();
+	ASSERT_EQ(reports.size(), 2u);
+	EXPECT_EQ(reports[0].m_keys[0], 0x04);
+	EXPECT_EQ(reports[1].m_keys[0], 0x00);
+}
+
+//--------------------------------------------------------------------
+
+TEST(LinkEmulator, ReportRightAfterTheAckIsLost)
+{
+	LinkEmulator emulator;
+	ASSERT_TRUE(emulator.startUDP());
+	Host host(emulator.udpPort());
+
+	host.send(KEY_A, sizeof(KEY_A));
+	ASSERT_EQ(host.receive(), "OK");
+
+	// the release report still holds the keyboard endpoint
+	host.send(KEY_B, sizeof(KEY_B));
+	ASSERT_EQ(host.receive(), "OK");
+	EXPECT_FALSE(hasKey(emulator.reports(), 0x05));
+	EXPECT_EQ(emulator.lost(), 1u);
+
+	// one bInterval after the ack the endpoint is free again
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	host.send(KEY_C, sizeof(KEY_C));
+	ASSERT_EQ(host.receive(), "OK");
+	EXPECT_TRUE(hasKey(emulator.reports(), 0x06));
+	EXPECT_EQ(emulator.lost(), 1u);
+}
+
+//--------------------------------------------------------------------
+
+TEST(LinkEmulator, BothEndpointsBusyAnswersFailed)
+{
+	LinkEmulator emulator;
+	ASSERT_TRUE(emulator.startUDP());
+	Host host(emulator.udpPort());
+
+	host.send(KEY_A, sizeof(KEY_A));
+	host.send(MOVE, sizeof(MOVE));
+	host.send(KEY_B, sizeof(KEY_B));
+
+	EXPECT_EQ(host.receive(), "Failed");
+	EXPECT_EQ(emulator.rejected(), 1u);
+	EXPECT_FALSE(hasKey(emulator.reports(), 0x05));
+}
+
+//--------------------------------------------------------------------
+
+TEST(LinkEmulator, AbsoluteMouseIsAnsweredWithItsPosition)
+{
+	LinkEmulator emulator;
+	ASSERT_TRUE(emulator.startUDP());
+	Host host(emulator.udpPort());
+
+	uint8_t packet[8]={0xEB, 0x00};
+	int16_t x=100;
+	int16_t y=200;
+	std::memcpy(packet+2, &x, 2);
+	std::memcpy(packet+4, &y, 2);
+	host.send(packet, sizeof(packet));
+
+	EXPECT_EQ(host.receive(), "position: (100, 200)");
+	EXPECT_EQ(host.receive(), "OK");
+
+	std::vector<HidReport> reports=emulator.reports();
+	ASSERT_EQ(reports.size(), 1u);
+	EXPECT_EQ(reports[0].m_kind, HidReport::ABS_MOUSE);
+	EXPECT_EQ(reports[0].m_x, 100);
+	EXPECT_EQ(reports[0].m_y, 200);
+}
+
+//====================================================================
@@ -0,0 +1,188 @@
+/*********************************************************************
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+* Version: 1.0                                                       *
+* Date:    09-02-2025                                                *
+* Author:  Dan Machado                                               *
+**********************************************************************/
+#include "TinyUSB_Link_Lib/udp_client.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include <sys/time.h>
+
+//====================================================================
+
+namespace {
+
+// the other end of the link: it answers the packets it is told to
+class FakeDevice
+{
+	public:
+		FakeDevice()
+		: m_fd(::socket(AF_INET, SOCK_DGRAM, 0))
+		, m_port(0)
+		{
+			sockaddr_in addr;
+			std::memset(&addr, 0, sizeof(addr));
+			addr.sin_family=AF_INET;
+			addr.sin_addr.s_addr=htonl(INADDR_LOOPBACK);
+			addr.sin_port=0;
+			::bind(m_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+
+			socklen_t length=sizeof(addr);
+			::getsockname(m_fd, reinterpret_cast<sockaddr*>(&addr), &length);
+			m_port=ntohs(addr.sin_port);
+
+			timeval timeout{1, 0};
+			::setsockopt(m_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+		}
+
+		~FakeDevice()
+		{
+			::close(m_fd);
+		}
+
+		uint16_t port() const
+		{
+			return m_port;
+		}
+
+		// take the next packet, it returns false if none came
+		bool take()
+		{
+			char buffer[64];
+			socklen_t length=sizeof(m_client);
+			return ::recvfrom(m_fd, buffer, sizeof(buffer), 0, reinterpret_cast<sockaddr*>(&m_client), &length)>0;
+		}
+
+		void answer()
+		{
+			char ack=1;
+			::sendto(m_fd, &ack, 1, 0, reinterpret_cast<sockaddr*>(&m_client), sizeof(m_client));
+		}
+
+	private:
+		sockaddr_in m_client;
+		int m_fd;
+		uint16_t m_port;
+};
+
+//--------------------------------------------------------------------
+
+const char PACKET[8]={0};
+
+}
+
+//====================================================================
+
+TEST(UDPClient, EveryPacketIsAcknowledged)
+{
+	FakeDevice device;
+	UDPClient client("127.0.0.1", device.port());
+	ASSERT_TRUE(client.isActive());
+
+	for(int i=0; i<100; i++){
+		ASSERT_EQ(client.send(PACKET, sizeof(PACKET)), ssize_t(sizeof(PACKET)));
+		ASSERT_TRUE(device.take());
+		device.answer();
+		EXPECT_TRUE(client.receive(1000)) << "packet " << i;
+	}
+}
+
+//--------------------------------------------------------------------
+
+TEST(UDPClient, LostAcknowledgementDoesNotShiftTheCount)
+{
+	FakeDevice device;
+	UDPClient client("127.0.0.1", device.port());
+
+	client.send(PACKET, sizeof(PACKET));
+	ASSERT_TRUE(device.take());
+	EXPECT_FALSE(client.receive(20));
+
+	// the packets after the lost one are matched with their own answers
+	for(int i=0; i<10; i++){
+		client.send(PACKET, sizeof(PACKET));
+		ASSERT_TRUE(device.take());
+		device.answer();
+		EXPECT_TRUE(client.receive(1000)) << "packet " << i;
+	}
+}
+
+//--------------------------------------------------------------------
+
+TEST(UDPClient, LateAcknowledgementIsNotTakenForTheNextPacket)
+{
+	FakeDevice device;
+	UDPClient client("127.0.0.1", device.port());
+
+	client.send(PACKET, sizeof(PACKET));
+	ASSERT_TRUE(device.take());
+	EXPECT_FALSE(client.receive(20));
+
+	// the answer to the first packet comes after its wait gave up
+	device.answer();
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+	client.send(PACKET, sizeof(PACKET));
+	ASSERT_TRUE(device.take());
+	EXPECT_FALSE(client.receive(20));
+
+	device.answer();
+	EXPECT_TRUE(client.receive(1000));
+}
+
+//--------------------------------------------------------------------
+
+TEST(UDPClient, UnaskedDatagramAcknowledgesNothing)
+{
+	FakeDevice device;
+	UDPClient client("127.0.0.1", device.port());
+
+	client.send(PACKET, sizeof(PACKET));
+	ASSERT_TRUE(device.take());
+	device.answer();
+	EXPECT_TRUE(client.receive(1000));
+
+	// a second answer to the same packet
+	device.answer();
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+	client.send(PACKET, sizeof(PACKET));
+	ASSERT_TRUE(device.take());
+	EXPECT_FALSE(client.receive(20));
+}
+
+//--------------------------------------------------------------------
+
+TEST(UDPClient, CloseWakesAWaitingReceive)
+{
+	FakeDevice device;
+	UDPClient client("127.0.0.1", device.port());
+
+	client.send(PACKET, sizeof(PACKET));
+
+	auto start=std::chrono::steady_clock::now();
+	std::thread closer([&client](){
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		client.closeConnection();
+	});
+
+	EXPECT_FALSE(client.receive(5000));
+	closer.join();
+
+	EXPECT_LT(std::chrono::steady_clock::now()-start, std::chrono::seconds(2));
+	EXPECT_FALSE(client.isActive());
+}
+
+//====================================================================
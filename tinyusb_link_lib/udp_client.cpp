@@ -15,14 +15,22 @@
 **********************************************************************/
 #include "TinyUSB_Link_Lib/udp_client.h"
 
+#include <chrono>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+
 //====================================================================
 
 UDPClient::UDPClient(const char* ip, uint16_t port)
-: m_listeningThreadPtr(nullptr)
-, m_fd(::socket(AF_INET, SOCK_DGRAM, 0))
+: m_sent(0)
+, m_acked(0)
+, m_fd(::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0))
+, m_wakeFd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
 , m_lastError(errno)
 , m_running(true)
 {
+	std::memset(&m_addr, 0, sizeof(m_addr));
 	if(m_fd>-1 && std::strlen(ip)>0){
 		m_addr.sin_family = AF_INET;
 		m_addr.sin_port = htons(port);
@@ -33,15 +41,6 @@ UDPClient::UDPClient(const char* ip, uint16_t port)
 			m_lastError=errno;
 			m_running=false;
 		}
-		else{
-			m_listeningThreadPtr=new std::thread([this](){
-				char buffer[64]; 
-				while(m_running){
-					receive(buffer, 64);
-					m_cv.notify_one();
-				}
-			});
-		}
 	}
 }
 
@@ -49,15 +48,101 @@ UDPClient::UDPClient(const char* ip, uint16_t port)
 
 UDPClient::~UDPClient()
 {
-	m_running=false;
 	closeConnection();
-	if(m_listeningThreadPtr){
-		if(m_listeningThreadPtr->joinable()){
-			m_listeningThreadPtr->join();
+	if(m_wakeFd>-1){
+		close(m_wakeFd);
+		m_wakeFd=-1;
+	}
+}
+
+//--------------------------------------------------------------------
+
+void UDPClient::closeConnection()
+{
+	m_running=false;
+	if(m_wakeFd>-1){
+		uint64_t one=1;
+		if(write(m_wakeFd, &one, sizeof(one))<0){
+			m_lastError=errno;
 		}
-		delete m_listeningThreadPtr;
-		m_listeningThreadPtr=nullptr;
 	}
+
+	if(m_fd>-1){
+		shutdown(m_fd, SHUT_RDWR);
+		close(m_fd);
+		m_fd=-1;
+	}
+}
+
+//--------------------------------------------------------------------
+
+void UDPClient::drain()
+{
+	char buffer[64];
+	while(true){
+		ssize_t r=::recv(m_fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+		if(r<0){
+			if(errno!=EAGAIN && errno!=EWOULDBLOCK && errno!=EINTR){
+				// e.g. ECONNREFUSED, nobody is listening on the other side
+				m_lastError=errno;
+			}
+			if(errno!=EINTR){
+				break;
+			}
+			continue;
+		}
+
+		// datagrams nobody asked for must not acknowledge packets
+		// that have not been sent yet
+		if(m_acked<m_sent){
+			m_acked++;
+		}
+	}
+}
+
+//--------------------------------------------------------------------
+
+bool UDPClient::receive(int timeout)
+{
+	if(!isActive()){
+		return false;
+	}
+
+	const auto deadline=std::chrono::steady_clock::now()+std::chrono::milliseconds(timeout);
+
+	pollfd fds[2];
+	fds[0].fd=m_fd;
+	fds[0].events=POLLIN;
+	fds[1].fd=m_wakeFd;
+	fds[1].events=POLLIN;
+
+	drain();
+	while(m_acked<m_sent){
+		auto remaining=std::chrono::duration_cast<std::chrono::microseconds>(deadline-std::chrono::steady_clock::now());
+		if(remaining.count()<=0){
+			return false;
+		}
+
+		timespec ts;
+		ts.tv_sec=remaining.count()/1000000;
+		ts.tv_nsec=(remaining.count()%1000000)*1000;
+
+		int r=ppoll(fds, 2, &ts, nullptr);
+		if(r<0 && errno!=EINTR){
+			m_lastError=errno;
+			return false;
+		}
+
+		if(r>0){
+			if(fds[1].revents!=0 || !m_running){
+				// closeConnection was called
+				return false;
+			}
+			drain();
+		}
+	}
+
+	return true;
 }
 
 //--------------------------------------------------------------------